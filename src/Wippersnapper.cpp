@@ -67,6 +67,34 @@ Wippersnapper::Wippersnapper() {
   WS._pwmComponent = new ws_pwm(WS._ledc);
 #else
   WS._pwmComponent = new ws_pwm();
+#endif
+  // Hardware configuration snapshot
+  WS._warmStart = new ws_warmstart();
+  // Pipelined QoS 1 publishes
+  WS._mqttWindow = new ws_mqtt_window();
+  // Publish governor
+  WS._mqttBudget = new ws_mqtt_budget();
+  // Memory usage tracking
+  WS._memStats = new ws_memstats();
+  // Actuator command latency tracing
+  WS._latency = new ws_latency();
+  // Boot stage timing
+  WS._bootTime = new ws_boottime();
+  // Main loop stage timing, for the profiler and tracer
+#if defined(WS_PROFILER) || defined(WS_TRACE)
+  WS._loopStages = new ws_loop_stages();
+#endif
+  // Main loop profiler
+#ifdef WS_PROFILER
+  WS._profiler = new ws_profiler();
+#endif
+  // Execution tracer
+#ifdef WS_TRACE
+  WS._trace = new ws_trace();
+#endif
+  // Tokenized debug log
+#if defined(WS_DEBUG) && defined(WS_DEBUG_TOKENIZED)
+  WS._log = new ws_log();
 #endif
 };
 
@@ -77,9 +105,7 @@ Wippersnapper::Wippersnapper() {
 /**************************************************************************/
 Wippersnapper::~Wippersnapper() {
   // free topics
-  free(_topic_description);
-  free(_topic_signal_device);
-  free(_topic_signal_brkr);
+  free(_topicArena);
   free(_err_sub);
   free(_throttle_sub);
 }
@@ -91,11 +117,13 @@ Wippersnapper::~Wippersnapper() {
 */
 /**************************************************************************/
 void Wippersnapper::provision() {
+  WS._bootTime->mark(WS_BOOT_STAGE_CORE);
   // Obtain device's MAC address
   getMacAddr();
 
   // Initialize the status LED for signaling FS errors
   initStatusLED();
+  WS._bootTime->mark(WS_BOOT_STAGE_LED);
 
 // Initialize the filesystem
 #ifdef USE_TINYUSB
@@ -103,6 +131,7 @@ void Wippersnapper::provision() {
 #elif defined(USE_LITTLEFS)
   _littleFS = new WipperSnapper_LittleFS();
 #endif
+  WS._bootTime->mark(WS_BOOT_STAGE_FS);
 
 #ifdef USE_DISPLAY
   // Initialize the display
@@ -123,6 +152,7 @@ void Wippersnapper::provision() {
   WS._ui_helper->set_bg_black();
   WS._ui_helper->show_scr_load();
   WS._ui_helper->set_label_status("Validating Credentials...");
+  WS._bootTime->mark(WS_BOOT_STAGE_DISPLAY);
 #endif
 
   // Parse secrets.json file
@@ -140,6 +170,7 @@ void Wippersnapper::provision() {
   WS._ui_helper->set_label_status("");
   WS._ui_helper->set_load_bar_icon_complete(loadBarIconFile);
 #endif
+  WS._bootTime->mark(WS_BOOT_STAGE_SECRETS);
 }
 
 /**************************************************************************/
@@ -201,6 +232,25 @@ ws_status_t Wippersnapper::networkStatus() {
   return WS_IDLE;
 }
 
+/****************************************************************************/
+/*!
+    @brief    Returns the number of bytes waiting on the MQTT client's
+              socket, without blocking.
+    @returns  Number of bytes available, or -1 if the network interface
+              can not poll its socket.
+*/
+/****************************************************************************/
+int Wippersnapper::mqttAvailable() { return -1; }
+
+/****************************************************************************/
+/*!
+    @brief    Returns the MQTT client's socket.
+    @returns  The socket, or nullptr if the network interface does not
+              expose it.
+*/
+/****************************************************************************/
+Client *Wippersnapper::mqttClient() { return nullptr; }
+
 /****************************************************************************/
 /*!
     @brief    Sets the device's wireless network credentials.
@@ -236,6 +286,31 @@ bool Wippersnapper::check_valid_ssid() {
   return false;
 }
 
+/***********************************************************/
+/*!
+@brief   Rejoins the access point of the last successful
+         connection, without scanning for WiFi networks.
+@returns True if connected, False otherwise.
+*/
+/***********************************************************/
+bool Wippersnapper::fastConnect() { return false; }
+
+/***********************************************************/
+/*!
+@brief   Stores the access point the device is connected to,
+         so fastConnect() can rejoin it.
+*/
+/***********************************************************/
+void Wippersnapper::cacheNetwork() {}
+
+/***********************************************************/
+/*!
+@brief   Sizes the TLS client's record buffers for the MQTT
+         broker, before the first connection to it.
+*/
+/***********************************************************/
+void Wippersnapper::setupTLSBuffers() {}
+
 /****************************************************************************/
 /*!
     @brief    Configures the device's Adafruit IO credentials. This method
@@ -395,10 +470,12 @@ bool cbDecodeDigitalPinWriteMsg(pb_istream_t *stream, const pb_field_t *field,
     WS_DEBUG_PRINTLN("ERROR: Could not decode PinEvents")
     is_success = false;
   }
+  WS._latency->markDecoded();
 
   // execute callback
   char *pinName = pinEventMsg.pin_name + 1;
   WS._digitalGPIO->digitalWriteSvc(atoi(pinName), atoi(pinEventMsg.pin_value));
+  WS._latency->markActuated(WS_LATENCY_CMD_DIGITAL);
 
   return is_success;
 }
@@ -479,6 +556,7 @@ bool cbSignalMsg(pb_istream_t *stream, const pb_field_t *field, void **arg) {
 /**************************************************************************/
 bool Wippersnapper::decodeSignalMsg(
     wippersnapper_signal_v1_CreateSignalRequest *encodedSignalMsg) {
+  WS_TRACE_SCOPE(WS_TRACE_EVENT_DECODE);
   bool is_success = true;
   WS_DEBUG_PRINTLN("decodeSignalMsg");
 
@@ -511,6 +589,9 @@ void cbSignalTopic(char *data, uint16_t len) {
   WS_DEBUG_PRINTLN("cbSignalTopic: New Msg on Signal Topic");
   WS_DEBUG_PRINT(len);
   WS_DEBUG_PRINTLN(" bytes.");
+  // pin configuration can be re-applied and completes the initial hardware
+  // configuration, so it is never skipped
+  WS._warmStart->sync(WS_WARMSTART_TOPIC_SIGNAL, data, len);
   // zero-out current buffer
   memset(WS._buffer, 0, sizeof(WS._buffer));
   // copy data to buffer
@@ -538,7 +619,7 @@ void publishI2CResponse(wippersnapper_signal_v1_I2CResponse *msgi2cResponse) {
   pb_get_encoded_size(&msgSz, wippersnapper_signal_v1_I2CResponse_fields,
                       msgi2cResponse);
   WS_DEBUG_PRINT("Publishing Message: I2CResponse...");
-  WS._mqtt->publish(WS._topic_signal_i2c_device, WS._buffer_outgoing, msgSz, 1);
+  WS.publish(WS._topic_signal_i2c_device, WS._buffer_outgoing, msgSz, 1);
   WS_DEBUG_PRINTLN("Published!");
 }
 
@@ -574,8 +655,18 @@ bool encodeI2CResponse(wippersnapper_signal_v1_I2CResponse *msgi2cResponse) {
 /******************************************************************************************/
 bool initializeI2CBus(wippersnapper_i2c_v1_I2CBusInitRequest msgInitRequest,
                       int i2cPort) {
-  // TODO: i2cPort is not handled right now, we should add support for multiple
-  // i2c ports!
+#if defined(ARDUINO_ARCH_ESP32)
+  // Only ESP32 exposes a second hardware I2C controller
+  if (i2cPort == 1) {
+    if (WS._isI2CPort1Init)
+      return true;
+    msgInitRequest.i2c_port_number = 1;
+    WS._i2cPort1 = new WipperSnapper_Component_I2C(&msgInitRequest);
+    WS.i2cComponents.push_back(WS._i2cPort1);
+    WS._isI2CPort1Init = WS._i2cPort1->isInitialized();
+    return WS._isI2CPort1Init;
+  }
+#endif
   if (WS._isI2CPort0Init)
     return true;
   // Initialize bus
@@ -585,6 +676,23 @@ bool initializeI2CBus(wippersnapper_i2c_v1_I2CBusInitRequest msgInitRequest,
   return WS._isI2CPort0Init;
 }
 
+/******************************************************************************************/
+/*!
+    @brief    Returns the I2C component for a port number.
+    @param    i2cPort
+              Desired I2C port.
+    @return   Pointer to the port's I2C component, port #0 if the
+              requested port is not available on this platform.
+*/
+/******************************************************************************************/
+WipperSnapper_Component_I2C *getI2CPort(int i2cPort) {
+#if defined(ARDUINO_ARCH_ESP32)
+  if (i2cPort == 1)
+    return WS._i2cPort1;
+#endif
+  return WS._i2cPort0;
+}
+
 /******************************************************************************************/
 /*!
     @brief    Decodes a list of I2C Device Initialization messages.
@@ -616,10 +724,11 @@ bool cbDecodeI2CDeviceInitRequestList(pb_istream_t *stream,
       wippersnapper_signal_v1_I2CResponse_resp_i2c_device_init_tag;
 
   // Check I2C bus
-  if (!initializeI2CBus(msgI2CDeviceInitRequest.i2c_bus_init_req, 0)) {
+  int i2cPort = msgI2CDeviceInitRequest.i2c_port_number;
+  if (!initializeI2CBus(msgI2CDeviceInitRequest.i2c_bus_init_req, i2cPort)) {
     WS_DEBUG_PRINTLN("ERROR: Failed to initialize I2C Bus");
     msgi2cResponse.payload.resp_i2c_device_init.bus_response =
-        WS._i2cPort0->getBusStatus();
+        getI2CPort(i2cPort)->getBusStatus();
     if (!encodeI2CResponse(&msgi2cResponse)) {
       WS_DEBUG_PRINTLN("ERROR: encoding I2C Response!");
       return false;
@@ -628,14 +737,14 @@ bool cbDecodeI2CDeviceInitRequestList(pb_istream_t *stream,
     return true;
   }
 
-  WS._i2cPort0->initI2CDevice(&msgI2CDeviceInitRequest);
+  getI2CPort(i2cPort)->initI2CDevice(&msgI2CDeviceInitRequest);
 
   // Fill device's address and the initialization status
   // TODO: The filling should be done within the method though?
   msgi2cResponse.payload.resp_i2c_device_init.i2c_device_address =
       msgI2CDeviceInitRequest.i2c_device_address;
   msgi2cResponse.payload.resp_i2c_device_init.bus_response =
-      WS._i2cPort0->getBusStatus();
+      getI2CPort(i2cPort)->getBusStatus();
 
   // Encode response
   if (!encodeI2CResponse(&msgi2cResponse)) {
@@ -687,10 +796,13 @@ bool cbDecodeSignalRequestI2C(pb_istream_t *stream, const pb_field_t *field,
         wippersnapper_i2c_v1_I2CBusScanResponse_init_zero;
 
     // Check I2C bus
-    if (!initializeI2CBus(msgScanReq.bus_init_request, 0)) {
+    int i2cPort = msgScanReq.i2c_port_number;
+    if (!initializeI2CBus(msgScanReq.bus_init_request, i2cPort)) {
       WS_DEBUG_PRINTLN("ERROR: Failed to initialize I2C Bus");
+      msgi2cResponse.which_payload =
+          wippersnapper_signal_v1_I2CResponse_resp_i2c_scan_tag;
       msgi2cResponse.payload.resp_i2c_scan.bus_response =
-          WS._i2cPort0->getBusStatus();
+          getI2CPort(i2cPort)->getBusStatus();
       if (!encodeI2CResponse(&msgi2cResponse)) {
         WS_DEBUG_PRINTLN("ERROR: encoding I2C Response!");
         return false;
@@ -699,8 +811,9 @@ bool cbDecodeSignalRequestI2C(pb_istream_t *stream, const pb_field_t *field,
       return true;
     }
 
-    // Scan I2C bus
-    scanResp = WS._i2cPort0->scanAddresses();
+    // Scan I2C bus, a cached result is returned if the bus
+    // has not changed since the last scan
+    scanResp = getI2CPort(i2cPort)->scanAddresses();
 
     // Fill I2CResponse
     msgi2cResponse.which_payload =
@@ -756,10 +869,12 @@ bool cbDecodeSignalRequestI2C(pb_istream_t *stream, const pb_field_t *field,
         wippersnapper_signal_v1_I2CResponse_resp_i2c_device_init_tag;
 
     // Check I2C bus
-    if (!initializeI2CBus(msgI2CDeviceInitRequest.i2c_bus_init_req, 0)) {
+    int i2cPort = msgI2CDeviceInitRequest.i2c_port_number;
+    if (!initializeI2CBus(msgI2CDeviceInitRequest.i2c_bus_init_req,
+                          i2cPort)) {
       WS_DEBUG_PRINTLN("ERROR: Failed to initialize I2C Bus");
       msgi2cResponse.payload.resp_i2c_device_init.bus_response =
-          WS._i2cPort0->getBusStatus();
+          getI2CPort(i2cPort)->getBusStatus();
       if (!encodeI2CResponse(&msgi2cResponse)) {
         WS_DEBUG_PRINTLN("ERROR: encoding I2C Response!");
         return false;
@@ -769,13 +884,13 @@ bool cbDecodeSignalRequestI2C(pb_istream_t *stream, const pb_field_t *field,
     }
 
     // Initialize I2C device
-    WS._i2cPort0->initI2CDevice(&msgI2CDeviceInitRequest);
+    getI2CPort(i2cPort)->initI2CDevice(&msgI2CDeviceInitRequest);
 
     // Fill device's address and bus status
     msgi2cResponse.payload.resp_i2c_device_init.i2c_device_address =
         msgI2CDeviceInitRequest.i2c_device_address;
     msgi2cResponse.payload.resp_i2c_device_init.bus_response =
-        WS._i2cPort0->getBusStatus();
+        getI2CPort(i2cPort)->getBusStatus();
 
     // Encode response
     if (!encodeI2CResponse(&msgi2cResponse)) {
@@ -802,14 +917,20 @@ bool cbDecodeSignalRequestI2C(pb_istream_t *stream, const pb_field_t *field,
     msgi2cResponse.which_payload =
         wippersnapper_signal_v1_I2CResponse_resp_i2c_device_update_tag;
 
-    // Update I2C device's properties
-    WS._i2cPort0->updateI2CDeviceProperties(&msgI2CDeviceUpdateRequest);
-
-    // Fill address
+    // Update I2C device's properties, on the port it was initialized on
+    WipperSnapper_Component_I2C *i2cPort =
+        getI2CPort(msgI2CDeviceUpdateRequest.i2c_port_number);
     msgi2cResponse.payload.resp_i2c_device_update.i2c_device_address =
         msgI2CDeviceUpdateRequest.i2c_device_address;
-    msgi2cResponse.payload.resp_i2c_device_update.bus_response =
-        WS._i2cPort0->getBusStatus();
+    if (i2cPort != NULL) {
+      i2cPort->updateI2CDeviceProperties(&msgI2CDeviceUpdateRequest);
+      msgi2cResponse.payload.resp_i2c_device_update.bus_response =
+          i2cPort->getBusStatus();
+    } else {
+      WS_DEBUG_PRINTLN("ERROR: I2C port has not been initialized!");
+      msgi2cResponse.payload.resp_i2c_device_update.bus_response =
+          wippersnapper_i2c_v1_BusResponse_BUS_RESPONSE_UNSPECIFIED;
+    }
 
     // Encode response
     if (!encodeI2CResponse(&msgi2cResponse)) {
@@ -834,13 +955,20 @@ bool cbDecodeSignalRequestI2C(pb_istream_t *stream, const pb_field_t *field,
     msgi2cResponse.which_payload =
         wippersnapper_signal_v1_I2CResponse_resp_i2c_device_deinit_tag;
 
-    // Deinitialize I2C device
-    WS._i2cPort0->deinitI2CDevice(&msgI2CDeviceDeinitRequest);
-    // Fill deinit response
+    // Deinitialize I2C device, on the port it was initialized on
+    WipperSnapper_Component_I2C *i2cPort =
+        getI2CPort(msgI2CDeviceDeinitRequest.i2c_port_number);
     msgi2cResponse.payload.resp_i2c_device_deinit.i2c_device_address =
         msgI2CDeviceDeinitRequest.i2c_device_address;
-    msgi2cResponse.payload.resp_i2c_device_deinit.bus_response =
-        WS._i2cPort0->getBusStatus();
+    if (i2cPort != NULL) {
+      i2cPort->deinitI2CDevice(&msgI2CDeviceDeinitRequest);
+      msgi2cResponse.payload.resp_i2c_device_deinit.bus_response =
+          i2cPort->getBusStatus();
+    } else {
+      WS_DEBUG_PRINTLN("ERROR: I2C port has not been initialized!");
+      msgi2cResponse.payload.resp_i2c_device_deinit.bus_response =
+          wippersnapper_i2c_v1_BusResponse_BUS_RESPONSE_DEVICE_DEINIT_FAIL;
+    }
 
     // Encode response
     if (!encodeI2CResponse(&msgi2cResponse)) {
@@ -869,6 +997,8 @@ void cbSignalI2CReq(char *data, uint16_t len) {
   WS_DEBUG_PRINTLN("* NEW MESSAGE [Topic: Signal-I2C]: ");
   WS_DEBUG_PRINT(len);
   WS_DEBUG_PRINTLN(" bytes.");
+  if (WS._warmStart->sync(WS_WARMSTART_TOPIC_I2C, data, len))
+    return; // already applied from the configuration snapshot
   // zero-out current buffer
   memset(WS._buffer, 0, sizeof(WS._buffer));
   // copy mqtt data into buffer
@@ -882,6 +1012,7 @@ void cbSignalI2CReq(char *data, uint16_t len) {
   // each oneof payload field once the field tag is known
   WS.msgSignalI2C.cb_payload.funcs.decode = cbDecodeSignalRequestI2C;
 
+  WS_TRACE_SCOPE(WS_TRACE_EVENT_DECODE);
   // Decode I2C signal request
   pb_istream_t istream = pb_istream_from_buffer(WS._buffer, WS.bufSize);
   if (!pb_decode(&istream, wippersnapper_signal_v1_I2CRequest_fields,
@@ -903,15 +1034,16 @@ void cbSignalI2CReq(char *data, uint16_t len) {
 /******************************************************************************************/
 bool cbDecodeServoMsg(pb_istream_t *stream, const pb_field_t *field,
                       void **arg) {
-  WS_DEBUG_PRINTLN("Decoding Servo Message...");
+  WS_LOG_DEBUG(SERVO, "Decoding Servo Message...");
   if (field->tag == wippersnapper_signal_v1_ServoRequest_servo_attach_tag) {
-    WS_DEBUG_PRINTLN("GOT: Servo Attach");
+    WS_LOG_DEBUG(SERVO, "GOT: Servo Attach");
     // Attempt to decode contents of servo_attach message
     wippersnapper_servo_v1_ServoAttachRequest msgServoAttachReq =
         wippersnapper_servo_v1_ServoAttachRequest_init_zero;
     if (!pb_decode(stream, wippersnapper_servo_v1_ServoAttachRequest_fields,
                    &msgServoAttachReq)) {
-      WS_DEBUG_PRINTLN(
+      WS_LOG_ERROR(
+          SERVO,
           "ERROR: Could not decode wippersnapper_servo_v1_ServoAttachRequest");
 #ifdef USE_DISPLAY
       WS._ui_helper->add_text_to_terminal(
@@ -925,7 +1057,7 @@ bool cbDecodeServoMsg(pb_istream_t *stream, const pb_field_t *field,
     if (!WS._servoComponent->servo_attach(
             atoi(servoPin), msgServoAttachReq.min_pulse_width,
             msgServoAttachReq.max_pulse_width, msgServoAttachReq.servo_freq)) {
-      WS_DEBUG_PRINTLN("ERROR: Unable to attach servo to pin!");
+      WS_LOG_ERROR(SERVO, "ERROR: Unable to attach servo to pin!");
 #ifdef USE_DISPLAY
       WS._ui_helper->add_text_to_terminal(
           "[Servo ERROR] Unable to attach servo to pin! Is it already in "
@@ -933,12 +1065,11 @@ bool cbDecodeServoMsg(pb_istream_t *stream, const pb_field_t *field,
 #endif
       attached = false;
     } else {
-      WS_DEBUG_PRINT("ATTACHED servo w/minPulseWidth: ");
-      WS_DEBUG_PRINT(msgServoAttachReq.min_pulse_width);
-      WS_DEBUG_PRINT(" uS and maxPulseWidth: ");
-      WS_DEBUG_PRINT(msgServoAttachReq.min_pulse_width);
-      WS_DEBUG_PRINT("uS on pin: ");
-      WS_DEBUG_PRINTLN(servoPin);
+      WS_LOG_INFO(SERVO,
+                  "ATTACHED servo w/minPulseWidth: %d uS and maxPulseWidth: "
+                  "%duS on pin: %s",
+                  msgServoAttachReq.min_pulse_width,
+                  msgServoAttachReq.max_pulse_width, servoPin);
 #ifdef USE_DISPLAY
       char buffer[100];
       snprintf(buffer, 100, "[Servo] Attached servo on pin %s\n.",
@@ -963,18 +1094,16 @@ bool cbDecodeServoMsg(pb_istream_t *stream, const pb_field_t *field,
                                                   sizeof(WS._buffer_outgoing));
     if (!pb_encode(&ostream, wippersnapper_signal_v1_ServoResponse_fields,
                    &msgServoResp)) {
-      WS_DEBUG_PRINTLN("ERROR: Unable to encode servo response message!");
+      WS_LOG_ERROR(SERVO, "ERROR: Unable to encode servo response message!");
       return false;
     }
     pb_get_encoded_size(&msgSz, wippersnapper_signal_v1_ServoResponse_fields,
                         &msgServoResp);
-    WS_DEBUG_PRINT("-> Servo Attach Response...");
-    WS._mqtt->publish(WS._topic_signal_servo_device, WS._buffer_outgoing, msgSz,
-                      1);
-    WS_DEBUG_PRINTLN("Published!");
+    WS.publish(WS._topic_signal_servo_device, WS._buffer_outgoing, msgSz, 1);
+    WS_LOG_DEBUG(SERVO, "Published Servo Attach Response");
   } else if (field->tag ==
              wippersnapper_signal_v1_ServoRequest_servo_write_tag) {
-    WS_DEBUG_PRINTLN("GOT: Servo Write");
+    WS_LOG_DEBUG(SERVO, "GOT: Servo Write");
 
     // Attempt to decode contents of servo write message
     wippersnapper_servo_v1_ServoWriteRequest msgServoWriteReq =
@@ -982,17 +1111,17 @@ bool cbDecodeServoMsg(pb_istream_t *stream, const pb_field_t *field,
 
     if (!pb_decode(stream, wippersnapper_servo_v1_ServoWriteRequest_fields,
                    &msgServoWriteReq)) {
-      WS_DEBUG_PRINTLN(
+      WS_LOG_ERROR(
+          SERVO,
           "ERROR: Could not decode wippersnapper_servo_v1_ServoWriteRequest");
       return false; // fail out if we can't decode the request
     }
+    WS._latency->markDecoded();
     // execute servo write request
     char *servoPin = msgServoWriteReq.servo_pin + 1;
 
-    WS_DEBUG_PRINT("Writing pulse width of ");
-    WS_DEBUG_PRINT((int)msgServoWriteReq.pulse_width);
-    WS_DEBUG_PRINT("uS to servo on pin#: ");
-    WS_DEBUG_PRINTLN(servoPin);
+    WS_LOG_DEBUG(SERVO, "Writing pulse width of %duS to servo on pin#: %s",
+                 (int)msgServoWriteReq.pulse_width, servoPin);
 
 #ifdef USE_DISPLAY
     char buffer[100];
@@ -1003,24 +1132,25 @@ bool cbDecodeServoMsg(pb_istream_t *stream, const pb_field_t *field,
 
     WS._servoComponent->servo_write(atoi(servoPin),
                                     (int)msgServoWriteReq.pulse_width);
+    WS._latency->markActuated(WS_LATENCY_CMD_SERVO);
   } else if (field->tag ==
              wippersnapper_signal_v1_ServoRequest_servo_detach_tag) {
-    WS_DEBUG_PRINTLN("GOT: Servo Detach");
+    WS_LOG_DEBUG(SERVO, "GOT: Servo Detach");
 
     // Attempt to decode contents of servo detach message
     wippersnapper_servo_v1_ServoDetachRequest msgServoDetachReq =
         wippersnapper_servo_v1_ServoDetachRequest_init_zero;
     if (!pb_decode(stream, wippersnapper_servo_v1_ServoDetachRequest_fields,
                    &msgServoDetachReq)) {
-      WS_DEBUG_PRINTLN(
+      WS_LOG_ERROR(
+          SERVO,
           "ERROR: Could not decode wippersnapper_servo_v1_ServoDetachRequest");
       return false; // fail out if we can't decode the request
     }
 
     // execute servo detach request
     char *servoPin = msgServoDetachReq.servo_pin + 1;
-    WS_DEBUG_PRINT("Detaching servo from pin ");
-    WS_DEBUG_PRINTLN(servoPin);
+    WS_LOG_INFO(SERVO, "Detaching servo from pin %s", servoPin);
 
 #ifdef USE_DISPLAY
     char buffer[100];
@@ -1031,7 +1161,7 @@ bool cbDecodeServoMsg(pb_istream_t *stream, const pb_field_t *field,
 
     WS._servoComponent->servo_detach(atoi(servoPin));
   } else {
-    WS_DEBUG_PRINTLN("Unable to decode servo message type!");
+    WS_LOG_ERROR(SERVO, "Unable to decode servo message type!");
     return false;
   }
   return true;
@@ -1048,9 +1178,9 @@ bool cbDecodeServoMsg(pb_istream_t *stream, const pb_field_t *field,
 */
 /**************************************************************************/
 void cbServoMsg(char *data, uint16_t len) {
-  WS_DEBUG_PRINTLN("* NEW MESSAGE [Topic: Servo]: ");
-  WS_DEBUG_PRINT(len);
-  WS_DEBUG_PRINTLN(" bytes.");
+  WS_LOG_DEBUG(SERVO, "* NEW MESSAGE [Topic: Servo]: %u bytes.", len);
+  if (WS._warmStart->sync(WS_WARMSTART_TOPIC_SERVO, data, len))
+    return; // already applied from the configuration snapshot
   // zero-out current buffer
   memset(WS._buffer, 0, sizeof(WS._buffer));
   // copy mqtt data into buffer
@@ -1061,11 +1191,12 @@ void cbServoMsg(char *data, uint16_t len) {
   // each oneof payload field once the field tag is known
   WS.msgServo.cb_payload.funcs.decode = cbDecodeServoMsg;
 
+  WS_TRACE_SCOPE(WS_TRACE_EVENT_DECODE);
   // Decode servo message from buffer
   pb_istream_t istream = pb_istream_from_buffer(WS._buffer, WS.bufSize);
   if (!pb_decode(&istream, wippersnapper_signal_v1_ServoRequest_fields,
                  &WS.msgServo))
-    WS_DEBUG_PRINTLN("ERROR: Unable to decode servo message");
+    WS_LOG_ERROR(SERVO, "ERROR: Unable to decode servo message");
 }
 
 /******************************************************************************************/
@@ -1081,16 +1212,16 @@ void cbServoMsg(char *data, uint16_t len) {
 */
 /******************************************************************************************/
 bool cbPWMDecodeMsg(pb_istream_t *stream, const pb_field_t *field, void **arg) {
-  WS_DEBUG_PRINTLN("Decoding PWM Message...");
+  WS_LOG_DEBUG(PWM, "Decoding PWM Message...");
   if (field->tag == wippersnapper_signal_v1_PWMRequest_attach_request_tag) {
-    WS_DEBUG_PRINTLN("GOT: PWM Pin Attach");
+    WS_LOG_DEBUG(PWM, "GOT: PWM Pin Attach");
     // Attempt to decode contents of PWM attach message
     wippersnapper_pwm_v1_PWMAttachRequest msgPWMAttachRequest =
         wippersnapper_pwm_v1_PWMAttachRequest_init_zero;
     if (!pb_decode(stream, wippersnapper_pwm_v1_PWMAttachRequest_fields,
                    &msgPWMAttachRequest)) {
-      WS_DEBUG_PRINTLN(
-          "ERROR: Could not decode wippersnapper_pwm_v1_PWMAttachRequest");
+      WS_LOG_ERROR(
+          PWM, "ERROR: Could not decode wippersnapper_pwm_v1_PWMAttachRequest");
 #ifdef USE_DISPLAY
       WS._ui_helper->add_text_to_terminal(
           "[PWM ERROR]: Could not decode pin attach request!\n");
@@ -1104,7 +1235,7 @@ bool cbPWMDecodeMsg(pb_istream_t *stream, const pb_field_t *field, void **arg) {
         atoi(pwmPin), (double)msgPWMAttachRequest.frequency,
         (uint8_t)msgPWMAttachRequest.resolution);
     if (!attached) {
-      WS_DEBUG_PRINTLN("ERROR: Unable to attach PWM pin");
+      WS_LOG_ERROR(PWM, "ERROR: Unable to attach PWM pin");
 #ifdef USE_DISPLAY
       WS._ui_helper->add_text_to_terminal(
           "[PWM ERROR]: Failed to attach PWM to pin! Is this pin already in "
@@ -1127,16 +1258,14 @@ bool cbPWMDecodeMsg(pb_istream_t *stream, const pb_field_t *field, void **arg) {
                                                   sizeof(WS._buffer_outgoing));
     if (!pb_encode(&ostream, wippersnapper_signal_v1_PWMResponse_fields,
                    &msgPWMResponse)) {
-      WS_DEBUG_PRINTLN("ERROR: Unable to encode PWM response message!");
+      WS_LOG_ERROR(PWM, "ERROR: Unable to encode PWM response message!");
       return false;
     }
     size_t msgSz; // message's encoded size
     pb_get_encoded_size(&msgSz, wippersnapper_signal_v1_PWMResponse_fields,
                         &msgPWMResponse);
-    WS_DEBUG_PRINT("PUBLISHING: PWM Attach Response...");
-    WS._mqtt->publish(WS._topic_signal_pwm_device, WS._buffer_outgoing, msgSz,
-                      1);
-    WS_DEBUG_PRINTLN("Published!");
+    WS.publish(WS._topic_signal_pwm_device, WS._buffer_outgoing, msgSz, 1);
+    WS_LOG_DEBUG(PWM, "Published PWM Attach Response");
 
 #ifdef USE_DISPLAY
     char buffer[100];
@@ -1147,14 +1276,14 @@ bool cbPWMDecodeMsg(pb_istream_t *stream, const pb_field_t *field, void **arg) {
 
   } else if (field->tag ==
              wippersnapper_signal_v1_PWMRequest_detach_request_tag) {
-    WS_DEBUG_PRINTLN("GOT: PWM Pin Detach");
+    WS_LOG_DEBUG(PWM, "GOT: PWM Pin Detach");
     // Attempt to decode contents of PWM detach message
     wippersnapper_pwm_v1_PWMDetachRequest msgPWMDetachRequest =
         wippersnapper_pwm_v1_PWMDetachRequest_init_zero;
     if (!pb_decode(stream, wippersnapper_pwm_v1_PWMDetachRequest_fields,
                    &msgPWMDetachRequest)) {
-      WS_DEBUG_PRINTLN(
-          "ERROR: Could not decode wippersnapper_pwm_v1_PWMDetachRequest");
+      WS_LOG_ERROR(
+          PWM, "ERROR: Could not decode wippersnapper_pwm_v1_PWMDetachRequest");
 #ifdef USE_DISPLAY
       WS._ui_helper->add_text_to_terminal(
           "[PWM ERROR] Failed to decode pin detach request from IO!\n");
@@ -1174,14 +1303,14 @@ bool cbPWMDecodeMsg(pb_istream_t *stream, const pb_field_t *field, void **arg) {
 
   } else if (field->tag ==
              wippersnapper_signal_v1_PWMRequest_write_freq_request_tag) {
-    WS_DEBUG_PRINTLN("GOT: PWM Write Tone");
+    WS_LOG_DEBUG(PWM, "GOT: PWM Write Tone");
     // Attempt to decode contents of PWM detach message
     wippersnapper_pwm_v1_PWMWriteFrequencyRequest msgPWMWriteFreqRequest =
         wippersnapper_pwm_v1_PWMWriteFrequencyRequest_init_zero;
     if (!pb_decode(stream, wippersnapper_pwm_v1_PWMWriteFrequencyRequest_fields,
                    &msgPWMWriteFreqRequest)) {
-      WS_DEBUG_PRINTLN("ERROR: Could not decode "
-                       "wippersnapper_pwm_v1_PWMWriteFrequencyRequest");
+      WS_LOG_ERROR(PWM, "ERROR: Could not decode "
+                        "wippersnapper_pwm_v1_PWMWriteFrequencyRequest");
 #ifdef USE_DISPLAY
       WS._ui_helper->add_text_to_terminal(
           "[PWM ERROR] Failed to decode frequency write request from IO!\n");
@@ -1191,10 +1320,8 @@ bool cbPWMDecodeMsg(pb_istream_t *stream, const pb_field_t *field, void **arg) {
 
     // execute PWM pin duty cycle write request
     char *pwmPin = msgPWMWriteFreqRequest.pin + 1;
-    WS_DEBUG_PRINT("Writing frequency:  ");
-    WS_DEBUG_PRINT(msgPWMWriteFreqRequest.frequency);
-    WS_DEBUG_PRINT("Hz to pin ");
-    WS_DEBUG_PRINTLN(atoi(pwmPin));
+    WS_LOG_DEBUG(PWM, "Writing frequency:  %dHz to pin %d",
+                 msgPWMWriteFreqRequest.frequency, atoi(pwmPin));
     WS._pwmComponent->writeTone(atoi(pwmPin), msgPWMWriteFreqRequest.frequency);
 
 #ifdef USE_DISPLAY
@@ -1206,25 +1333,27 @@ bool cbPWMDecodeMsg(pb_istream_t *stream, const pb_field_t *field, void **arg) {
 
   } else if (field->tag ==
              wippersnapper_signal_v1_PWMRequest_write_duty_request_tag) {
-    WS_DEBUG_PRINTLN("GOT: PWM Write Duty Cycle");
+    WS_LOG_DEBUG(PWM, "GOT: PWM Write Duty Cycle");
 
     // Attempt to decode contents of PWM detach message
     wippersnapper_pwm_v1_PWMWriteDutyCycleRequest msgPWMWriteDutyCycleRequest =
         wippersnapper_pwm_v1_PWMWriteDutyCycleRequest_init_zero;
     if (!pb_decode(stream, wippersnapper_pwm_v1_PWMWriteDutyCycleRequest_fields,
                    &msgPWMWriteDutyCycleRequest)) {
-      WS_DEBUG_PRINTLN("ERROR: Could not decode "
-                       "wippersnapper_pwm_v1_PWMWriteDutyCycleRequest");
+      WS_LOG_ERROR(PWM, "ERROR: Could not decode "
+                        "wippersnapper_pwm_v1_PWMWriteDutyCycleRequest");
 #ifdef USE_DISPLAY
       WS._ui_helper->add_text_to_terminal(
           "[PWM ERROR] Failed to decode duty cycle write request from IO!\n");
 #endif
       return false; // fail out if we can't decode the request
     }
+    WS._latency->markDecoded();
     // execute PWM duty cycle write request
     char *pwmPin = msgPWMWriteDutyCycleRequest.pin + 1;
     WS._pwmComponent->writeDutyCycle(
         atoi(pwmPin), (int)msgPWMWriteDutyCycleRequest.duty_cycle);
+    WS._latency->markActuated(WS_LATENCY_CMD_PWM);
 
 #ifdef USE_DISPLAY
     char buffer[100];
@@ -1234,7 +1363,7 @@ bool cbPWMDecodeMsg(pb_istream_t *stream, const pb_field_t *field, void **arg) {
 #endif
 
   } else {
-    WS_DEBUG_PRINTLN("Unable to decode PWM message type!");
+    WS_LOG_ERROR(PWM, "Unable to decode PWM message type!");
     return false;
   }
   return true;
@@ -1251,9 +1380,9 @@ bool cbPWMDecodeMsg(pb_istream_t *stream, const pb_field_t *field, void **arg) {
 */
 /**************************************************************************/
 void cbPWMMsg(char *data, uint16_t len) {
-  WS_DEBUG_PRINTLN("* NEW MESSAGE [Topic: PWM]: ");
-  WS_DEBUG_PRINT(len);
-  WS_DEBUG_PRINTLN(" bytes.");
+  WS_LOG_DEBUG(PWM, "* NEW MESSAGE [Topic: PWM]: %u bytes.", len);
+  if (WS._warmStart->sync(WS_WARMSTART_TOPIC_PWM, data, len))
+    return; // already applied from the configuration snapshot
   // zero-out current buffer
   memset(WS._buffer, 0, sizeof(WS._buffer));
   // copy mqtt data into buffer
@@ -1264,11 +1393,12 @@ void cbPWMMsg(char *data, uint16_t len) {
   // each oneof payload field once the field tag is known
   WS.msgPWM.cb_payload.funcs.decode = cbPWMDecodeMsg;
 
+  WS_TRACE_SCOPE(WS_TRACE_EVENT_DECODE);
   // Decode servo message from buffer
   pb_istream_t istream = pb_istream_from_buffer(WS._buffer, WS.bufSize);
   if (!pb_decode(&istream, wippersnapper_signal_v1_PWMRequest_fields,
                  &WS.msgPWM))
-    WS_DEBUG_PRINTLN("ERROR: Unable to decode PWM message");
+    WS_LOG_ERROR(PWM, "ERROR: Unable to decode PWM message");
 }
 
 /******************************************************************************************/
@@ -1288,37 +1418,36 @@ bool cbDecodeDs18x20Msg(pb_istream_t *stream, const pb_field_t *field,
                         void **arg) {
   if (field->tag ==
       wippersnapper_signal_v1_Ds18x20Request_req_ds18x20_init_tag) {
-    WS_DEBUG_PRINTLN("[Message Type] Init. DS Sensor");
+    WS_LOG_DEBUG(DS18X20, "[Message Type] Init. DS Sensor");
     // Attempt to decode contents of DS18x20 message
     wippersnapper_ds18x20_v1_Ds18x20InitRequest msgDS18xInitReq =
         wippersnapper_ds18x20_v1_Ds18x20InitRequest_init_zero;
 
     if (!pb_decode(stream, wippersnapper_ds18x20_v1_Ds18x20InitRequest_fields,
                    &msgDS18xInitReq)) {
-      WS_DEBUG_PRINTLN("ERROR: Could not decode "
-                       "wippersnapper_ds18x20_v1_Ds18x20InitRequest");
+      WS_LOG_ERROR(DS18X20, "ERROR: Could not decode "
+                            "wippersnapper_ds18x20_v1_Ds18x20InitRequest");
       return false; // fail out if we can't decode the request
     }
-    WS_DEBUG_PRINT("Adding DS18x20 Component...");
     if (!WS._ds18x20Component->addDS18x20(&msgDS18xInitReq))
       return false;
-    WS_DEBUG_PRINTLN("Added!");
+    WS_LOG_INFO(DS18X20, "Added DS18x20 Component");
   } else if (field->tag ==
              wippersnapper_signal_v1_Ds18x20Request_req_ds18x20_deinit_tag) {
-    WS_DEBUG_PRINTLN("[Message Type] De-init. DS Sensor");
+    WS_LOG_DEBUG(DS18X20, "[Message Type] De-init. DS Sensor");
     // Attempt to decode contents of message
     wippersnapper_ds18x20_v1_Ds18x20DeInitRequest msgDS18xDeInitReq =
         wippersnapper_ds18x20_v1_Ds18x20DeInitRequest_init_zero;
     if (!pb_decode(stream, wippersnapper_ds18x20_v1_Ds18x20DeInitRequest_fields,
                    &msgDS18xDeInitReq)) {
-      WS_DEBUG_PRINTLN("ERROR: Could not decode "
-                       "wippersnapper_ds18x20_v1_Ds18x20DeInitRequest");
+      WS_LOG_ERROR(DS18X20, "ERROR: Could not decode "
+                            "wippersnapper_ds18x20_v1_Ds18x20DeInitRequest");
       return false; // fail out if we can't decode the request
     }
     // exec. deinit request
     WS._ds18x20Component->deleteDS18x20(&msgDS18xDeInitReq);
   } else {
-    WS_DEBUG_PRINTLN("ERROR: DS Message type not found!");
+    WS_LOG_ERROR(DS18X20, "ERROR: DS Message type not found!");
     return false;
   }
   return true;
@@ -1335,9 +1464,9 @@ bool cbDecodeDs18x20Msg(pb_istream_t *stream, const pb_field_t *field,
 */
 /**************************************************************************/
 void cbSignalDSReq(char *data, uint16_t len) {
-  WS_DEBUG_PRINTLN("* NEW MESSAGE [Topic: Signal-DS]: ");
-  WS_DEBUG_PRINT(len);
-  WS_DEBUG_PRINTLN(" bytes.");
+  WS_LOG_DEBUG(DS18X20, "* NEW MESSAGE [Topic: Signal-DS]: %u bytes.", len);
+  if (WS._warmStart->sync(WS_WARMSTART_TOPIC_DS18X20, data, len))
+    return; // already applied from the configuration snapshot
   // zero-out current buffer
   memset(WS._buffer, 0, sizeof(WS._buffer));
   // copy mqtt data into buffer
@@ -1351,11 +1480,12 @@ void cbSignalDSReq(char *data, uint16_t len) {
   // each oneof payload field once the field tag is known
   WS.msgSignalDS.cb_payload.funcs.decode = cbDecodeDs18x20Msg;
 
+  WS_TRACE_SCOPE(WS_TRACE_EVENT_DECODE);
   // Decode DS signal request
   pb_istream_t istream = pb_istream_from_buffer(WS._buffer, WS.bufSize);
   if (!pb_decode(&istream, wippersnapper_signal_v1_Ds18x20Request_fields,
                  &WS.msgSignalDS))
-    WS_DEBUG_PRINTLN("ERROR: Unable to decode DS message");
+    WS_LOG_ERROR(DS18X20, "ERROR: Unable to decode DS message");
 }
 
 /******************************************************************************************/
@@ -1375,7 +1505,8 @@ bool cbDecodePixelsMsg(pb_istream_t *stream, const pb_field_t *field,
                        void **arg) {
   if (field->tag ==
       wippersnapper_signal_v1_PixelsRequest_req_pixels_create_tag) {
-    WS_DEBUG_PRINTLN(
+    WS_LOG_DEBUG(
+        PIXELS,
         "[Message Type]: "
         "wippersnapper_signal_v1_PixelsRequest_req_pixels_create_tag");
 
@@ -1384,8 +1515,8 @@ bool cbDecodePixelsMsg(pb_istream_t *stream, const pb_field_t *field,
         wippersnapper_pixels_v1_PixelsCreateRequest_init_zero;
     if (!pb_decode(stream, wippersnapper_pixels_v1_PixelsCreateRequest_fields,
                    &msgPixelsCreateReq)) {
-      WS_DEBUG_PRINTLN("ERROR: Could not decode message of type "
-                       "wippersnapper_pixels_v1_PixelsCreateRequest!");
+      WS_LOG_ERROR(PIXELS, "ERROR: Could not decode message of type "
+                           "wippersnapper_pixels_v1_PixelsCreateRequest!");
 #ifdef USE_DISPLAY
       WS._ui_helper->add_text_to_terminal("[Pixel] Error decoding message!\n");
 #endif
@@ -1396,7 +1527,8 @@ bool cbDecodePixelsMsg(pb_istream_t *stream, const pb_field_t *field,
     return WS._ws_pixelsComponent->addStrand(&msgPixelsCreateReq);
   } else if (field->tag ==
              wippersnapper_signal_v1_PixelsRequest_req_pixels_delete_tag) {
-    WS_DEBUG_PRINTLN(
+    WS_LOG_DEBUG(
+        PIXELS,
         "[Message Type]: "
         "wippersnapper_signal_v1_PixelsRequest_req_pixels_delete_tag");
 
@@ -1405,8 +1537,8 @@ bool cbDecodePixelsMsg(pb_istream_t *stream, const pb_field_t *field,
         wippersnapper_pixels_v1_PixelsDeleteRequest_init_zero;
     if (!pb_decode(stream, wippersnapper_pixels_v1_PixelsDeleteRequest_fields,
                    &msgPixelsDeleteReq)) {
-      WS_DEBUG_PRINTLN("ERROR: Could not decode message of type "
-                       "wippersnapper_pixels_v1_PixelsDeleteRequest!");
+      WS_LOG_ERROR(PIXELS, "ERROR: Could not decode message of type "
+                           "wippersnapper_pixels_v1_PixelsDeleteRequest!");
       return false;
     }
 
@@ -1414,7 +1546,8 @@ bool cbDecodePixelsMsg(pb_istream_t *stream, const pb_field_t *field,
     WS._ws_pixelsComponent->deleteStrand(&msgPixelsDeleteReq);
   } else if (field->tag ==
              wippersnapper_signal_v1_PixelsRequest_req_pixels_write_tag) {
-    WS_DEBUG_PRINTLN(
+    WS_LOG_DEBUG(
+        PIXELS,
         "[Message Type]: "
         "wippersnapper_signal_v1_PixelsRequest_req_pixels_write_tag");
 
@@ -1423,15 +1556,17 @@ bool cbDecodePixelsMsg(pb_istream_t *stream, const pb_field_t *field,
         wippersnapper_pixels_v1_PixelsWriteRequest_init_zero;
     if (!pb_decode(stream, wippersnapper_pixels_v1_PixelsWriteRequest_fields,
                    &msgPixelsWritereq)) {
-      WS_DEBUG_PRINTLN("ERROR: Could not decode message of type "
-                       "wippersnapper_pixels_v1_PixelsWriteRequest!");
+      WS_LOG_ERROR(PIXELS, "ERROR: Could not decode message of type "
+                           "wippersnapper_pixels_v1_PixelsWriteRequest!");
       return false;
     }
+    WS._latency->markDecoded();
 
     // fill strand
     WS._ws_pixelsComponent->fillStrand(&msgPixelsWritereq);
+    WS._latency->markActuated(WS_LATENCY_CMD_PIXELS);
   } else {
-    WS_DEBUG_PRINTLN("ERROR: Pixels message type not found!");
+    WS_LOG_ERROR(PIXELS, "ERROR: Pixels message type not found!");
     return false;
   }
   return true;
@@ -1448,9 +1583,9 @@ bool cbDecodePixelsMsg(pb_istream_t *stream, const pb_field_t *field,
 */
 /**************************************************************************/
 void cbPixelsMsg(char *data, uint16_t len) {
-  WS_DEBUG_PRINTLN("* NEW MESSAGE [Topic: Pixels]: ");
-  WS_DEBUG_PRINT(len);
-  WS_DEBUG_PRINTLN(" bytes.");
+  WS_LOG_DEBUG(PIXELS, "* NEW MESSAGE [Topic: Pixels]: %u bytes.", len);
+  if (WS._warmStart->sync(WS_WARMSTART_TOPIC_PIXELS, data, len))
+    return; // already applied from the configuration snapshot
   // zero-out current buffer
   memset(WS._buffer, 0, sizeof(WS._buffer));
   // copy mqtt data into buffer
@@ -1461,11 +1596,12 @@ void cbPixelsMsg(char *data, uint16_t len) {
   // each oneof payload field once the field tag is known
   WS.msgPixels.cb_payload.funcs.decode = cbDecodePixelsMsg;
 
+  WS_TRACE_SCOPE(WS_TRACE_EVENT_DECODE);
   // Decode pixel message from buffer
   pb_istream_t istream = pb_istream_from_buffer(WS._buffer, WS.bufSize);
   if (!pb_decode(&istream, wippersnapper_signal_v1_PixelsRequest_fields,
                  &WS.msgPixels))
-    WS_DEBUG_PRINTLN("ERROR: Unable to decode pixel topic message");
+    WS_LOG_ERROR(PIXELS, "ERROR: Unable to decode pixel topic message");
 }
 
 /****************************************************************************/
@@ -1483,6 +1619,7 @@ void cbPixelsMsg(char *data, uint16_t len) {
 bool Wippersnapper::encodePinEvent(
     wippersnapper_signal_v1_CreateSignalRequest *outgoingSignalMsg,
     uint8_t pinName, int pinVal) {
+  WS_TRACE_SCOPE(WS_TRACE_EVENT_ENCODE);
   bool is_success = true;
   outgoingSignalMsg->which_payload =
       wippersnapper_signal_v1_CreateSignalRequest_pin_event_tag;
@@ -1495,13 +1632,277 @@ bool Wippersnapper::encodePinEvent(
       pb_ostream_from_buffer(WS._buffer_outgoing, sizeof(WS._buffer_outgoing));
   if (!pb_encode(&stream, wippersnapper_signal_v1_CreateSignalRequest_fields,
                  outgoingSignalMsg)) {
-    WS_DEBUG_PRINTLN("ERROR: Unable to encode signal message");
+    WS_LOG_ERROR(DIGITAL, "ERROR: Unable to encode signal message");
     is_success = false;
   }
 
   return is_success;
 }
 
+/**************************************************************************/
+/*!
+    @brief    Applies a message from the hardware configuration snapshot.
+    @param    topic
+              Topic the message was received on.
+    @param    data
+              The message's payload.
+    @param    len
+              Length of the message's payload.
+*/
+/**************************************************************************/
+void cbWarmStartMsg(ws_warmstart_topic_t topic, char *data, uint16_t len) {
+  switch (topic) {
+  case WS_WARMSTART_TOPIC_SIGNAL:
+    cbSignalTopic(data, len);
+    break;
+  case WS_WARMSTART_TOPIC_I2C:
+    cbSignalI2CReq(data, len);
+    break;
+  case WS_WARMSTART_TOPIC_DS18X20:
+    cbSignalDSReq(data, len);
+    break;
+  case WS_WARMSTART_TOPIC_SERVO:
+    cbServoMsg(data, len);
+    break;
+  case WS_WARMSTART_TOPIC_PWM:
+    cbPWMMsg(data, len);
+    break;
+  case WS_WARMSTART_TOPIC_PIXELS:
+    cbPixelsMsg(data, len);
+    break;
+  default:
+    WS_DEBUG_PRINTLN("ERROR: Unknown topic in configuration snapshot!");
+    break;
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief    Deletes a pin created by a ConfigurePinRequest from the
+              hardware configuration snapshot.
+    @param    stream
+              Input stream to read from.
+    @param    field
+              Message descriptor, usually autogenerated.
+    @param    arg
+              Stores any information the decoding callback may need.
+    @returns  True if the request was decoded, False otherwise.
+*/
+/**************************************************************************/
+bool cbUndoPinConfigMsg(pb_istream_t *stream, const pb_field_t *field,
+                        void **arg) {
+  wippersnapper_pin_v1_ConfigurePinRequest pinReqMsg =
+      wippersnapper_pin_v1_ConfigurePinRequest_init_zero;
+  if (!pb_decode(stream, wippersnapper_pin_v1_ConfigurePinRequest_fields,
+                 &pinReqMsg))
+    return false;
+  if (pinReqMsg.request_type !=
+      wippersnapper_pin_v1_ConfigurePinRequest_RequestType_REQUEST_TYPE_CREATE)
+    return true;
+
+  pinReqMsg.request_type =
+      wippersnapper_pin_v1_ConfigurePinRequest_RequestType_REQUEST_TYPE_DELETE;
+  if (pinReqMsg.mode == wippersnapper_pin_v1_Mode_MODE_DIGITAL)
+    return WS.configureDigitalPinReq(&pinReqMsg);
+  if (pinReqMsg.mode == wippersnapper_pin_v1_Mode_MODE_ANALOG)
+    return WS.configAnalogInPinReq(&pinReqMsg);
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Sets up the pin configuration callbacks of a signal message
+              from the hardware configuration snapshot.
+    @param    stream
+              Input stream to read from.
+    @param    field
+              Message descriptor, usually autogenerated.
+    @param    arg
+              Stores any information the decoding callback may need.
+    @returns  True if the message was decoded, False otherwise.
+*/
+/**************************************************************************/
+bool cbUndoSignalMsg(pb_istream_t *stream, const pb_field_t *field,
+                     void **arg) {
+  if (field->tag !=
+      wippersnapper_signal_v1_CreateSignalRequest_pin_configs_tag)
+    return true;
+  wippersnapper_pin_v1_ConfigurePinRequests msg =
+      wippersnapper_pin_v1_ConfigurePinRequests_init_zero;
+  msg.list.funcs.decode = cbUndoPinConfigMsg;
+  return pb_decode(stream, wippersnapper_pin_v1_ConfigurePinRequests_fields,
+                   &msg);
+}
+
+/**************************************************************************/
+/*!
+    @brief    Deinitializes an I2C device initialized from the hardware
+              configuration snapshot.
+    @param    msgDeviceInitReq
+              The device's initialization request.
+*/
+/**************************************************************************/
+void undoI2CDeviceInit(
+    wippersnapper_i2c_v1_I2CDeviceInitRequest *msgDeviceInitReq) {
+  WipperSnapper_Component_I2C *i2cPort =
+      getI2CPort(msgDeviceInitReq->i2c_port_number);
+  if (i2cPort == NULL)
+    return;
+  wippersnapper_i2c_v1_I2CDeviceDeinitRequest msgDeviceDeinitReq =
+      wippersnapper_i2c_v1_I2CDeviceDeinitRequest_init_zero;
+  msgDeviceDeinitReq.i2c_port_number = msgDeviceInitReq->i2c_port_number;
+  msgDeviceDeinitReq.i2c_device_address = msgDeviceInitReq->i2c_device_address;
+  i2cPort->deinitI2CDevice(&msgDeviceDeinitReq);
+}
+
+/**************************************************************************/
+/*!
+    @brief    Deinitializes an I2C device from a list of I2C device
+              initialization requests in the hardware configuration
+              snapshot.
+    @param    stream
+              Input stream to read from.
+    @param    field
+              Message descriptor, usually autogenerated.
+    @param    arg
+              Stores any information the decoding callback may need.
+    @returns  True if the request was decoded, False otherwise.
+*/
+/**************************************************************************/
+bool cbUndoI2CDeviceInitMsg(pb_istream_t *stream, const pb_field_t *field,
+                            void **arg) {
+  wippersnapper_i2c_v1_I2CDeviceInitRequest msgDeviceInitReq =
+      wippersnapper_i2c_v1_I2CDeviceInitRequest_init_zero;
+  if (!pb_decode(stream, wippersnapper_i2c_v1_I2CDeviceInitRequest_fields,
+                 &msgDeviceInitReq))
+    return false;
+  undoI2CDeviceInit(&msgDeviceInitReq);
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Deinitializes the I2C devices initialized by an I2C message
+              from the hardware configuration snapshot.
+    @param    stream
+              Input stream to read from.
+    @param    field
+              Message descriptor, usually autogenerated.
+    @param    arg
+              Stores any information the decoding callback may need.
+    @returns  True if the message was decoded, False otherwise.
+*/
+/**************************************************************************/
+bool cbUndoI2CMsg(pb_istream_t *stream, const pb_field_t *field, void **arg) {
+  if (field->tag ==
+      wippersnapper_signal_v1_I2CRequest_req_i2c_device_init_tag) {
+    return cbUndoI2CDeviceInitMsg(stream, field, arg);
+  } else if (
+      field->tag ==
+      wippersnapper_signal_v1_I2CRequest_req_i2c_device_init_requests_tag) {
+    wippersnapper_i2c_v1_I2CDeviceInitRequests msgDeviceInitReqs =
+        wippersnapper_i2c_v1_I2CDeviceInitRequests_init_zero;
+    msgDeviceInitReqs.list.funcs.decode = cbUndoI2CDeviceInitMsg;
+    return pb_decode(stream, wippersnapper_i2c_v1_I2CDeviceInitRequests_fields,
+                     &msgDeviceInitReqs);
+  }
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Tears down the components created by a message from the
+              hardware configuration snapshot, which the broker did not
+              re-send. Messages which don't create a component are
+              ignored.
+    @param    topic
+              Topic the message was received on.
+    @param    data
+              The message's payload.
+    @param    len
+              Length of the message's payload.
+*/
+/**************************************************************************/
+void cbWarmStartUndoMsg(ws_warmstart_topic_t topic, char *data,
+                        uint16_t len) {
+  pb_istream_t stream = pb_istream_from_buffer((pb_byte_t *)data, len);
+  switch (topic) {
+  case WS_WARMSTART_TOPIC_SIGNAL: {
+    wippersnapper_signal_v1_CreateSignalRequest msg =
+        wippersnapper_signal_v1_CreateSignalRequest_init_zero;
+    msg.cb_payload.funcs.decode = cbUndoSignalMsg;
+    pb_decode(&stream, wippersnapper_signal_v1_CreateSignalRequest_fields,
+              &msg);
+    break;
+  }
+  case WS_WARMSTART_TOPIC_I2C: {
+    wippersnapper_signal_v1_I2CRequest msg =
+        wippersnapper_signal_v1_I2CRequest_init_zero;
+    msg.cb_payload.funcs.decode = cbUndoI2CMsg;
+    pb_decode(&stream, wippersnapper_signal_v1_I2CRequest_fields, &msg);
+    break;
+  }
+  case WS_WARMSTART_TOPIC_DS18X20: {
+    wippersnapper_signal_v1_Ds18x20Request msg =
+        wippersnapper_signal_v1_Ds18x20Request_init_zero;
+    if (!pb_decode(&stream, wippersnapper_signal_v1_Ds18x20Request_fields,
+                   &msg) ||
+        msg.which_payload !=
+            wippersnapper_signal_v1_Ds18x20Request_req_ds18x20_init_tag)
+      break;
+    wippersnapper_ds18x20_v1_Ds18x20DeInitRequest msgDeInitReq =
+        wippersnapper_ds18x20_v1_Ds18x20DeInitRequest_init_zero;
+    strcpy(msgDeInitReq.onewire_pin,
+           msg.payload.req_ds18x20_init.onewire_pin);
+    WS._ds18x20Component->deleteDS18x20(&msgDeInitReq);
+    break;
+  }
+  case WS_WARMSTART_TOPIC_SERVO: {
+    wippersnapper_signal_v1_ServoRequest msg =
+        wippersnapper_signal_v1_ServoRequest_init_zero;
+    if (pb_decode(&stream, wippersnapper_signal_v1_ServoRequest_fields,
+                  &msg) &&
+        msg.which_payload ==
+            wippersnapper_signal_v1_ServoRequest_servo_attach_tag)
+      WS._servoComponent->servo_detach(
+          atoi(msg.payload.servo_attach.servo_pin + 1));
+    break;
+  }
+  case WS_WARMSTART_TOPIC_PWM: {
+    wippersnapper_signal_v1_PWMRequest msg =
+        wippersnapper_signal_v1_PWMRequest_init_zero;
+    if (pb_decode(&stream, wippersnapper_signal_v1_PWMRequest_fields, &msg) &&
+        msg.which_payload ==
+            wippersnapper_signal_v1_PWMRequest_attach_request_tag)
+      WS._pwmComponent->detach(atoi(msg.payload.attach_request.pin + 1));
+    break;
+  }
+  case WS_WARMSTART_TOPIC_PIXELS: {
+    wippersnapper_signal_v1_PixelsRequest msg =
+        wippersnapper_signal_v1_PixelsRequest_init_zero;
+    if (!pb_decode(&stream, wippersnapper_signal_v1_PixelsRequest_fields,
+                   &msg) ||
+        msg.which_payload !=
+            wippersnapper_signal_v1_PixelsRequest_req_pixels_create_tag)
+      break;
+    wippersnapper_pixels_v1_PixelsCreateRequest *msgCreateReq =
+        &msg.payload.req_pixels_create;
+    wippersnapper_pixels_v1_PixelsDeleteRequest msgDeleteReq =
+        wippersnapper_pixels_v1_PixelsDeleteRequest_init_zero;
+    msgDeleteReq.pixels_type = msgCreateReq->pixels_type;
+    strcpy(msgDeleteReq.pixels_pin_data,
+           msgCreateReq->pixels_type ==
+                   wippersnapper_pixels_v1_PixelsType_PIXELS_TYPE_DOTSTAR
+               ? msgCreateReq->pixels_pin_dotstar_data
+               : msgCreateReq->pixels_pin_neopixel);
+    WS._ws_pixelsComponent->deleteStrand(&msgDeleteReq);
+    break;
+  }
+  default:
+    break;
+  }
+}
+
 /**************************************************************************/
 /*!
     @brief    Called when broker responds to a device's publish across
@@ -1558,18 +1959,19 @@ void cbErrorTopic(char *errorData, uint16_t len) {
 */
 /**************************************************************************/
 void cbThrottleTopic(char *throttleData, uint16_t len) {
-  WS_DEBUG_PRINT("IO Throttle Error: ");
-  WS_DEBUG_PRINTLN(throttleData);
+  WS_LOG_WARN(MQTT, "IO Throttle Error: %s", throttleData);
   char *throttleMessage;
   // Parse out # of seconds from message buffer
   throttleMessage = strtok(throttleData, ",");
   throttleMessage = strtok(NULL, " ");
   // Convert from seconds to to millis
   int throttleDuration = atoi(throttleMessage) * 1000;
+  // we went over the budget, start again from an empty bucket
+  WS._mqttBudget->drain();
 
-  WS_DEBUG_PRINT("Device is throttled for ");
-  WS_DEBUG_PRINT(throttleDuration);
-  WS_DEBUG_PRINTLN("ms and blocking command execution.");
+  WS_LOG_WARN(MQTT,
+              "Device is throttled for %dms and blocking command execution.",
+              throttleDuration);
 
 #ifdef USE_DISPLAY
   char buffer[100];
@@ -1580,51 +1982,62 @@ void cbThrottleTopic(char *throttleData, uint16_t len) {
   WS._ui_helper->add_text_to_terminal(buffer);
 #endif
 
-  // If throttle duration is less than the keepalive interval, delay for the
-  // full keepalive interval
-  if (throttleDuration < WS_KEEPALIVE_INTERVAL_MS) {
-    delay(WS_KEEPALIVE_INTERVAL_MS);
+  // If throttle duration is less than the throttle interval, delay for the
+  // full throttle interval
+  if (throttleDuration < WS_THROTTLE_INTERVAL_MS) {
+    delay(WS_THROTTLE_INTERVAL_MS);
   } else {
     // round to nearest millis to prevent delaying for less time than req'd.
-    float throttleLoops = ceil(throttleDuration / WS_KEEPALIVE_INTERVAL_MS);
+    float throttleLoops = ceil(throttleDuration / WS_THROTTLE_INTERVAL_MS);
     // block the run() loop
     while (throttleLoops > 0) {
-      delay(WS_KEEPALIVE_INTERVAL_MS);
+      delay(WS_THROTTLE_INTERVAL_MS);
       WS.feedWDT();
-      WS._mqtt->ping();
+      // the PINGRESP is read by processPackets() once un-throttled
+      if (WS.mqttClient() != nullptr)
+        WS._mqttWindow->ping(WS.mqttClient());
+      else
+        WS._mqtt->ping();
       throttleLoops--;
     }
   }
-  WS_DEBUG_PRINTLN("Device is un-throttled, resumed command execution");
+  WS_LOG_WARN(MQTT, "Device is un-throttled, resumed command execution");
 #ifdef USE_DISPLAY
   WS._ui_helper->add_text_to_terminal(
       "[IO] Device is un-throttled, resuming...\n");
 #endif
 }
 
+#ifdef WS_DEBUG
 /**************************************************************************/
 /*!
-    @brief    Builds MQTT topics for handling errors returned from the
-                Adafruit IO broker and subscribes to them
-    @returns  True if memory for error topics allocated successfully,
-                False otherwise.
+    @brief    Called when the device receives a command on its
+                diagnostics/log topic, such as "i2c=debug". Sets the
+                runtime log levels and reports them back.
+    @param    data
+                Command from the broker.
+    @param    len
+                Length of data received from MQTT broker.
 */
 /**************************************************************************/
-bool Wippersnapper::generateWSErrorTopics() {
-// dynamically allocate memory for err topic
-#ifdef USE_PSRAM
-  WS._err_topic = (char *)ps_malloc(
-      sizeof(char) * (strlen(WS._username) + strlen(TOPIC_IO_ERRORS) + 1));
-#else
-  WS._err_topic = (char *)malloc(
-      sizeof(char) * (strlen(WS._username) + strlen(TOPIC_IO_ERRORS) + 1));
+void cbLogLevels(char *data, uint16_t len) {
+  if (!ws_log::setLevels(data))
+    WS_DEBUG_PRINTLN("ERROR: Invalid log level command!");
+  ws_log::reportLevels();
+}
 #endif
 
-  if (WS._err_topic) { // build error topic
-    strcpy(WS._err_topic, WS._username);
-    strcat(WS._err_topic, TOPIC_IO_ERRORS);
-  } else { // malloc failed
-    WS_DEBUG_PRINTLN("ERROR: Failed to allocate global error topic!");
+/**************************************************************************/
+/*!
+    @brief    Subscribes to the MQTT topics for handling errors returned
+                from the Adafruit IO broker. The topics are built by
+                generateWSTopics().
+    @returns  True if the error topics were subscribed to, False otherwise.
+*/
+/**************************************************************************/
+bool Wippersnapper::generateWSErrorTopics() {
+  if (WS._err_topic == NULL || WS._throttle_topic == NULL) {
+    WS_DEBUG_PRINTLN("ERROR: Global error topics not allocated!");
     return false;
   }
 
@@ -1633,23 +2046,6 @@ bool Wippersnapper::generateWSErrorTopics() {
   WS._mqtt->subscribe(_err_sub);
   _err_sub->setCallback(cbErrorTopic);
 
-// dynamically allocate memory for throttle topic
-#ifdef USE_PSRAM
-  WS._throttle_topic = (char *)ps_malloc(
-      sizeof(char) * (strlen(WS._username) + strlen(TOPIC_IO_THROTTLE) + 1));
-#else
-  WS._throttle_topic = (char *)malloc(
-      sizeof(char) * (strlen(WS._username) + strlen(TOPIC_IO_THROTTLE) + 1));
-#endif
-
-  if (WS._throttle_topic) { // build throttle topic
-    strcpy(WS._throttle_topic, WS._username);
-    strcat(WS._throttle_topic, TOPIC_IO_THROTTLE);
-  } else { // malloc failed
-    WS_DEBUG_PRINTLN("ERROR: Failed to allocate global throttle topic!");
-    return false;
-  }
-
   // Subscribe to throttle topic
   _throttle_sub = new Adafruit_MQTT_Subscribe(WS._mqtt, WS._throttle_topic);
   WS._mqtt->subscribe(_throttle_sub);
@@ -1714,406 +2110,136 @@ bool Wippersnapper::generateDeviceUID() {
 /**************************************************************************/
 /*!
     @brief    Generates device-specific Wippersnapper control topics and
-              subscribes to them.
+              subscribes to them. All topics are laid out in a single
+              allocation, sized up front.
+
+              NOTE: Each broker-to-device topic gets its own subscription.
+              Adafruit_MQTT dispatches an incoming PUBLISH only when its
+              topic exactly matches a subscription's topic. Packets that
+              arrive on a wildcard subscription (e.g. `.../broker/#`) are
+              dropped without a PUBACK, including while publish() or
+              ping() wait for their own acknowledgement, so the topics
+              can't be collapsed into a single wildcard subscription.
     @returns  True if memory for control topics allocated successfully,
                 False otherwise.
 */
 /**************************************************************************/
 bool Wippersnapper::generateWSTopics() {
-// Create global registration topic
-#ifdef USE_PSRAM
-  WS._topic_description = (char *)ps_malloc(
-      sizeof(char) * strlen(WS._username) + strlen("/wprsnpr") +
-      strlen(TOPIC_INFO) + strlen("status") + 1);
-#else
-  WS._topic_description =
-      (char *)malloc(sizeof(char) * strlen(WS._username) + strlen("/wprsnpr") +
-                     strlen(TOPIC_INFO) + strlen("status") + 1);
-#endif
-  if (WS._topic_description != NULL) {
-    strcpy(WS._topic_description, WS._username);
-    strcat(WS._topic_description, "/wprsnpr");
-    strcat(WS._topic_description, TOPIC_INFO);
-    strcat(WS._topic_description, "status");
-  } else { // malloc failed
-    WS_DEBUG_PRINTLN("ERROR: Failed to allocate registration topic!");
-    return false;
+  // Each topic is either the username or the device prefix
+  // (username/wprsnpr/uid), followed by a suffix
+  struct {
+    char **topic;       // topic to build
+    bool isDeviceTopic; // true if the topic starts with the device prefix
+    const char *suffix; // topic's suffix
+  } topics[] = {
+      {&WS._topic_description, false, "/wprsnpr" TOPIC_INFO "status"},
+      {&WS._topic_description_status, true, TOPIC_INFO "status/broker"},
+      {&WS._topic_description_status_complete, true,
+       TOPIC_INFO "status/device/complete"},
+      {&WS._topic_signal_device, true, TOPIC_SIGNALS "device"},
+      {&WS._topic_device_pin_config_complete, true,
+       TOPIC_SIGNALS "device/pinConfigComplete"},
+      {&WS._topic_signal_brkr, true, TOPIC_SIGNALS "broker"},
+      {&WS._topic_signal_i2c_brkr, true, TOPIC_SIGNALS "broker" TOPIC_I2C},
+      {&WS._topic_signal_i2c_device, true, TOPIC_SIGNALS "device" TOPIC_I2C},
+      {&WS._topic_signal_ds18_brkr, true, TOPIC_SIGNALS "broker/ds18x20"},
+      {&WS._topic_signal_ds18_device, true, TOPIC_SIGNALS "device/ds18x20"},
+      {&WS._topic_signal_servo_brkr, true, TOPIC_SIGNALS "broker/servo"},
+      {&WS._topic_signal_servo_device, true, TOPIC_SIGNALS "device/servo"},
+      {&WS._topic_signal_pwm_brkr, true, TOPIC_SIGNALS "broker/pwm"},
+      {&WS._topic_signal_pwm_device, true, TOPIC_SIGNALS "device/pwm"},
+      {&WS._topic_signal_pixels_brkr, true, MQTT_TOPIC_PIXELS_BROKER},
+      {&WS._topic_signal_pixels_device, true, MQTT_TOPIC_PIXELS_DEVICE},
+      {&WS._topic_diagnostics, true, TOPIC_DIAGNOSTICS},
+      {&WS._topic_log_levels, true, TOPIC_LOG_LEVELS},
+      {&WS._err_topic, false, TOPIC_IO_ERRORS},
+      {&WS._throttle_topic, false, TOPIC_IO_THROTTLE},
+  };
+  size_t numTopics = sizeof(topics) / sizeof(topics[0]);
+
+  // Size the arena
+  size_t userLen = strlen(WS._username);
+  size_t prefixLen = userLen + strlen(TOPIC_WS) + strlen(_device_uid);
+  size_t arenaLen = 0;
+  for (size_t i = 0; i < numTopics; i++) {
+    arenaLen += topics[i].isDeviceTopic ? prefixLen : userLen;
+    arenaLen += strlen(topics[i].suffix) + 1;
   }
 
-// Create registration status topic
 #ifdef USE_PSRAM
-  WS._topic_description_status = (char *)ps_malloc(
-      sizeof(char) * strlen(WS._username) + strlen("/wprsnpr/") +
-      strlen(_device_uid) + strlen(TOPIC_INFO) + strlen("status/") +
-      strlen("broker") + 1);
+  _topicArena = (char *)ps_malloc(arenaLen);
 #else
-  WS._topic_description_status =
-      (char *)malloc(sizeof(char) * strlen(WS._username) + strlen("/wprsnpr/") +
-                     strlen(_device_uid) + strlen(TOPIC_INFO) +
-                     strlen("status/") + strlen("broker") + 1);
+  _topicArena = (char *)malloc(arenaLen);
 #endif
-  if (WS._topic_description_status != NULL) {
-    strcpy(WS._topic_description_status, WS._username);
-    strcat(WS._topic_description_status, "/wprsnpr/");
-    strcat(WS._topic_description_status, _device_uid);
-    strcat(WS._topic_description_status, TOPIC_INFO);
-    strcat(WS._topic_description_status, "status");
-    strcat(WS._topic_description_status, "/broker");
-  } else { // malloc failed
-    WS_DEBUG_PRINTLN("ERROR: Failed to allocate registration status topic!");
+  if (_topicArena == NULL) { // malloc failed
+    WS_DEBUG_PRINTLN("ERROR: Failed to allocate MQTT topics!");
     return false;
   }
 
+  // Build each topic within the arena
+  char *topic = _topicArena;
+  for (size_t i = 0; i < numTopics; i++) {
+    *topics[i].topic = topic;
+    memcpy(topic, WS._username, userLen);
+    topic += userLen;
+    if (topics[i].isDeviceTopic) {
+      strcpy(topic, TOPIC_WS);
+      strcat(topic, _device_uid);
+      topic += prefixLen - userLen;
+    }
+    strcpy(topic, topics[i].suffix);
+    topic += strlen(topics[i].suffix) + 1;
+  }
+
   // Subscribe to registration status topic
   _topic_description_sub =
       new Adafruit_MQTT_Subscribe(WS._mqtt, WS._topic_description_status, 1);
   WS._mqtt->subscribe(_topic_description_sub);
   _topic_description_sub->setCallback(cbRegistrationStatus);
 
-// Create registration status complete topic
-#ifdef USE_PSRAM
-  WS._topic_description_status_complete = (char *)ps_malloc(
-      sizeof(char) * strlen(WS._username) + strlen("/wprsnpr/") +
-      strlen(_device_uid) + strlen(TOPIC_INFO) + strlen("status") +
-      strlen("/device/complete") + 1);
-#else
-  WS._topic_description_status_complete =
-      (char *)malloc(sizeof(char) * strlen(WS._username) + strlen("/wprsnpr/") +
-                     strlen(_device_uid) + strlen(TOPIC_INFO) +
-                     strlen("status") + strlen("/device/complete") + 1);
-#endif
-  if (WS._topic_description_status_complete != NULL) {
-    strcpy(WS._topic_description_status_complete, WS._username);
-    strcat(WS._topic_description_status_complete, "/wprsnpr/");
-    strcat(WS._topic_description_status_complete, _device_uid);
-    strcat(WS._topic_description_status_complete, TOPIC_INFO);
-    strcat(WS._topic_description_status_complete, "status");
-    strcat(WS._topic_description_status_complete, "/device/complete");
-  } else { // malloc failed
-    WS_DEBUG_PRINTLN("ERROR: Failed to allocate registration complete topic!");
-    return false;
-  }
-
-// Create device-to-broker signal topic
-#ifdef USE_PSRAM
-  WS._topic_signal_device = (char *)ps_malloc(
-      sizeof(char) * strlen(WS._username) + strlen("/wprsnpr/") +
-      strlen(_device_uid) + strlen(TOPIC_SIGNALS) + strlen("device") + 1);
-#else
-  WS._topic_signal_device = (char *)malloc(
-      sizeof(char) * strlen(WS._username) + strlen("/wprsnpr/") +
-      strlen(_device_uid) + strlen(TOPIC_SIGNALS) + strlen("device") + 1);
-#endif
-  if (WS._topic_signal_device != NULL) {
-    strcpy(WS._topic_signal_device, WS._username);
-    strcat(WS._topic_signal_device, "/wprsnpr/");
-    strcat(WS._topic_signal_device, _device_uid);
-    strcat(WS._topic_signal_device, TOPIC_SIGNALS);
-    strcat(WS._topic_signal_device, "device");
-  } else { // malloc failed
-    WS_DEBUG_PRINTLN("ERROR: Failed to allocate d2c signal topic!");
-    return false;
-  }
-
-// Create pin configuration complete topic
-#ifdef USE_PSRAM
-  WS._topic_device_pin_config_complete = (char *)ps_malloc(
-      sizeof(char) * strlen(WS._username) + strlen("/wprsnpr/") +
-      strlen(_device_uid) + strlen(TOPIC_SIGNALS) +
-      strlen("device/pinConfigComplete") + 1);
-#else
-  WS._topic_device_pin_config_complete =
-      (char *)malloc(sizeof(char) * strlen(WS._username) + strlen("/wprsnpr/") +
-                     strlen(_device_uid) + strlen(TOPIC_SIGNALS) +
-                     strlen("device/pinConfigComplete") + 1);
-#endif
-  if (WS._topic_device_pin_config_complete != NULL) {
-    strcpy(WS._topic_device_pin_config_complete, WS._username);
-    strcat(WS._topic_device_pin_config_complete, "/wprsnpr/");
-    strcat(WS._topic_device_pin_config_complete, _device_uid);
-    strcat(WS._topic_device_pin_config_complete, TOPIC_SIGNALS);
-    strcat(WS._topic_device_pin_config_complete, "device/pinConfigComplete");
-  } else { // malloc failed
-    WS_DEBUG_PRINTLN(
-        "ERROR: Failed to allocate pin config complete flag topic!");
-    return false;
-  }
-
-// Create broker-to-device signal topic
-#ifdef USE_PSRAM
-  WS._topic_signal_brkr = (char *)ps_malloc(
-      sizeof(char) * strlen(WS._username) + strlen("/wprsnpr/") +
-      strlen(_device_uid) + strlen(TOPIC_SIGNALS) + strlen("broker") + 1);
-#else
-  WS._topic_signal_brkr = (char *)malloc(
-      sizeof(char) * strlen(WS._username) + strlen("/wprsnpr/") +
-      strlen(_device_uid) + strlen(TOPIC_SIGNALS) + strlen("broker") + 1);
-#endif
-  if (WS._topic_signal_brkr != NULL) {
-    strcpy(WS._topic_signal_brkr, WS._username);
-    strcat(WS._topic_signal_brkr, "/wprsnpr/");
-    strcat(WS._topic_signal_brkr, _device_uid);
-    strcat(WS._topic_signal_brkr, TOPIC_SIGNALS);
-    strcat(WS._topic_signal_brkr, "broker");
-  } else { // malloc failed
-    WS_DEBUG_PRINTLN("ERROR: Failed to allocate c2d signal topic!");
-    return false;
-  }
-
   // Subscribe to signal topic
   _topic_signal_brkr_sub =
       new Adafruit_MQTT_Subscribe(WS._mqtt, WS._topic_signal_brkr, 1);
   WS._mqtt->subscribe(_topic_signal_brkr_sub);
   _topic_signal_brkr_sub->setCallback(cbSignalTopic);
 
-// Create device-to-broker i2c signal topic
-#ifdef USE_PSRAM
-  WS._topic_signal_i2c_brkr = (char *)ps_malloc(
-      sizeof(char) * strlen(WS._username) + +strlen("/") + strlen(_device_uid) +
-      strlen("/wprsnpr/") + strlen(TOPIC_SIGNALS) + strlen("broker") +
-      strlen(TOPIC_I2C) + 1);
-#else
-  WS._topic_signal_i2c_brkr = (char *)malloc(
-      sizeof(char) * strlen(WS._username) + +strlen("/") + strlen(_device_uid) +
-      strlen("/wprsnpr/") + strlen(TOPIC_SIGNALS) + strlen("broker") +
-      strlen(TOPIC_I2C) + 1);
-#endif
-  if (WS._topic_signal_i2c_brkr != NULL) {
-    strcpy(WS._topic_signal_i2c_brkr, WS._username);
-    strcat(WS._topic_signal_i2c_brkr, TOPIC_WS);
-    strcat(WS._topic_signal_i2c_brkr, _device_uid);
-    strcat(WS._topic_signal_i2c_brkr, TOPIC_SIGNALS);
-    strcat(WS._topic_signal_i2c_brkr, "broker");
-    strcat(WS._topic_signal_i2c_brkr, TOPIC_I2C);
-  } else { // malloc failed
-    WS_DEBUG_PRINTLN("ERROR: Failed to allocate d2c i2c topic!");
-    return false;
-  }
-
   // Subscribe to signal's I2C sub-topic
   _topic_signal_i2c_sub =
       new Adafruit_MQTT_Subscribe(WS._mqtt, WS._topic_signal_i2c_brkr, 1);
   WS._mqtt->subscribe(_topic_signal_i2c_sub);
   _topic_signal_i2c_sub->setCallback(cbSignalI2CReq);
 
-// Create broker-to-device i2c signal topic
-#ifdef USE_PSRAM
-  WS._topic_signal_i2c_device = (char *)ps_malloc(
-      sizeof(char) * strlen(WS._username) + +strlen("/") + strlen(_device_uid) +
-      strlen("/wprsnpr/") + strlen(TOPIC_SIGNALS) + strlen("device") +
-      strlen(TOPIC_I2C) + 1);
-#else
-  WS._topic_signal_i2c_device = (char *)malloc(
-      sizeof(char) * strlen(WS._username) + +strlen("/") + strlen(_device_uid) +
-      strlen("/wprsnpr/") + strlen(TOPIC_SIGNALS) + strlen("device") +
-      strlen(TOPIC_I2C) + 1);
-#endif
-  if (WS._topic_signal_i2c_device != NULL) {
-    strcpy(WS._topic_signal_i2c_device, WS._username);
-    strcat(WS._topic_signal_i2c_device, TOPIC_WS);
-    strcat(WS._topic_signal_i2c_device, _device_uid);
-    strcat(WS._topic_signal_i2c_device, TOPIC_SIGNALS);
-    strcat(WS._topic_signal_i2c_device, "device");
-    strcat(WS._topic_signal_i2c_device, TOPIC_I2C);
-  } else { // malloc failed
-    WS_DEBUG_PRINTLN("ERROR: Failed to c2d i2c topic!");
-    return false;
-  }
-
-// Create device-to-broker ds18x20 topic
-#ifdef USE_PSRAM
-  WS._topic_signal_ds18_brkr = (char *)ps_malloc(
-      sizeof(char) * strlen(WS._username) + +strlen("/") + strlen(_device_uid) +
-      strlen("/wprsnpr/") + strlen(TOPIC_SIGNALS) + strlen("broker/") +
-      strlen("ds18x20") + 1);
-#else
-  WS._topic_signal_ds18_brkr = (char *)malloc(
-      sizeof(char) * strlen(WS._username) + +strlen("/") + strlen(_device_uid) +
-      strlen("/wprsnpr/") + strlen(TOPIC_SIGNALS) + strlen("broker/") +
-      strlen("ds18x20") + 1);
-#endif
-  if (WS._topic_signal_ds18_brkr != NULL) {
-    strcpy(WS._topic_signal_ds18_brkr, WS._username);
-    strcat(WS._topic_signal_ds18_brkr, TOPIC_WS);
-    strcat(WS._topic_signal_ds18_brkr, _device_uid);
-    strcat(WS._topic_signal_ds18_brkr, TOPIC_SIGNALS);
-    strcat(WS._topic_signal_ds18_brkr, "broker/ds18x20");
-  } else { // malloc failed
-    WS_DEBUG_PRINTLN("ERROR: Failed to allocate d2c ds18x20 topic!");
-    return false;
-  }
-
   // Subscribe to signal's ds18x20 sub-topic
   _topic_signal_ds18_sub =
       new Adafruit_MQTT_Subscribe(WS._mqtt, WS._topic_signal_ds18_brkr, 1);
   WS._mqtt->subscribe(_topic_signal_ds18_sub);
   _topic_signal_ds18_sub->setCallback(cbSignalDSReq);
 
-// Create broker-to-device ds18x20 topic
-#ifdef USE_PSRAM
-  WS._topic_signal_ds18_device = (char *)ps_malloc(
-      sizeof(char) * strlen(WS._username) + +strlen("/") + strlen(_device_uid) +
-      strlen("/wprsnpr/") + strlen(TOPIC_SIGNALS) + strlen("device/") +
-      strlen("ds18x20") + 1);
-#else
-  WS._topic_signal_ds18_device = (char *)malloc(
-      sizeof(char) * strlen(WS._username) + +strlen("/") + strlen(_device_uid) +
-      strlen("/wprsnpr/") + strlen(TOPIC_SIGNALS) + strlen("device/") +
-      strlen("ds18x20") + 1);
-#endif
-  if (WS._topic_signal_ds18_device != NULL) {
-    strcpy(WS._topic_signal_ds18_device, WS._username);
-    strcat(WS._topic_signal_ds18_device, TOPIC_WS);
-    strcat(WS._topic_signal_ds18_device, _device_uid);
-    strcat(WS._topic_signal_ds18_device, TOPIC_SIGNALS);
-    strcat(WS._topic_signal_ds18_device, "device/ds18x20");
-  } else { // malloc failed
-    WS_DEBUG_PRINTLN("ERROR: Failed to allocate c2d ds18x20 topic!");
-    return false;
-  }
-
-// Create device-to-broker servo signal topic
-#ifdef USE_PSRAM
-  WS._topic_signal_servo_brkr = (char *)ps_malloc(
-      sizeof(char) * strlen(WS._username) + strlen("/") + strlen(_device_uid) +
-      strlen("/wprsnpr/signals/broker/servo") + 1);
-#else
-  WS._topic_signal_servo_brkr = (char *)malloc(
-      sizeof(char) * strlen(WS._username) + strlen("/") + strlen(_device_uid) +
-      strlen("/wprsnpr/signals/broker/servo") + 1);
-#endif
-  if (WS._topic_signal_servo_brkr != NULL) {
-    strcpy(WS._topic_signal_servo_brkr, WS._username);
-    strcat(WS._topic_signal_servo_brkr, TOPIC_WS);
-    strcat(WS._topic_signal_servo_brkr, _device_uid);
-    strcat(WS._topic_signal_servo_brkr, TOPIC_SIGNALS);
-    strcat(WS._topic_signal_servo_brkr, "broker/servo");
-  } else { // malloc failed
-    WS_DEBUG_PRINTLN("ERROR: Failed to allocate d2c servo topic!");
-    return false;
-  }
-
   // Subscribe to servo sub-topic
   _topic_signal_servo_sub =
       new Adafruit_MQTT_Subscribe(WS._mqtt, WS._topic_signal_servo_brkr, 1);
   WS._mqtt->subscribe(_topic_signal_servo_sub);
   _topic_signal_servo_sub->setCallback(cbServoMsg);
 
-// Create broker-to-device servo signal topic
-#ifdef USE_PSRAM
-  WS._topic_signal_servo_device = (char *)ps_malloc(
-      sizeof(char) * strlen(WS._username) + strlen("/") + strlen(_device_uid) +
-      strlen("/wprsnpr/signals/device/servo") + 1);
-#else
-  WS._topic_signal_servo_device = (char *)malloc(
-      sizeof(char) * strlen(WS._username) + strlen("/") + strlen(_device_uid) +
-      strlen("/wprsnpr/signals/device/servo") + 1);
-#endif
-  if (WS._topic_signal_servo_device != NULL) {
-    strcpy(WS._topic_signal_servo_device, WS._username);
-    strcat(WS._topic_signal_servo_device, TOPIC_WS);
-    strcat(WS._topic_signal_servo_device, _device_uid);
-    strcat(WS._topic_signal_servo_device, TOPIC_SIGNALS);
-    strcat(WS._topic_signal_servo_device, "device/servo");
-  } else { // malloc failed
-    WS_DEBUG_PRINTLN("ERROR: Failed to allocate c2d servo topic!");
-    return false;
-  }
-
-// Topic for pwm messages from broker->device
-#ifdef USE_PSRAM
-  WS._topic_signal_pwm_brkr = (char *)ps_malloc(
-      sizeof(char) * strlen(WS._username) + strlen("/") + strlen(_device_uid) +
-      strlen("/wprsnpr/signals/broker/pwm") + 1);
-#else
-  WS._topic_signal_pwm_brkr = (char *)malloc(
-      sizeof(char) * strlen(WS._username) + strlen("/") + strlen(_device_uid) +
-      strlen("/wprsnpr/signals/broker/pwm") + 1);
-#endif
-  // Create device-to-broker pwm signal topic
-  if (WS._topic_signal_pwm_brkr != NULL) {
-    strcpy(WS._topic_signal_pwm_brkr, WS._username);
-    strcat(WS._topic_signal_pwm_brkr, TOPIC_WS);
-    strcat(WS._topic_signal_pwm_brkr, _device_uid);
-    strcat(WS._topic_signal_pwm_brkr, TOPIC_SIGNALS);
-    strcat(WS._topic_signal_pwm_brkr, "broker/pwm");
-  } else { // malloc failed
-    WS_DEBUG_PRINTLN("ERROR: Failed to allocate c2d pwm topic!");
-    return false;
-  }
-
   // Subscribe to PWM sub-topic
   _topic_signal_pwm_sub =
       new Adafruit_MQTT_Subscribe(WS._mqtt, WS._topic_signal_pwm_brkr, 1);
   WS._mqtt->subscribe(_topic_signal_pwm_sub);
   _topic_signal_pwm_sub->setCallback(cbPWMMsg);
 
-// Topic for pwm messages from device->broker
-#ifdef USE_PSRAM
-  WS._topic_signal_pwm_device = (char *)ps_malloc(
-      sizeof(char) * strlen(WS._username) + strlen("/") + strlen(_device_uid) +
-      strlen("/wprsnpr/signals/device/pwm") + 1);
-#else
-  WS._topic_signal_pwm_device = (char *)malloc(
-      sizeof(char) * strlen(WS._username) + strlen("/") + strlen(_device_uid) +
-      strlen("/wprsnpr/signals/device/pwm") + 1);
-#endif
-  if (WS._topic_signal_pwm_device != NULL) {
-    strcpy(WS._topic_signal_pwm_device, WS._username);
-    strcat(WS._topic_signal_pwm_device, TOPIC_WS);
-    strcat(WS._topic_signal_pwm_device, _device_uid);
-    strcat(WS._topic_signal_pwm_device, TOPIC_SIGNALS);
-    strcat(WS._topic_signal_pwm_device, "device/pwm");
-  } else { // malloc failed
-    WS_DEBUG_PRINTLN("ERROR: Failed to allocate d2c pwm topic!");
-    return false;
-  }
-
-// Topic for pixel messages from broker->device
-#ifdef USE_PSRAM
-  WS._topic_signal_pixels_brkr = (char *)ps_malloc(
-      sizeof(char) * strlen(WS._username) + strlen("/") + strlen(_device_uid) +
-      strlen("/wprsnpr/signals/broker/pixels") + 1);
-#else
-  WS._topic_signal_pixels_brkr = (char *)malloc(
-      sizeof(char) * strlen(WS._username) + strlen("/") + strlen(_device_uid) +
-      strlen("/wprsnpr/signals/broker/pixels") + 1);
-#endif
-  if (WS._topic_signal_pixels_brkr != NULL) {
-    strcpy(WS._topic_signal_pixels_brkr, WS._username);
-    strcat(WS._topic_signal_pixels_brkr, TOPIC_WS);
-    strcat(WS._topic_signal_pixels_brkr, _device_uid);
-    strcat(WS._topic_signal_pixels_brkr, MQTT_TOPIC_PIXELS_BROKER);
-  } else { // malloc failed
-    WS_DEBUG_PRINTLN("ERROR: Failed to allocate c2d pixel topic!");
-    return false;
-  }
-
   // Subscribe to pixels sub-topic
   _topic_signal_pixels_sub =
       new Adafruit_MQTT_Subscribe(WS._mqtt, WS._topic_signal_pixels_brkr, 1);
   WS._mqtt->subscribe(_topic_signal_pixels_sub);
   _topic_signal_pixels_sub->setCallback(cbPixelsMsg);
 
-// Topic for pixel messages from device->broker
-#ifdef USE_PSRAM
-  WS._topic_signal_pixels_device = (char *)ps_malloc(
-      sizeof(char) * strlen(WS._username) + strlen("/") + strlen(_device_uid) +
-      strlen("/wprsnpr/signals/device/pixels") + 1);
-#else
-  WS._topic_signal_pixels_device = (char *)malloc(
-      sizeof(char) * strlen(WS._username) + strlen("/") + strlen(_device_uid) +
-      strlen("/wprsnpr/signals/device/pixels") + 1);
+#ifdef WS_DEBUG
+  // Subscribe to log level sub-topic
+  _topic_log_levels_sub =
+      new Adafruit_MQTT_Subscribe(WS._mqtt, WS._topic_log_levels, 1);
+  WS._mqtt->subscribe(_topic_log_levels_sub);
+  _topic_log_levels_sub->setCallback(cbLogLevels);
 #endif
-  if (WS._topic_signal_pixels_device != NULL) {
-    strcpy(WS._topic_signal_pixels_device, WS._username);
-    strcat(WS._topic_signal_pixels_device, TOPIC_WS);
-    strcat(WS._topic_signal_pixels_device, _device_uid);
-    strcat(WS._topic_signal_pixels_device, MQTT_TOPIC_PIXELS_DEVICE);
-  } else { // malloc failed
-    WS_DEBUG_PRINTLN("ERROR: Failed to allocate d2c pixels topic!");
-    return false;
-  }
 
   return true;
 }
@@ -2136,7 +2262,7 @@ void Wippersnapper::errorWriteHang(String error) {
   while (1) {
     WS.feedWDT();
     statusLEDBlink(WS_LED_STATUS_ERROR_RUNTIME);
-    delay(1000);
+    statusLEDWait(1600);
   }
 }
 
@@ -2164,7 +2290,8 @@ void Wippersnapper::runNetFSM() {
       break;
     case FSM_NET_CHECK_NETWORK:
       if (networkStatus() == WS_NET_CONNECTED) {
-        WS_DEBUG_PRINTLN("Connected to WiFi!");
+        WS_LOG_INFO(NET, "Connected to WiFi!");
+        cacheNetwork();
 #ifdef USE_DISPLAY
         if (WS._ui_helper->getLoadingState())
           WS._ui_helper->set_load_bar_icon_complete(loadBarIconWifi);
@@ -2175,11 +2302,16 @@ void Wippersnapper::runNetFSM() {
       fsmNetwork = FSM_NET_ESTABLISH_NETWORK;
       break;
     case FSM_NET_ESTABLISH_NETWORK:
-      WS_DEBUG_PRINTLN("Connecting to WiFi...");
+      WS_LOG_INFO(NET, "Connecting to WiFi...");
 #ifdef USE_DISPLAY
       if (WS._ui_helper->getLoadingState())
         WS._ui_helper->set_label_status("Connecting to WiFi...");
 #endif
+      // Rejoin the last access point first, a WiFi scan takes seconds
+      if (fastConnect()) {
+        fsmNetwork = FSM_NET_CHECK_NETWORK;
+        break;
+      }
       // Perform a WiFi scan and check if SSID within
       // secrets.json is within the scanned SSIDs
       if (!check_valid_ssid()) {
@@ -2194,15 +2326,18 @@ void Wippersnapper::runNetFSM() {
       // Attempt to connect to wireless network
       maxAttempts = 5;
       while (maxAttempts > 0) {
-        // blink before we connect
+        // blink while we connect
         statusLEDBlink(WS_LED_STATUS_WIFI_CONNECTING);
         WS.feedWDT();
         // attempt to connect
-        WS_DEBUG_PRINTLN("Attempting to connect to WiFi...");
+        WS_LOG_INFO(NET, "Attempting to connect to WiFi...");
         _connect();
         WS.feedWDT();
-        // blink to simulate a delay to allow wifi connection to process
-        statusLEDBlink(WS_LED_STATUS_WIFI_CONNECTING);
+        // allow the wifi connection to process
+        unsigned long connectStart = millis();
+        while (networkStatus() != WS_NET_CONNECTED &&
+               millis() - connectStart < WS_NET_CONNECT_GRACE_MS)
+          statusLEDWait(10);
         // did we connect?
         if (networkStatus() == WS_NET_CONNECTED)
           break;
@@ -2211,7 +2346,7 @@ void Wippersnapper::runNetFSM() {
 
       // Validate connection
       if (networkStatus() != WS_NET_CONNECTED) {
-        WS_DEBUG_PRINTLN("ERROR: Unable to connect to WiFi!");
+        WS_LOG_ERROR(NET, "ERROR: Unable to connect to WiFi!");
 #ifdef USE_DISPLAY
         WS._ui_helper->show_scr_error(
             "CONNECTION ERROR",
@@ -2225,25 +2360,30 @@ void Wippersnapper::runNetFSM() {
       fsmNetwork = FSM_NET_CHECK_NETWORK;
       break;
     case FSM_NET_ESTABLISH_MQTT:
-      WS_DEBUG_PRINTLN("Attempting to connect to IO...");
+      WS_LOG_INFO(MQTT, "Attempting to connect to IO...");
 #ifdef USE_DISPLAY
       if (WS._ui_helper->getLoadingState())
         WS._ui_helper->set_label_status("Connecting to IO...");
 #endif
-      WS._mqtt->setKeepAliveInterval(WS_KEEPALIVE_INTERVAL_MS / 1000);
+      WS._mqtt->setKeepAliveInterval(_keepAliveInterval / 1000);
+      setupTLSBuffers();
       // Attempt to connect
       maxAttempts = 5;
       while (maxAttempts > 0) {
         statusLEDBlink(WS_LED_STATUS_MQTT_CONNECTING);
         int8_t mqttRC = WS._mqtt->connect();
         if (mqttRC == WS_MQTT_CONNECTED) {
+          // CONNECT/CONNACK counts as link activity
+          _prvPacketSent = millis();
+          _prvPacketRecv = _prvPacketSent;
           fsmNetwork = FSM_NET_CHECK_MQTT;
           break;
         }
-        WS_DEBUG_PRINTLN(
+        WS_LOG_WARN(
+            MQTT,
             "Unable to connect to Adafruit IO MQTT, retrying in 3 seconds...");
         statusLEDBlink(WS_LED_STATUS_MQTT_CONNECTING);
-        delay(1800);
+        statusLEDWait(3000);
         maxAttempts--;
       }
       if (fsmNetwork != FSM_NET_CHECK_MQTT) {
@@ -2277,8 +2417,17 @@ void Wippersnapper::runNetFSM() {
 */
 /**************************************************************************/
 void Wippersnapper::haltError(String error, ws_led_status_t ledStatusColor) {
+#if defined(WS_DEBUG) && defined(WS_DEBUG_TOKENIZED)
+  // write out what led up to the error before it
+  WS._log->flush();
+#endif
+#ifdef WS_TRACE
+  WS._trace->flush();
+#endif
   WS_DEBUG_PRINT("ERROR [WDT RESET]: ");
   WS_DEBUG_PRINTLN(error);
+  // a leak or fragmentation is a likely cause, report it while we still can
+  WS._memStats->report(true);
   for (;;) {
     // let the WDT fail out and reset!
     statusLEDSolid(ledStatusColor);
@@ -2326,23 +2475,35 @@ ws_board_status_t Wippersnapper::getBoardStatus() { return WS._boardStatus; }
 
 /**************************************************************************/
 /*!
-    @brief  Pings the MQTT broker within the keepalive interval
-            to keep the connection alive. Blinks the keepalive LED
+    @brief  Pings the MQTT broker if the connection has been idle for
+            the keepalive interval. Packets published to, or
+            acknowledged by, the broker count as link activity so a
+            busy connection is never pinged. Blinks the keepalive LED
             every STATUS_LED_KAT_BLINK_TIME milliseconds.
 */
 /**************************************************************************/
 void Wippersnapper::pingBroker() {
   // ping within keepalive-10% to keep connection open
-  if (millis() > (_prv_ping + (WS_KEEPALIVE_INTERVAL_MS -
-                               (WS_KEEPALIVE_INTERVAL_MS * 0.10)))) {
-    WS_DEBUG_PRINTLN("PING!");
-    // TODO: Add back, is crashing currently
-    WS._mqtt->ping();
-    _prv_ping = millis();
+  uint32_t idleTimeout = _keepAliveInterval - (_keepAliveInterval / 10);
+  uint32_t curTime = millis();
+  if (curTime - _prvPacketSent > idleTimeout ||
+      curTime - _prvPacketRecv > idleTimeout) {
+    WS_LOG_DEBUG(MQTT, "PING!");
+    _prvPacketSent = millis();
+    if (mqttClient() != nullptr) {
+      // the library's ping() drops the publish window's PUBACKs while it
+      // waits, the PINGRESP is read by processPackets() instead
+      if (!_mqttWindow->ping(mqttClient()))
+        WS_LOG_ERROR(MQTT, "ERROR: No PINGRESP from broker!");
+    } else if (WS._mqtt->ping()) {
+      _prvPacketRecv = millis();
+    } else {
+      WS_LOG_ERROR(MQTT, "ERROR: No PINGRESP from broker!");
+    }
   }
   // blink status LED every STATUS_LED_KAT_BLINK_TIME millis
   if (millis() > (_prvKATBlink + STATUS_LED_KAT_BLINK_TIME)) {
-    WS_DEBUG_PRINTLN("STATUS LED BLINK KAT");
+    WS_LOG_DEBUG(MQTT, "STATUS LED BLINK KAT");
 #ifdef USE_DISPLAY
     WS._ui_helper->add_text_to_terminal("[NET] Sent KeepAlive ping!\n");
 #endif
@@ -2351,6 +2512,26 @@ void Wippersnapper::pingBroker() {
   }
 }
 
+/********************************************************/
+/*!
+    @brief    Sets the MQTT keepalive interval. Takes effect the
+              next time the device connects to the broker.
+    @param    intervalMs
+              Keepalive interval, in milliseconds.
+*/
+/*******************************************************/
+void Wippersnapper::setKeepAliveInterval(uint32_t intervalMs) {
+  _keepAliveInterval = intervalMs;
+}
+
+/********************************************************/
+/*!
+    @brief    Returns the MQTT keepalive interval.
+    @returns  Keepalive interval, in milliseconds.
+*/
+/*******************************************************/
+uint32_t Wippersnapper::getKeepAliveInterval() { return _keepAliveInterval; }
+
 /********************************************************/
 /*!
     @brief    Feeds the WDT to prevent hardware reset.
@@ -2379,19 +2560,160 @@ void Wippersnapper::enableWDT(int timeoutMS) {
   }
 }
 
+#if !defined(ARDUINO_ARCH_ESP32) && !defined(ARDUINO_ARCH_ESP8266) &&        \
+    !defined(ARDUINO_ARCH_RP2040)
+extern "C" char *sbrk(int incr);
+#endif
+
+/********************************************************/
+/*!
+    @brief  Returns the amount of free heap memory.
+    @returns Free heap, in bytes.
+*/
+/*******************************************************/
+uint32_t Wippersnapper::getFreeHeap() {
+#if defined(ARDUINO_ARCH_ESP32) || defined(ARDUINO_ARCH_ESP8266)
+  return ESP.getFreeHeap();
+#elif defined(ARDUINO_ARCH_RP2040)
+  return rp2040.getFreeHeap();
+#else
+  // SAMD, space between the top of the heap and the stack
+  char top;
+  return (uint32_t)(&top - sbrk(0));
+#endif
+}
+
+/********************************************************/
+/*!
+    @brief  Returns the size of the largest contiguous
+            block of free heap memory.
+    @returns Largest free block, in bytes.
+*/
+/*******************************************************/
+uint32_t Wippersnapper::getLargestFreeBlock() {
+#if defined(ARDUINO_ARCH_ESP32)
+  return ESP.getMaxAllocHeap();
+#elif defined(ARDUINO_ARCH_ESP8266)
+  return ESP.getMaxFreeBlockSize();
+#else
+  // Not reported by this platform's allocator, the gap between
+  // the heap and stack is the largest block which can be grown into
+  return getFreeHeap();
+#endif
+}
+
+/********************************************************/
+/*!
+    @brief  Prints the free heap and largest free block,
+            used to track heap fragmentation.
+*/
+/*******************************************************/
+void Wippersnapper::printHeapStats() {
+  WS_DEBUG_PRINT("Free Heap: ");
+  WS_DEBUG_PRINT(getFreeHeap());
+  WS_DEBUG_PRINT("\tLargest Free Block: ");
+  WS_DEBUG_PRINTLN(getLargestFreeBlock());
+}
+
+/********************************************************/
+/*!
+    @brief  Returns this device's phase within a sampling
+            period, derived from the device's UID. Devices
+            configured with the same period at the same time
+            then publish spread across the period, instead
+            of all at once.
+    @returns Phase, as a fraction of the period in 1/65536ths.
+*/
+/*******************************************************/
+uint16_t Wippersnapper::getPublishPhase() {
+  if (_device_uid == NULL)
+    return 0;
+  // FNV-1a
+  uint32_t hash = 2166136261UL;
+  for (const char *c = _device_uid; *c != '\0'; c++) {
+    hash ^= (uint8_t)*c;
+    hash *= 16777619UL;
+  }
+  return (uint16_t)(hash ^ (hash >> 16));
+}
+
+/********************************************************/
+/*!
+    @brief  Returns the delay before the first reading of
+            a periodic input, see getPublishPhase().
+    @param  period
+            The input's sampling period, in milliseconds.
+    @returns Delay before the first reading, in milliseconds.
+*/
+/*******************************************************/
+long Wippersnapper::getPublishOffset(long period) {
+  if (period <= 0)
+    return 0;
+  return (long)(((uint64_t)period * getPublishPhase()) >> 16);
+}
+
 /********************************************************/
 /*!
     @brief  Process all incoming packets from the
             Adafruit IO MQTT broker. Handles network
             connectivity.
+
+            If the network interface can poll its socket, every
+            packet already waiting (up to WS_MQTT_MAX_PACKETS_PER_POLL)
+            is handled and this returns immediately once the socket
+            is empty. Otherwise, falls back to a blocking read.
 */
 /*******************************************************/
 void Wippersnapper::processPackets() {
   // runNetFSM(); // NOTE: Removed for now, causes error with virtual _connect
   // method when caused with WS object in another file.
   WS.feedWDT();
-  // Process all incoming packets from Wippersnapper MQTT Broker
-  WS._mqtt->processPackets(10);
+  if (mqttAvailable() < 0) {
+    // Process all incoming packets from Wippersnapper MQTT Broker, a
+    // packet's arrival can't be seen so commands are timed from the poll
+    WS._latency->markReceived();
+    WS._mqtt->processPackets(WS_MQTT_POLL_TIMEOUT_MS);
+    WS._latency->endPacket();
+    return;
+  }
+
+  for (int i = 0; i < WS_MQTT_MAX_PACKETS_PER_POLL && mqttAvailable() > 0;
+       i++) {
+    // the library drops PUBACKs it is not waiting for
+    if (_mqttWindow->handleAck(mqttClient())) {
+      _prvPacketRecv = millis();
+      continue;
+    }
+    // data is waiting, allow time for the rest of the packet to arrive
+    WS._latency->markReceived();
+    Adafruit_MQTT_Subscribe *sub =
+        WS._mqtt->readSubscription(WS_MQTT_READ_TIMEOUT_MS);
+    _prvPacketRecv = millis();
+    if (sub != nullptr && sub->callback_buffer != nullptr)
+      sub->callback_buffer((char *)sub->lastread, sub->datalen);
+    WS._latency->endPacket();
+  }
+}
+
+/********************************************************/
+/*!
+    @brief  Waits for packets from the Adafruit IO MQTT
+            broker and processes them. Unlike the
+            Adafruit_MQTT library's processPackets(), keeps
+            the PUBACKs of the QoS 1 publish window.
+    @param  timeoutMs
+            Time to wait for a packet, in milliseconds.
+*/
+/*******************************************************/
+void Wippersnapper::pollPackets(uint16_t timeoutMs) {
+  if (mqttAvailable() < 0) {
+    WS._mqtt->processPackets(timeoutMs);
+    return;
+  }
+  uint32_t startTime = millis();
+  while (mqttAvailable() == 0 && millis() - startTime < timeoutMs)
+    yield();
+  processPackets();
 }
 
 /********************************************************/
@@ -2406,14 +2728,43 @@ void Wippersnapper::processPackets() {
             The length of the payload.
     @param  qos
             The Quality of Service to publish with.
+    @param  priority
+            Low-priority publishes are refused first when the data rate
+            budget runs low.
+    @returns True if the message was published, False otherwise. A QoS 1
+             message may still be awaiting its PUBACK, or be queued for a
+             free slot of the publish window.
 */
 /*******************************************************/
-void Wippersnapper::publish(const char *topic, uint8_t *payload, uint16_t bLen,
-                            uint8_t qos) {
+bool Wippersnapper::publish(const char *topic, uint8_t *payload, uint16_t bLen,
+                            uint8_t qos, ws_publish_priority_t priority) {
+  WS_TRACE_SCOPE(WS_TRACE_EVENT_PUBLISH);
   // runNetFSM(); // NOTE: Removed for now, causes error with virtual _connect
   // method when caused with WS object in another file.
   WS.feedWDT();
-  WS._mqtt->publish(topic, payload, bLen, qos);
+  // held back until the broker re-sends the configuration which produced it
+  if (WS._warmStart->capture(topic, payload, bLen, qos))
+    return true;
+  // stay under the account's data rate rather than getting throttled
+  if (!_mqttBudget->consume(priority))
+    return false;
+  // pipeline QoS 1 publishes, queued without blocking while every slot
+  // of the window awaits a PUBACK
+  if (qos == MQTT_QOS_1 && mqttClient() != nullptr) {
+    if (!WS._mqtt->connected() ||
+        !_mqttWindow->publish(mqttClient(), topic, payload, bLen))
+      return false;
+    _prvPacketSent = millis();
+    return true;
+  }
+  if (!WS._mqtt->publish(topic, payload, bLen, qos))
+    return false;
+  // any control packet resets the broker's keepalive timer, a PUBACK
+  // also tells us the broker is still there
+  _prvPacketSent = millis();
+  if (qos > 0)
+    _prvPacketRecv = _prvPacketSent;
+  return true;
 }
 
 /**************************************************************/
@@ -2522,14 +2873,17 @@ void Wippersnapper::connect() {
 
   // enable global WDT
   WS.enableWDT(WS_WDT_TIMEOUT);
+  WS._bootTime->mark(WS_BOOT_STAGE_INFO);
 
   // Generate device identifier
   if (!generateDeviceUID()) {
     haltError("Unable to generate Device UID");
   }
+  WS._bootTime->mark(WS_BOOT_STAGE_UID);
 
   // Initialize MQTT client with device identifer
   setupMQTTClient(_device_uid);
+  WS._bootTime->mark(WS_BOOT_STAGE_MQTT);
 
   WS_DEBUG_PRINTLN("Generating device's MQTT topics...");
   if (!generateWSTopics()) {
@@ -2539,12 +2893,19 @@ void Wippersnapper::connect() {
   if (!generateWSErrorTopics()) {
     haltError("Unable to allocate space for MQTT error topics");
   }
+  WS._bootTime->mark(WS_BOOT_STAGE_TOPICS);
+
+  // Apply the last hardware configuration while the network connects
+  WS._warmStart->restore(cbWarmStartMsg, cbWarmStartUndoMsg);
+  WS.feedWDT();
+  WS._bootTime->mark(WS_BOOT_STAGE_WARMSTART);
 
   // Connect to Network
   WS_DEBUG_PRINTLN("Running Network FSM...");
   // Run the network fsm
   runNetFSM();
   WS.feedWDT();
+  WS._bootTime->mark(WS_BOOT_STAGE_NETWORK);
 
 #ifdef USE_DISPLAY
   WS._ui_helper->set_load_bar_icon_complete(loadBarIconCloud);
@@ -2558,13 +2919,15 @@ void Wippersnapper::connect() {
   }
   runNetFSM();
   WS.feedWDT();
+  WS._bootTime->mark(WS_BOOT_STAGE_REGISTER);
 
 // switch to monitor screen
 #ifdef USE_DISPLAY
-  WS_DEBUG_PRINTLN("Clearing loading screen...");
+  WS_LOG_INFO(DISPLAY, "Clearing loading screen...");
   WS._ui_helper->clear_scr_load();
-  WS_DEBUG_PRINTLN("building monitor screen...");
+  WS_LOG_INFO(DISPLAY, "building monitor screen...");
   WS._ui_helper->build_scr_monitor();
+  WS._bootTime->mark(WS_BOOT_STAGE_UI);
 #endif
 
   // Configure hardware
@@ -2572,13 +2935,18 @@ void Wippersnapper::connect() {
   while (!WS.pinCfgCompleted) {
     WS_DEBUG_PRINTLN(
         "Polling for message containing hardware configuration...");
-    WS._mqtt->processPackets(10); // poll
+    pollPackets(10); // poll
   }
+  WS._bootTime->mark(WS_BOOT_STAGE_CONFIG);
   // Publish that we have completed the configuration workflow
   WS.feedWDT();
   runNetFSM();
   publishPinConfigComplete();
+  // tear down what was restored from the snapshot but not re-sent
+  WS._warmStart->finish();
+  WS._bootTime->mark(WS_BOOT_STAGE_ACK);
   WS_DEBUG_PRINTLN("Hardware configured successfully!");
+  WS._bootTime->report();
 
   statusLEDFade(GREEN, 3);
   WS_DEBUG_PRINTLN(
@@ -2626,30 +2994,57 @@ void Wippersnapper::publishPinConfigComplete() {
 */
 /**************************************************************************/
 ws_status_t Wippersnapper::run() {
+  WS_LOOP_BEGIN();
   // Check networking
   runNetFSM();
   WS.feedWDT();
+  WS_LOOP_STAGE(WS_LOOP_STAGE_NET);
   pingBroker();
+  statusLEDTick();
+  WS_LOOP_STAGE(WS_LOOP_STAGE_PING);
 
   // Process all incoming packets from Wippersnapper MQTT Broker
-  WS._mqtt->processPackets(10);
+  processPackets();
   WS.feedWDT();
+  WS._mqttWindow->retransmit(mqttClient());
+  WS._mqttWindow->sendQueued(mqttClient());
+  WS_LOOP_STAGE(WS_LOOP_STAGE_PACKETS);
 
   // Process digital inputs, digitalGPIO module
   WS._digitalGPIO->processDigitalInputs();
   WS.feedWDT();
+  WS_LOOP_STAGE(WS_LOOP_STAGE_DIGITAL);
 
   // Process analog inputs
   WS._analogIO->update();
   WS.feedWDT();
+  WS_LOOP_STAGE(WS_LOOP_STAGE_ANALOG);
 
-  // Process I2C sensor events
+  // Process I2C sensor events, on each port
   if (WS._isI2CPort0Init)
     WS._i2cPort0->update();
+  if (WS._isI2CPort1Init)
+    WS._i2cPort1->update();
   WS.feedWDT();
+  WS_LOOP_STAGE(WS_LOOP_STAGE_I2C);
 
   // Process DS18x20 sensor events
   WS._ds18x20Component->update();
+  WS_LOOP_STAGE(WS_LOOP_STAGE_DS18X20);
+  WS_LOOP_END();
+
+  // Track memory usage and command latency
+  WS._memStats->update();
+  WS._latency->update();
+
+#if defined(WS_DEBUG) && defined(WS_DEBUG_TOKENIZED)
+  // Write out debug log records the serial port can take
+  WS._log->drain();
+#endif
+#ifdef WS_TRACE
+  // Write out trace records the serial port can take
+  WS._trace->drain();
+#endif
 
   return WS_NET_CONNECTED; // TODO: Make this funcn void!
 }
\ No newline at end of file
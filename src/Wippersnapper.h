@@ -30,6 +30,22 @@
 #include <wippersnapper/description/v1/description.pb.h> // description.proto
 #include <wippersnapper/signal/v1/signal.pb.h>           // signal.proto
 
+/** Priority of a publish, when the data rate budget runs low */
+typedef enum {
+  WS_PUBLISH_PRIORITY_HIGH, ///< On-change events and command responses
+  WS_PUBLISH_PRIORITY_LOW,  ///< Periodic sensor readings, may be deferred
+} ws_publish_priority_t;
+
+// Uncomment, or add -DWS_PROFILER to the build flags, to profile the
+// stages of the run() loop. Must be defined before the components below.
+// #define WS_PROFILER
+// Uncomment, or add -DWS_TRACE to the build flags, to stream timed spans of
+// the firmware's execution over the serial port, for tools/trace.
+// #define WS_TRACE
+// Uncomment to publish the latency of every actuator command as it is
+// handled, rather than only the periodic summary.
+// #define WS_LATENCY_ECHO
+
 // Wippersnapper API Helpers
 #include "Wippersnapper_Boards.h"
 #include "components/statusLED/Wippersnapper_StatusLED.h"
@@ -54,6 +70,15 @@
 #include "components/pixels/ws_pixels.h"
 #include "components/pwm/ws_pwm.h"
 #include "components/servo/ws_servo.h"
+#include "components/warmstart/ws_warmstart.h"
+#include "components/mqtt/ws_mqtt_budget.h"
+#include "components/mqtt/ws_mqtt_window.h"
+#include "components/diagnostics/ws_boottime.h"
+#include "components/diagnostics/ws_latency.h"
+#include "components/diagnostics/ws_loop_stages.h"
+#include "components/diagnostics/ws_memstats.h"
+#include "components/diagnostics/ws_profiler.h"
+#include "components/diagnostics/ws_trace.h"
 
 // External libraries
 #include "Adafruit_MQTT.h" // MQTT Client
@@ -107,6 +132,10 @@
 #define TOPIC_INFO "/info/"       ///< Registration sub-topic
 #define TOPIC_SIGNALS "/signals/" ///< Signals sub-topic
 #define TOPIC_I2C "/i2c"          ///< I2C sub-topic
+#define TOPIC_DIAGNOSTICS                                                      \
+  "/diagnostics" ///< Device->broker diagnostics sub-topic
+#define TOPIC_LOG_LEVELS                                                       \
+  "/diagnostics/log" ///< Broker->device log level sub-topic
 #define MQTT_TOPIC_PIXELS_DEVICE                                               \
   "/signals/device/pixel" ///< Pixels device->broker topic
 #define MQTT_TOPIC_PIXELS_BROKER                                               \
@@ -114,6 +143,9 @@
 
 #define WS_DEBUG          ///< Define to enable debugging to serial terminal
 #define WS_PRINTER Serial ///< Where debug messages will be printed
+// Uncomment, or add -DWS_DEBUG_TOKENIZED to the build flags, to write
+// WS_LOG() messages as binary tokens, see tools/log_decoder
+// #define WS_DEBUG_TOKENIZED
 
 // Define actual debug output functions when necessary.
 #ifdef WS_DEBUG
@@ -130,6 +162,8 @@
   {} ///< Prints line from debug output.
 #endif
 
+#include "components/diagnostics/ws_log.h"
+
 /** Defines the Adafruit IO connection status */
 typedef enum {
   WS_IDLE = 0,               // Waiting for connection establishement
@@ -187,12 +221,36 @@ typedef enum {
 } fsm_net_t;
 
 #define WS_WDT_TIMEOUT 60000 ///< WDT timeout
+#define WS_NET_CONNECT_GRACE_MS                                                \
+  1200 ///< Time allowed for a WiFi connection attempt to complete, in ms
+#define WS_NET_FAST_CONNECT_TIMEOUT_MS                                         \
+  3000 ///< Time allowed to rejoin the last access point, in ms
+#define WS_NET_CACHE_MAGIC 0x57534e43 ///< Marks a valid ws_net_cache_t
+
+/** Access point of the last successful WiFi connection */
+typedef struct {
+  uint32_t magic;   ///< WS_NET_CACHE_MAGIC if the cache is valid
+  int32_t channel;  ///< Access point's WiFi channel
+  uint8_t bssid[6]; ///< Access point's BSSID
+  char ssid[34];    ///< Network's SSID
+} ws_net_cache_t;
+
 /* MQTT Configuration */
+#ifndef WS_KEEPALIVE_INTERVAL_MS
 #define WS_KEEPALIVE_INTERVAL_MS                                               \
-  5000 ///< Session keepalive interval time, in milliseconds
+  5000 ///< Default session keepalive interval time, in milliseconds
+#endif
+#define WS_THROTTLE_INTERVAL_MS                                                \
+  5000 ///< Time between pings while throttled by the broker, in milliseconds
 
 #define WS_MQTT_MAX_PAYLOAD_SIZE                                               \
   512 ///< MAXIMUM expected payload size, in bytes
+#define WS_MQTT_POLL_TIMEOUT_MS                                                \
+  10 ///< Blocking read timeout, if the MQTT socket can't be polled, in ms
+#define WS_MQTT_READ_TIMEOUT_MS                                                \
+  10 ///< Time allowed to finish reading a partially received packet, in ms
+#define WS_MQTT_MAX_PACKETS_PER_POLL                                           \
+  8 ///< Maximum number of packets handled by each processPackets() call
 
 class Wippersnapper_DigitalGPIO;
 class Wippersnapper_AnalogIO;
@@ -210,6 +268,22 @@ class ws_servo;
 class ws_pwm;
 class ws_ds18x20;
 class ws_pixels;
+class ws_warmstart;
+class ws_mqtt_budget;
+class ws_mqtt_window;
+class ws_memstats;
+class ws_latency;
+class ws_boottime;
+class ws_log;
+#if defined(WS_PROFILER) || defined(WS_TRACE)
+class ws_loop_stages;
+#endif
+#ifdef WS_PROFILER
+class ws_profiler;
+#endif
+#ifdef WS_TRACE
+class ws_trace;
+#endif
 
 /**************************************************************************/
 /*!
@@ -235,6 +309,9 @@ public:
   virtual void set_ssid_pass(const char *ssid, const char *ssidPassword);
   virtual void set_ssid_pass();
   virtual bool check_valid_ssid();
+  virtual bool fastConnect();
+  virtual void cacheNetwork();
+  virtual void setupTLSBuffers();
 
   virtual void _connect();
   virtual void _disconnect();
@@ -245,6 +322,8 @@ public:
   virtual void setupMQTTClient(const char *clientID);
 
   virtual ws_status_t networkStatus();
+  virtual int mqttAvailable();
+  virtual Client *mqttClient();
   ws_board_status_t getBoardStatus();
 
   bool generateDeviceUID();
@@ -262,17 +341,29 @@ public:
   // run() loop
   ws_status_t run();
   void processPackets();
-  void publish(const char *topic, uint8_t *payload, uint16_t bLen,
-               uint8_t qos = 0);
+  void pollPackets(uint16_t timeoutMs);
+  bool publish(const char *topic, uint8_t *payload, uint16_t bLen,
+               uint8_t qos = 0,
+               ws_publish_priority_t priority = WS_PUBLISH_PRIORITY_HIGH);
 
   // Networking helpers
   void pingBroker();
+  void setKeepAliveInterval(uint32_t intervalMs);
+  uint32_t getKeepAliveInterval();
   void runNetFSM();
 
   // WDT helpers
   void enableWDT(int timeoutMS = 0);
   void feedWDT();
 
+  // Memory helpers
+  uint32_t getFreeHeap();
+  uint32_t getLargestFreeBlock();
+  void printHeapStats();
+
+  uint16_t getPublishPhase();
+  long getPublishOffset(long period);
+
   // Error handling helpers
   void haltError(String error,
                  ws_led_status_t ledStatusColor = WS_LED_STATUS_ERROR_RUNTIME);
@@ -330,6 +421,24 @@ public:
   ws_pwm *_pwmComponent;          ///< Instance of pwm class
   ws_servo *_servoComponent;      ///< Instance of servo class
   ws_ds18x20 *_ds18x20Component;  ///< Instance of DS18x20 class
+  ws_warmstart *_warmStart;       ///< Hardware configuration snapshot
+  ws_mqtt_window *_mqttWindow;    ///< QoS 1 publishes awaiting a PUBACK
+  ws_mqtt_budget *_mqttBudget;    ///< Data rate budget for publishes
+  ws_memstats *_memStats;         ///< Heap, stack and PSRAM usage
+  ws_latency *_latency;           ///< Actuator command latency tracing
+  ws_boottime *_bootTime;         ///< Boot stage timing
+#if defined(WS_PROFILER) || defined(WS_TRACE)
+  ws_loop_stages *_loopStages; ///< Main loop stage timing
+#endif
+#ifdef WS_PROFILER
+  ws_profiler *_profiler; ///< Main loop stage profiler
+#endif
+#ifdef WS_TRACE
+  ws_trace *_trace; ///< Execution tracer
+#endif
+#if defined(WS_DEBUG) && defined(WS_DEBUG_TOKENIZED)
+  ws_log *_log; ///< Tokenized debug log
+#endif
 
   // TODO: does this really need to be global?
   uint8_t _macAddr[6];  /*!< Unique network iface identifier */
@@ -371,6 +480,8 @@ public:
                                        from a broker to a device. */
   char *_topic_signal_pixels_brkr = NULL;   /*!< Topic carries pixel messages */
   char *_topic_signal_pixels_device = NULL; /*!< Topic carries pixel messages */
+  char *_topic_diagnostics = NULL;          /*!< Topic carries diagnostics */
+  char *_topic_log_levels = NULL; /*!< Topic carries log level commands */
 
   wippersnapper_signal_v1_CreateSignalRequest
       _incomingSignalMsg; /*!< Incoming signal message from broker */
@@ -412,14 +523,18 @@ protected:
   ws_status_t _status = WS_IDLE;   /*!< Adafruit IO connection status */
   uint32_t _last_mqtt_connect = 0; /*!< Previous time when client connected to
                                           Adafruit IO, in milliseconds. */
-  uint32_t _prv_ping = 0;    /*!< Previous time when client pinged Adafruit IO's
-                                MQTT broker, in milliseconds. */
+  uint32_t _prvPacketSent = 0; /*!< Previous time a packet was sent to Adafruit
+                                  IO's MQTT broker, in milliseconds. */
+  uint32_t _prvPacketRecv = 0; /*!< Previous time a packet was received from
+                                  Adafruit IO's MQTT broker, in milliseconds. */
+  uint32_t _keepAliveInterval =
+      WS_KEEPALIVE_INTERVAL_MS; /*!< MQTT keepalive interval, in milliseconds. */
   uint32_t _prvKATBlink = 0; /*!< Previous time when client pinged Adafruit IO's
                              MQTT broker, in milliseconds. */
 
   // Device information
   const char *_deviceId; /*!< Adafruit IO+ device identifier string */
-  char *_device_uid;     /*!< Unique device identifier  */
+  char *_device_uid = NULL; /*!< Unique device identifier  */
 
   // MQTT topics
   char *_topic_description_status =
@@ -435,6 +550,7 @@ protected:
   char *_topic_signal_brkr = NULL; /*!< Wprsnpr->Device messages */
   char *_err_topic = NULL;         /*!< Adafruit IO MQTT error message topic. */
   char *_throttle_topic = NULL; /*!< Adafruit IO MQTT throttle message topic. */
+  char *_topicArena = NULL; /*!< Storage for all of the MQTT topics above. */
 
   Adafruit_MQTT_Subscribe *_topic_description_sub; /*!< Subscription callback
                                                       for registration topic. */
@@ -452,6 +568,10 @@ protected:
       *_topic_signal_ds18_sub; /*!< Subscribes to signal's ds18x20 topic. */
   Adafruit_MQTT_Subscribe
       *_topic_signal_pixels_sub; /*!< Subscribes to pixel device topic. */
+#ifdef WS_DEBUG
+  Adafruit_MQTT_Subscribe
+      *_topic_log_levels_sub; /*!< Subscribes to log level topic. */
+#endif
 
   Adafruit_MQTT_Subscribe
       *_err_sub; /*!< Subscription to Adafruit IO Error topic. */
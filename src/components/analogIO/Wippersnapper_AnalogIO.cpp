@@ -145,6 +145,9 @@ void Wippersnapper_AnalogIO::initAnalogInputPin(
     if (_analog_input_pins[i].enabled == false) {
       _analog_input_pins[i].pinName = pin;
       _analog_input_pins[i].period = periodMs;
+      // stagger the first reading, see getPublishPhase()
+      _analog_input_pins[i].prvPeriod =
+          millis() - periodMs + WS.getPublishOffset(periodMs);
       _analog_input_pins[i].readMode = analogReadMode;
       _analog_input_pins[i].enabled = true;
       break;
@@ -243,6 +246,8 @@ float Wippersnapper_AnalogIO::getPinValueVolts(int pin) {
     @param    pinValVolts
               Raw pin value expressed in Volts, used if readmode is
               volts.
+    @param    priority
+              Priority of the publish, periodic readings are low priority.
     @returns  True if successfully encoded a PinEvent signal
                 message, False otherwise.
 */
@@ -250,7 +255,7 @@ float Wippersnapper_AnalogIO::getPinValueVolts(int pin) {
 bool Wippersnapper_AnalogIO::encodePinEvent(
     uint8_t pinName,
     wippersnapper_pin_v1_ConfigurePinRequest_AnalogReadMode readMode,
-    uint16_t pinValRaw, float pinValVolts) {
+    uint16_t pinValRaw, float pinValVolts, ws_publish_priority_t priority) {
   // Create new signal message
   wippersnapper_signal_v1_CreateSignalRequest outgoingSignalMsg =
       wippersnapper_signal_v1_CreateSignalRequest_init_zero;
@@ -290,9 +295,9 @@ bool Wippersnapper_AnalogIO::encodePinEvent(
   pb_get_encoded_size(&msgSz,
                       wippersnapper_signal_v1_CreateSignalRequest_fields,
                       &outgoingSignalMsg);
-  WS_DEBUG_PRINT("Publishing pinEvent...");
-  WS.publish(WS._topic_signal_device, WS._buffer_outgoing, msgSz, 1);
-  WS_DEBUG_PRINTLN("Published!");
+  WS.publish(WS._topic_signal_device, WS._buffer_outgoing, msgSz, 1,
+             priority);
+  WS_LOG_DEBUG(ANALOG, "Published pinEvent on A%u", pinName);
 
   return true;
 }
@@ -332,8 +337,11 @@ void Wippersnapper_AnalogIO::update() {
       if (millis() - _analog_input_pins[i].prvPeriod >
               _analog_input_pins[i].period &&
           _analog_input_pins[i].period != 0L) {
-        WS_DEBUG_PRINT("Executing periodic event on A");
-        WS_DEBUG_PRINTLN(_analog_input_pins[i].pinName);
+        // hold the reading until the publish budget allows it
+        if (!WS._mqttBudget->isAvailable(WS_PUBLISH_PRIORITY_LOW))
+          continue;
+        WS_LOG_DEBUG(ANALOG, "Executing periodic event on A%d",
+                     _analog_input_pins[i].pinName);
 
         // Read from analog pin
         if (_analog_input_pins[i].readMode ==
@@ -351,7 +359,8 @@ void Wippersnapper_AnalogIO::update() {
 
         // Publish a new pin event
         encodePinEvent(_analog_input_pins[i].pinName,
-                       _analog_input_pins[i].readMode, pinValRaw, pinValVolts);
+                       _analog_input_pins[i].readMode, pinValRaw, pinValVolts,
+                       WS_PUBLISH_PRIORITY_LOW);
 
         // IMPT - reset the digital pin
         _analog_input_pins[i].prvPeriod = millis();
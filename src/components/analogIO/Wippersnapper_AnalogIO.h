@@ -69,7 +69,8 @@ public:
   bool encodePinEvent(
       uint8_t pinName,
       wippersnapper_pin_v1_ConfigurePinRequest_AnalogReadMode readMode,
-      uint16_t pinValRaw = 0, float pinValVolts = 0.0);
+      uint16_t pinValRaw = 0, float pinValVolts = 0.0,
+      ws_publish_priority_t priority = WS_PUBLISH_PRIORITY_HIGH);
 
 private:
   float _aRef;           /*!< Hardware's reported voltage reference */
@@ -0,0 +1,90 @@
+/*!
+ * @file ws_boottime.cpp
+ *
+ * Times each stage of the device's boot, from reset until the hardware
+ * is configured, and publishes the timings to the device's diagnostics
+ * topic.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * Copyright (c) Brent Rubell 2023 for Adafruit Industries.
+ *
+ * MIT license, all text here must be included in any redistribution.
+ *
+ */
+#include "ws_boottime.h"
+
+/** Names of the stages, as reported */
+static const char *stageNames[WS_BOOT_STAGE_COUNT] = {
+    // provision()
+    "core", "led", "fs", "display", "secrets",
+    // connect()
+    "info", "uid", "mqtt", "topics", "warmstart", "network", "register", "ui",
+    "config", "ack"};
+
+/**************************************************************************/
+/*!
+    @brief    Creates the boot stage timer.
+*/
+/**************************************************************************/
+ws_boottime::ws_boottime() { memset(_durations, 0, sizeof(_durations)); }
+
+/**************************************************************************/
+/*!
+    @brief    Destructor for the boot stage timer.
+*/
+/**************************************************************************/
+ws_boottime::~ws_boottime() {}
+
+/**************************************************************************/
+/*!
+    @brief    Marks the end of a boot stage.
+    @param    stage
+              The stage which just ended.
+*/
+/**************************************************************************/
+void ws_boottime::mark(ws_boot_stage_t stage) {
+  unsigned long curTime = millis();
+  _durations[stage] += curTime - _prvMark;
+  _marked |= 1UL << stage;
+  _prvMark = curTime;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Prints the boot stage timings, and publishes them to the
+              diagnostics topic as a JSON object, in milliseconds.
+*/
+/**************************************************************************/
+void ws_boottime::report() {
+  char msg[WS_MQTT_MAX_PAYLOAD_SIZE];
+  int len = snprintf(msg, sizeof(msg), "{\"boot\":%lu,\"stages\":{",
+                     (unsigned long)_prvMark);
+  bool isFirst = true;
+  for (uint8_t i = 0; i < WS_BOOT_STAGE_COUNT && len < (int)sizeof(msg);
+       i++) {
+    if (!(_marked & (1UL << i)))
+      continue;
+    len += snprintf(msg + len, sizeof(msg) - len, "%s\"%s\":%lu",
+                    isFirst ? "" : ",", stageNames[i],
+                    (unsigned long)_durations[i]);
+    isFirst = false;
+  }
+  if (len >= (int)sizeof(msg) - 2) {
+    WS_DEBUG_PRINTLN("ERROR: Boot report does not fit the payload!");
+    return;
+  }
+  msg[len++] = '}';
+  msg[len++] = '}';
+  msg[len] = '\0';
+
+  WS_DEBUG_PRINT("Boot report: ");
+  WS_DEBUG_PRINTLN(msg);
+  if (WS._topic_diagnostics == NULL)
+    return;
+  // sent once, right after registration spent the budget's burst
+  WS.publish(WS._topic_diagnostics, (uint8_t *)msg, len, 0,
+             WS_PUBLISH_PRIORITY_HIGH);
+}
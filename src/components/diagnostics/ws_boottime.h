@@ -0,0 +1,69 @@
+/*!
+ * @file ws_boottime.h
+ *
+ * Times each stage of the device's boot, from reset until the hardware
+ * is configured, and publishes the timings to the device's diagnostics
+ * topic.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * Copyright (c) Brent Rubell 2023 for Adafruit Industries.
+ *
+ * MIT license, all text here must be included in any redistribution.
+ *
+ */
+#ifndef WS_BOOTTIME_H
+#define WS_BOOTTIME_H
+
+#include "Wippersnapper.h"
+
+/** Stages of the boot, in the order they run */
+typedef enum {
+  WS_BOOT_STAGE_CORE,      ///< Reset until provision(), core and sketch init
+  WS_BOOT_STAGE_LED,       ///< MAC address and status LED
+  WS_BOOT_STAGE_FS,        ///< Filesystem mount
+  WS_BOOT_STAGE_DISPLAY,   ///< Display driver and loading screen
+  WS_BOOT_STAGE_SECRETS,   ///< secrets.json parsing
+  WS_BOOT_STAGE_INFO,      ///< Device info and the WDT
+  WS_BOOT_STAGE_UID,       ///< Device UID
+  WS_BOOT_STAGE_MQTT,      ///< MQTT client
+  WS_BOOT_STAGE_TOPICS,    ///< MQTT topics and subscriptions
+  WS_BOOT_STAGE_WARMSTART, ///< Restoring the last hardware configuration
+  WS_BOOT_STAGE_NETWORK,   ///< WiFi and MQTT connection
+  WS_BOOT_STAGE_REGISTER,  ///< Hardware registration
+  WS_BOOT_STAGE_UI,        ///< Switching to the display's monitor screen
+  WS_BOOT_STAGE_CONFIG,    ///< Waiting for the hardware configuration
+  WS_BOOT_STAGE_ACK,       ///< Acknowledging the hardware configuration
+  WS_BOOT_STAGE_COUNT,     ///< Number of stages
+} ws_boot_stage_t;
+
+class Wippersnapper;
+
+/**************************************************************************/
+/*!
+    @brief  Boot stage timing.
+
+            Each stage is marked as it ends, its duration is the time
+            since the previous stage ended. Stages which don't run on
+            a board, such as the display's, are left out of the report.
+*/
+/**************************************************************************/
+class ws_boottime {
+public:
+  ws_boottime();
+  ~ws_boottime();
+
+  void mark(ws_boot_stage_t stage);
+  void report();
+
+private:
+  uint32_t _durations[WS_BOOT_STAGE_COUNT]; ///< Time taken by each stage, ms
+
+  uint32_t _marked = 0;       ///< Bit n is set once stage n has been marked
+  unsigned long _prvMark = 0; ///< When the previous stage ended, in ms
+};
+extern Wippersnapper WS;
+
+#endif // WS_BOOTTIME_H
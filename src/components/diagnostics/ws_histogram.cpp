@@ -0,0 +1,139 @@
+/*!
+ * @file ws_histogram.cpp
+ *
+ * Fixed-size histogram of durations, used by the diagnostics components
+ * to report percentiles without keeping every sample.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * Copyright (c) Brent Rubell 2023 for Adafruit Industries.
+ *
+ * MIT license, all text here must be included in any redistribution.
+ *
+ */
+#include "ws_histogram.h"
+
+/**************************************************************************/
+/*!
+    @brief    Creates an empty histogram.
+*/
+/**************************************************************************/
+ws_histogram::ws_histogram() { reset(); }
+
+/**************************************************************************/
+/*!
+    @brief    Destructor for the histogram.
+*/
+/**************************************************************************/
+ws_histogram::~ws_histogram() {}
+
+/**************************************************************************/
+/*!
+    @brief    Adds a value to the histogram.
+    @param    value
+              The value, usually a duration in microseconds.
+*/
+/**************************************************************************/
+void ws_histogram::record(uint32_t value) {
+  _count++;
+  _total += value;
+  if (value < _min)
+    _min = value;
+  if (value > _max)
+    _max = value;
+  // bucket n holds [2^(n-1), 2^n), bucket 0 holds 0
+  uint8_t bucket = value == 0 ? 0 : 32 - __builtin_clz(value);
+  if (bucket >= WS_HISTOGRAM_BUCKETS)
+    bucket = WS_HISTOGRAM_BUCKETS - 1;
+  _buckets[bucket]++;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Empties the histogram.
+*/
+/**************************************************************************/
+void ws_histogram::reset() {
+  _count = 0;
+  _min = UINT32_MAX;
+  _max = 0;
+  _total = 0;
+  memset(_buckets, 0, sizeof(_buckets));
+}
+
+/**************************************************************************/
+/*!
+    @brief    Returns the number of values recorded.
+    @returns  Number of values.
+*/
+/**************************************************************************/
+uint32_t ws_histogram::getCount() { return _count; }
+
+/**************************************************************************/
+/*!
+    @brief    Returns the smallest value recorded.
+    @returns  Smallest value, or 0 if the histogram is empty.
+*/
+/**************************************************************************/
+uint32_t ws_histogram::getMin() { return _count > 0 ? _min : 0; }
+
+/**************************************************************************/
+/*!
+    @brief    Returns the largest value recorded.
+    @returns  Largest value.
+*/
+/**************************************************************************/
+uint32_t ws_histogram::getMax() { return _max; }
+
+/**************************************************************************/
+/*!
+    @brief    Returns the average of the values recorded.
+    @returns  Average value, or 0 if the histogram is empty.
+*/
+/**************************************************************************/
+uint32_t ws_histogram::getAverage() {
+  return _count > 0 ? (uint32_t)(_total / _count) : 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Estimates a percentile of the values recorded.
+    @param    pct
+              Percentile, from 0 to 100.
+    @returns  Upper bound of the bucket holding the percentile, capped
+              at the largest value.
+*/
+/**************************************************************************/
+uint32_t ws_histogram::getPercentile(uint8_t pct) {
+  // round up, so the percentile is never below the requested fraction
+  uint32_t rank = (uint32_t)(((uint64_t)_count * pct + 99) / 100);
+  uint32_t seen = 0;
+  for (uint8_t i = 0; i < WS_HISTOGRAM_BUCKETS - 1; i++) {
+    seen += _buckets[i];
+    if (seen >= rank && seen > 0) {
+      uint32_t upper = (1UL << i) - 1;
+      return upper < _max ? upper : _max;
+    }
+  }
+  // the last bucket also holds everything larger
+  return _max;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Prints the min/avg/max/p99 as a JSON array.
+    @param    buf
+              Buffer to print into.
+    @param    len
+              Size of the buffer.
+    @returns  Number of characters which would have been printed, as
+              snprintf().
+*/
+/**************************************************************************/
+int ws_histogram::print(char *buf, size_t len) {
+  return snprintf(buf, len, "[%lu,%lu,%lu,%lu]", (unsigned long)getMin(),
+                  (unsigned long)getAverage(), (unsigned long)getMax(),
+                  (unsigned long)getPercentile(99));
+}
@@ -0,0 +1,53 @@
+/*!
+ * @file ws_histogram.h
+ *
+ * Fixed-size histogram of durations, used by the diagnostics components
+ * to report percentiles without keeping every sample.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * Copyright (c) Brent Rubell 2023 for Adafruit Industries.
+ *
+ * MIT license, all text here must be included in any redistribution.
+ *
+ */
+#ifndef WS_HISTOGRAM_H
+#define WS_HISTOGRAM_H
+
+#include "Arduino.h"
+
+#define WS_HISTOGRAM_BUCKETS                                                   \
+  24 ///< Buckets, bucket n holds values below 2^n, the last holds the rest
+
+/**************************************************************************/
+/*!
+    @brief  Power-of-two histogram which also tracks the count, min, max
+            and total of the recorded values.
+*/
+/**************************************************************************/
+class ws_histogram {
+public:
+  ws_histogram();
+  ~ws_histogram();
+
+  void record(uint32_t value);
+  void reset();
+
+  uint32_t getCount();
+  uint32_t getMin();
+  uint32_t getMax();
+  uint32_t getAverage();
+  uint32_t getPercentile(uint8_t pct);
+  int print(char *buf, size_t len);
+
+private:
+  uint32_t _count;                         ///< Values recorded
+  uint32_t _min;                           ///< Smallest value
+  uint32_t _max;                           ///< Largest value
+  uint64_t _total;                         ///< Sum of the values
+  uint32_t _buckets[WS_HISTOGRAM_BUCKETS]; ///< Values per log2 bucket
+};
+
+#endif // WS_HISTOGRAM_H
@@ -0,0 +1,161 @@
+/*!
+ * @file ws_latency.cpp
+ *
+ * Traces the time taken from an actuator command's arrival to the pin
+ * write, and publishes it to the device's diagnostics topic.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * Copyright (c) Brent Rubell 2023 for Adafruit Industries.
+ *
+ * MIT license, all text here must be included in any redistribution.
+ *
+ */
+#include "ws_latency.h"
+
+/** Names of the commands, as reported */
+static const char *cmdNames[WS_LATENCY_CMD_COUNT] = {"digital", "servo", "pwm",
+                                                     "pixels"};
+
+/**************************************************************************/
+/*!
+    @brief    Creates a command latency tracer.
+*/
+/**************************************************************************/
+ws_latency::ws_latency() {}
+
+/**************************************************************************/
+/*!
+    @brief    Destructor for the command latency tracer.
+*/
+/**************************************************************************/
+ws_latency::~ws_latency() {}
+
+/**************************************************************************/
+/*!
+    @brief    Marks the arrival of a packet on the MQTT socket.
+*/
+/**************************************************************************/
+void ws_latency::markReceived() {
+  _receivedAt = micros();
+  _isTracing = true;
+  _isDecoded = false;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Marks the packet's command as decoded.
+*/
+/**************************************************************************/
+void ws_latency::markDecoded() {
+  if (!_isTracing)
+    return;
+  _decodedAt = micros();
+  _isDecoded = true;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Marks the command's pin write as done, and records the
+              command's latencies. Commands which did not arrive in a
+              packet, such as those restored on boot, are not traced.
+    @param    cmd
+              The command which was handled.
+*/
+/**************************************************************************/
+void ws_latency::markActuated(ws_latency_cmd_t cmd) {
+  if (!_isTracing)
+    return;
+  uint32_t actuate = micros() - _receivedAt;
+  uint32_t decode = _isDecoded ? _decodedAt - _receivedAt : 0;
+  if (_isDecoded)
+    _decode[cmd].record(decode);
+  _actuate[cmd].record(actuate);
+  // a packet may carry several writes, time the next from its own decode
+  _isDecoded = false;
+
+#ifdef WS_LATENCY_ECHO
+  char msg[64];
+  int len = snprintf(msg, sizeof(msg),
+                     "{\"cmd\":\"%s\",\"decode\":%lu,\"actuate\":%lu}",
+                     cmdNames[cmd], (unsigned long)decode,
+                     (unsigned long)actuate);
+  if (WS._topic_diagnostics != NULL && len < (int)sizeof(msg))
+    WS.publish(WS._topic_diagnostics, (uint8_t *)msg, len, 0,
+               WS_PUBLISH_PRIORITY_LOW);
+#endif
+}
+
+/**************************************************************************/
+/*!
+    @brief    Marks the end of the packet's handling.
+*/
+/**************************************************************************/
+void ws_latency::endPacket() { _isTracing = false; }
+
+/**************************************************************************/
+/*!
+    @brief    Reports the command latencies every WS_LATENCY_INTERVAL_MS,
+              if enabled and any commands were handled. Called from the
+              run() loop.
+*/
+/**************************************************************************/
+void ws_latency::update() {
+  if (WS_LATENCY_INTERVAL_MS == 0 ||
+      millis() - _prvReport < WS_LATENCY_INTERVAL_MS)
+    return;
+  report();
+  for (uint8_t i = 0; i < WS_LATENCY_CMD_COUNT; i++) {
+    _decode[i].reset();
+    _actuate[i].reset();
+  }
+  _prvReport = millis();
+}
+
+/**************************************************************************/
+/*!
+    @brief    Publishes, for each command handled, the number handled and
+              the min/avg/max/p99 of the decode and actuation latencies,
+              in microseconds, to the diagnostics topic.
+*/
+/**************************************************************************/
+void ws_latency::report() {
+  char msg[WS_MQTT_MAX_PAYLOAD_SIZE];
+  int len = snprintf(msg, sizeof(msg), "{\"latency\":{");
+  bool isEmpty = true;
+  for (uint8_t i = 0; i < WS_LATENCY_CMD_COUNT && len < (int)sizeof(msg);
+       i++) {
+    if (_actuate[i].getCount() == 0)
+      continue;
+    len += snprintf(msg + len, sizeof(msg) - len,
+                    "%s\"%s\":{\"n\":%lu,\"decode\":", isEmpty ? "" : ",",
+                    cmdNames[i], (unsigned long)_actuate[i].getCount());
+    if (len < (int)sizeof(msg))
+      len += _decode[i].print(msg + len, sizeof(msg) - len);
+    if (len < (int)sizeof(msg))
+      len += snprintf(msg + len, sizeof(msg) - len, ",\"actuate\":");
+    if (len < (int)sizeof(msg))
+      len += _actuate[i].print(msg + len, sizeof(msg) - len);
+    if (len < (int)sizeof(msg))
+      len += snprintf(msg + len, sizeof(msg) - len, "}");
+    isEmpty = false;
+  }
+  if (isEmpty)
+    return;
+  if (len >= (int)sizeof(msg) - 2) {
+    WS_DEBUG_PRINTLN("ERROR: Command latency does not fit the payload!");
+    return;
+  }
+  msg[len++] = '}';
+  msg[len++] = '}';
+  msg[len] = '\0';
+
+  WS_DEBUG_PRINT("Command latency: ");
+  WS_DEBUG_PRINTLN(msg);
+  if (WS._topic_diagnostics == NULL)
+    return;
+  WS.publish(WS._topic_diagnostics, (uint8_t *)msg, len, 0,
+             WS_PUBLISH_PRIORITY_LOW);
+}
@@ -0,0 +1,80 @@
+/*!
+ * @file ws_latency.h
+ *
+ * Traces the time taken from an actuator command's arrival to the pin
+ * write, and publishes it to the device's diagnostics topic.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * Copyright (c) Brent Rubell 2023 for Adafruit Industries.
+ *
+ * MIT license, all text here must be included in any redistribution.
+ *
+ */
+#ifndef WS_LATENCY_H
+#define WS_LATENCY_H
+
+#include "Wippersnapper.h"
+#include "ws_histogram.h"
+
+// The report is published to a topic the stock broker doesn't define, add
+// e.g. -DWS_LATENCY_INTERVAL_MS=60000 to the build flags to enable it.
+#ifndef WS_LATENCY_INTERVAL_MS
+#define WS_LATENCY_INTERVAL_MS                                                 \
+  0 ///< Time between command latency reports, in milliseconds, 0 disables
+#endif
+
+/** Actuator commands which are traced */
+typedef enum {
+  WS_LATENCY_CMD_DIGITAL, ///< Digital pin write
+  WS_LATENCY_CMD_SERVO,   ///< Servo pulse width write
+  WS_LATENCY_CMD_PWM,     ///< PWM duty cycle write
+  WS_LATENCY_CMD_PIXELS,  ///< Pixel strand fill
+  WS_LATENCY_CMD_COUNT,   ///< Number of commands
+} ws_latency_cmd_t;
+
+class Wippersnapper;
+
+/**************************************************************************/
+/*!
+    @brief  Command latency tracing.
+
+            A packet is timestamped when it is seen waiting on the socket,
+            when its command has been decoded and when the pin has been
+            written. The decode and actuation latencies, both measured
+            from the packet's arrival, are kept per command and reported
+            every WS_LATENCY_INTERVAL_MS, if enabled and any commands
+            arrived.
+
+            Define WS_LATENCY_ECHO to also publish each command's timings
+            as it is handled.
+*/
+/**************************************************************************/
+class ws_latency {
+public:
+  ws_latency();
+  ~ws_latency();
+
+  void markReceived();
+  void markDecoded();
+  void markActuated(ws_latency_cmd_t cmd);
+  void endPacket();
+  void update();
+
+private:
+  void report();
+
+  ws_histogram _decode[WS_LATENCY_CMD_COUNT];  ///< Arrival to decoded, us
+  ws_histogram _actuate[WS_LATENCY_CMD_COUNT]; ///< Arrival to pin write, us
+
+  bool _isTracing = false;      ///< True while a packet is being handled
+  bool _isDecoded = false;      ///< True once its command was decoded
+  uint32_t _receivedAt = 0;     ///< When the packet arrived, in us
+  uint32_t _decodedAt = 0;      ///< When its command was decoded, in us
+  unsigned long _prvReport = 0; ///< When latency was last reported, in ms
+};
+extern Wippersnapper WS;
+
+#endif // WS_LATENCY_H
@@ -0,0 +1,267 @@
+/*!
+ * @file ws_log.cpp
+ *
+ * Debug logging for hot paths. With WS_DEBUG_TOKENIZED, messages are
+ * written to a RAM ring buffer as a token and raw binary arguments, and
+ * drained to the serial port when it can accept them without blocking.
+ * tools/log_decoder turns the stream back into text.
+ *
+ * Each module has a compile-time log level, and a runtime level which can
+ * be changed over MQTT.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * Copyright (c) Brent Rubell 2023 for Adafruit Industries.
+ *
+ * MIT license, all text here must be included in any redistribution.
+ *
+ */
+#include "ws_log.h"
+
+/** Names of the modules, as used on the diagnostics/log topic */
+static const char *moduleNames[WS_LOG_MODULE_COUNT] = {
+    "net",    "mqtt",  "i2c", "analog",  "digital", "ds18x20",
+    "pixels", "servo", "pwm", "display", "fs"};
+
+/** Names of the levels, from WS_LOG_LEVEL_NONE up */
+static const char *levelNames[] = {"none", "error", "warn", "info", "debug"};
+
+/** Highest level compiled in for each module */
+static const uint8_t maxLevels[WS_LOG_MODULE_COUNT] = {
+    WS_LOG_LEVEL_NET,     WS_LOG_LEVEL_MQTT,    WS_LOG_LEVEL_I2C,
+    WS_LOG_LEVEL_ANALOG,  WS_LOG_LEVEL_DIGITAL, WS_LOG_LEVEL_DS18X20,
+    WS_LOG_LEVEL_PIXELS,  WS_LOG_LEVEL_SERVO,   WS_LOG_LEVEL_PWM,
+    WS_LOG_LEVEL_DISPLAY, WS_LOG_LEVEL_FS};
+
+/** Runtime level a module starts at */
+#define WS_LOG_START_LEVEL(module)                                             \
+  (WS_LOG_LEVEL_##module < WS_LOG_LEVEL_DEFAULT ? WS_LOG_LEVEL_##module       \
+                                                : WS_LOG_LEVEL_DEFAULT)
+
+uint8_t ws_log::_levels[WS_LOG_MODULE_COUNT] = {
+    WS_LOG_START_LEVEL(NET),     WS_LOG_START_LEVEL(MQTT),
+    WS_LOG_START_LEVEL(I2C),     WS_LOG_START_LEVEL(ANALOG),
+    WS_LOG_START_LEVEL(DIGITAL), WS_LOG_START_LEVEL(DS18X20),
+    WS_LOG_START_LEVEL(PIXELS),  WS_LOG_START_LEVEL(SERVO),
+    WS_LOG_START_LEVEL(PWM),     WS_LOG_START_LEVEL(DISPLAY),
+    WS_LOG_START_LEVEL(FS)};
+
+/**************************************************************************/
+/*!
+    @brief    Creates a debug logger with an empty ring buffer.
+*/
+/**************************************************************************/
+ws_log::ws_log() : ws_serial_ring(_buffer, sizeof(_buffer)) {}
+
+/**************************************************************************/
+/*!
+    @brief    Destructor for the debug logger.
+*/
+/**************************************************************************/
+ws_log::~ws_log() {}
+
+/**************************************************************************/
+/*!
+    @brief    Packs an argument as its tag and 32-bit value.
+    @param    record
+              The record being built.
+    @param    len
+              Length of the record so far, advanced past the argument.
+    @param    tag
+              The argument's type tag.
+    @param    value
+              The argument's value.
+*/
+/**************************************************************************/
+void ws_log::packTagged(uint8_t *record, size_t &len, char tag,
+                        uint32_t value) {
+  if (len + 1 + sizeof(value) > WS_LOG_MAX_RECORD)
+    return; // argument dropped, the decoder prints "?" in its place
+  record[len++] = tag;
+  for (uint8_t i = 0; i < sizeof(value); i++)
+    record[len++] = (uint8_t)(value >> (8 * i));
+}
+
+/**************************************************************************/
+/*!
+    @brief    Packs a string argument, truncated to WS_LOG_MAX_STRING.
+    @param    record
+              The record being built.
+    @param    len
+              Length of the record so far, advanced past the argument.
+    @param    arg
+              The string.
+*/
+/**************************************************************************/
+void ws_log::packArg(uint8_t *record, size_t &len, const char *arg) {
+  size_t strLen = arg == NULL ? 0 : strnlen(arg, WS_LOG_MAX_STRING);
+  if (len + 2 + strLen > WS_LOG_MAX_RECORD)
+    return;
+  record[len++] = 's';
+  record[len++] = (uint8_t)strLen;
+  memcpy(record + len, arg, strLen);
+  len += strLen;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Fills in a record's header and adds it to the ring buffer.
+    @param    token
+              Token of the message's format string.
+    @param    record
+              The record, with WS_LOG_HEADER_SIZE bytes left for its
+              header.
+    @param    len
+              Length of the record, including its header.
+*/
+/**************************************************************************/
+void ws_log::commit(uint32_t token, uint8_t *record, size_t len) {
+  uint32_t curTime = millis();
+  record[0] = WS_LOG_SYNC;
+  for (uint8_t i = 0; i < 4; i++) {
+    record[1 + i] = (uint8_t)(curTime >> (8 * i));
+    record[5 + i] = (uint8_t)(token >> (8 * i));
+  }
+  record[9] = (uint8_t)(len - WS_LOG_HEADER_SIZE);
+
+  push(record, len);
+}
+
+/**************************************************************************/
+/*!
+    @brief    Returns the length of the oldest record, from its header.
+    @returns  The record's length, in bytes.
+*/
+/**************************************************************************/
+size_t ws_log::recordLength() { return WS_LOG_HEADER_SIZE + peek(9); }
+
+/**************************************************************************/
+/*!
+    @brief    Logs how many records were dropped while the buffer was
+              full.
+    @param    dropped
+              Number of records dropped.
+*/
+/**************************************************************************/
+void ws_log::recordDropped(uint32_t dropped) {
+  write(ws_log_token("Log buffer full, dropped %u messages"), dropped);
+}
+
+/**************************************************************************/
+/*!
+    @brief    Prints a format string up to its next specifier.
+    @param    fmt
+              The format string, advanced past the specifier.
+    @returns  The specifier's conversion character, or '\0' at the end
+              of the format string.
+*/
+/**************************************************************************/
+char ws_log::printLiteral(const char *&fmt) {
+  while (*fmt != '\0') {
+    if (*fmt != '%') {
+      WS_PRINTER.print(*fmt++);
+      continue;
+    }
+    fmt++;
+    if (*fmt == '%') {
+      WS_PRINTER.print(*fmt++);
+      continue;
+    }
+    // skip flags, width, precision and length, Print doesn't use them
+    while (*fmt != '\0' && strchr("-+ #0123456789.lh", *fmt) != NULL)
+      fmt++;
+    if (*fmt == '\0')
+      return '\0';
+    return *fmt++;
+  }
+  return '\0';
+}
+
+/**************************************************************************/
+/*!
+    @brief    Puts every module back at its starting runtime level.
+*/
+/**************************************************************************/
+void ws_log::resetLevels() {
+  for (uint8_t i = 0; i < WS_LOG_MODULE_COUNT; i++)
+    _levels[i] = min(maxLevels[i], (uint8_t)WS_LOG_LEVEL_DEFAULT);
+}
+
+/**************************************************************************/
+/*!
+    @brief    Sets runtime log levels from a command received on the
+              diagnostics/log topic, such as "i2c=debug,net=warn". The
+              module "all" sets every module, and "reset" restores the
+              starting levels. A level is capped at the level its module
+              was compiled with.
+    @param    cmd
+              The command, modified while it is parsed.
+    @returns  True if every setting in the command was valid, False
+              otherwise. Valid settings are applied either way.
+*/
+/**************************************************************************/
+bool ws_log::setLevels(char *cmd) {
+  bool isValid = true;
+  for (char *setting = strtok(cmd, ", \r\n"); setting != NULL;
+       setting = strtok(NULL, ", \r\n")) {
+    if (strcmp(setting, "reset") == 0) {
+      resetLevels();
+      continue;
+    }
+    char *levelName = strchr(setting, '=');
+    if (levelName == NULL) {
+      isValid = false;
+      continue;
+    }
+    *levelName++ = '\0';
+
+    int level = -1;
+    for (uint8_t i = 0; i < sizeof(levelNames) / sizeof(levelNames[0]); i++) {
+      if (strcmp(levelName, levelNames[i]) == 0)
+        level = i;
+    }
+    bool isAll = strcmp(setting, "all") == 0;
+    bool isFound = false;
+    for (uint8_t i = 0; i < WS_LOG_MODULE_COUNT && level >= 0; i++) {
+      if (!isAll && strcmp(setting, moduleNames[i]) != 0)
+        continue;
+      _levels[i] = min(maxLevels[i], (uint8_t)level);
+      isFound = true;
+    }
+    if (!isFound)
+      isValid = false;
+  }
+  return isValid;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Prints each module's runtime log level, and publishes them
+              to the diagnostics topic as a JSON object.
+*/
+/**************************************************************************/
+void ws_log::reportLevels() {
+  char msg[WS_MQTT_MAX_PAYLOAD_SIZE];
+  int len = snprintf(msg, sizeof(msg), "{\"log\":{");
+  for (uint8_t i = 0; i < WS_LOG_MODULE_COUNT && len < (int)sizeof(msg);
+       i++) {
+    len += snprintf(msg + len, sizeof(msg) - len, "%s\"%s\":\"%s\"",
+                    i == 0 ? "" : ",", moduleNames[i], levelNames[_levels[i]]);
+  }
+  if (len >= (int)sizeof(msg) - 2) {
+    WS_DEBUG_PRINTLN("ERROR: Log levels do not fit the payload!");
+    return;
+  }
+  msg[len++] = '}';
+  msg[len++] = '}';
+  msg[len] = '\0';
+
+  WS_DEBUG_PRINT("Log levels: ");
+  WS_DEBUG_PRINTLN(msg);
+  if (WS._topic_diagnostics == NULL)
+    return;
+  WS.publish(WS._topic_diagnostics, (uint8_t *)msg, len, 0,
+             WS_PUBLISH_PRIORITY_HIGH);
+}
@@ -0,0 +1,316 @@
+/*!
+ * @file ws_log.h
+ *
+ * Debug logging for hot paths. With WS_DEBUG_TOKENIZED, messages are
+ * written to a RAM ring buffer as a token and raw binary arguments, and
+ * drained to the serial port when it can accept them without blocking.
+ * tools/log_decoder turns the stream back into text.
+ *
+ * Each module has a compile-time log level, and a runtime level which can
+ * be changed over MQTT.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * Copyright (c) Brent Rubell 2023 for Adafruit Industries.
+ *
+ * MIT license, all text here must be included in any redistribution.
+ *
+ */
+#ifndef WS_LOG_H
+#define WS_LOG_H
+
+#include "Wippersnapper.h"
+#include "ws_serial_ring.h"
+#include <type_traits>
+
+#ifndef WS_LOG_BUFFER_SIZE
+#define WS_LOG_BUFFER_SIZE                                                     \
+  1024 ///< Size of the ring buffer holding tokenized records, in bytes
+#endif
+#define WS_LOG_MAX_RECORD 96   ///< Largest tokenized record, in bytes
+#define WS_LOG_MAX_STRING 32   ///< Longest string argument kept, in bytes
+#define WS_LOG_HEADER_SIZE 10  ///< Sync, timestamp, token and length bytes
+#define WS_LOG_SYNC 0x1E       ///< Starts each record within the serial output
+
+#define WS_LOG_LEVEL_NONE 0  ///< Logs nothing
+#define WS_LOG_LEVEL_ERROR 1 ///< Logs errors
+#define WS_LOG_LEVEL_WARN 2  ///< Also logs warnings
+#define WS_LOG_LEVEL_INFO 3  ///< Also logs configuration changes
+#define WS_LOG_LEVEL_DEBUG 4 ///< Also logs every reading and publish
+
+// Highest level compiled in, for every module. Messages above a module's
+// level compile to nothing. Override per module with, for example,
+// -DWS_LOG_LEVEL_I2C=WS_LOG_LEVEL_DEBUG.
+#ifndef WS_LOG_LEVEL
+#ifdef WS_DEBUG
+#define WS_LOG_LEVEL WS_LOG_LEVEL_DEBUG ///< Compile-time level
+#else
+#define WS_LOG_LEVEL WS_LOG_LEVEL_NONE ///< Compile-time level
+#endif
+#endif
+#ifndef WS_LOG_LEVEL_NET
+#define WS_LOG_LEVEL_NET WS_LOG_LEVEL ///< Network compile-time level
+#endif
+#ifndef WS_LOG_LEVEL_MQTT
+#define WS_LOG_LEVEL_MQTT WS_LOG_LEVEL ///< MQTT compile-time level
+#endif
+#ifndef WS_LOG_LEVEL_I2C
+#define WS_LOG_LEVEL_I2C WS_LOG_LEVEL ///< I2C compile-time level
+#endif
+#ifndef WS_LOG_LEVEL_ANALOG
+#define WS_LOG_LEVEL_ANALOG WS_LOG_LEVEL ///< Analog I/O compile-time level
+#endif
+#ifndef WS_LOG_LEVEL_DIGITAL
+#define WS_LOG_LEVEL_DIGITAL WS_LOG_LEVEL ///< Digital I/O compile-time level
+#endif
+#ifndef WS_LOG_LEVEL_DS18X20
+#define WS_LOG_LEVEL_DS18X20 WS_LOG_LEVEL ///< DS18x20 compile-time level
+#endif
+#ifndef WS_LOG_LEVEL_PIXELS
+#define WS_LOG_LEVEL_PIXELS WS_LOG_LEVEL ///< Pixels compile-time level
+#endif
+#ifndef WS_LOG_LEVEL_SERVO
+#define WS_LOG_LEVEL_SERVO WS_LOG_LEVEL ///< Servo compile-time level
+#endif
+#ifndef WS_LOG_LEVEL_PWM
+#define WS_LOG_LEVEL_PWM WS_LOG_LEVEL ///< PWM compile-time level
+#endif
+#ifndef WS_LOG_LEVEL_DISPLAY
+#define WS_LOG_LEVEL_DISPLAY WS_LOG_LEVEL ///< Display compile-time level
+#endif
+#ifndef WS_LOG_LEVEL_FS
+#define WS_LOG_LEVEL_FS WS_LOG_LEVEL ///< Filesystem compile-time level
+#endif
+
+// Runtime level every module starts at, capped at its compile-time level.
+// Raise a module's runtime level by publishing, for example, "i2c=debug"
+// to the device's diagnostics/log topic.
+#ifndef WS_LOG_LEVEL_DEFAULT
+#define WS_LOG_LEVEL_DEFAULT WS_LOG_LEVEL_INFO ///< Starting runtime level
+#endif
+
+/** Modules which log at their own level */
+typedef enum {
+  WS_LOG_MODULE_NET,
+  WS_LOG_MODULE_MQTT,
+  WS_LOG_MODULE_I2C,
+  WS_LOG_MODULE_ANALOG,
+  WS_LOG_MODULE_DIGITAL,
+  WS_LOG_MODULE_DS18X20,
+  WS_LOG_MODULE_PIXELS,
+  WS_LOG_MODULE_SERVO,
+  WS_LOG_MODULE_PWM,
+  WS_LOG_MODULE_DISPLAY,
+  WS_LOG_MODULE_FS,
+  WS_LOG_MODULE_COUNT
+} ws_log_module_t;
+
+/**************************************************************************/
+/*!
+    @brief  Returns a log message's token, the FNV-1a hash of its format
+            string. Evaluated by the compiler, so the format string is
+            not stored on the device.
+    @param  fmt
+            The message's format string.
+    @param  hash
+            Hash of the characters before fmt.
+    @returns The token.
+*/
+/**************************************************************************/
+constexpr uint32_t ws_log_token(const char *fmt,
+                                uint32_t hash = 2166136261UL) {
+  return *fmt == '\0'
+             ? hash
+             : ws_log_token(fmt + 1, (hash ^ (uint8_t)*fmt) * 16777619UL);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Debug logger, whose tokenized records are written out through
+            a ws_serial_ring.
+
+            Format strings take printf-style %d, %u, %x, %f, %s and %%
+            specifiers. Each argument is written with a type tag, so the
+            decoder does not depend on the specifier matching the type.
+
+            Tokenized record layout, little-endian:
+            [WS_LOG_SYNC][millis() u32][token u32][args length u8][args]
+            where each argument is 'i' int32, 'u' uint32, 'f' float,
+            or 's' followed by a length byte and the string's bytes.
+*/
+/**************************************************************************/
+class ws_log : public ws_serial_ring {
+public:
+  ws_log();
+  ~ws_log();
+
+  /************************************************************************/
+  /*!
+      @brief  Adds a tokenized record to the ring buffer.
+      @param  token
+              Token of the message's format string.
+      @param  args
+              The message's arguments.
+  */
+  /************************************************************************/
+  template <typename... Args> void write(uint32_t token, Args... args) {
+    uint8_t record[WS_LOG_MAX_RECORD];
+    size_t len = WS_LOG_HEADER_SIZE;
+    pack(record, len, args...);
+    commit(token, record, len);
+  }
+
+  /************************************************************************/
+  /*!
+      @brief  Prints a message as text, as WS_DEBUG_PRINT would have.
+      @param  fmt
+              The message's format string.
+      @param  args
+              The message's arguments.
+  */
+  /************************************************************************/
+  template <typename... Args> static void print(const char *fmt, Args... args) {
+    printArgs(fmt, args...);
+    WS_PRINTER.println();
+  }
+
+  /************************************************************************/
+  /*!
+      @brief  Returns a module's runtime log level.
+      @param  module
+              The module.
+      @returns The module's level, a WS_LOG_LEVEL_ value.
+  */
+  /************************************************************************/
+  static uint8_t getLevel(ws_log_module_t module) { return _levels[module]; }
+  static void resetLevels();
+  static bool setLevels(char *cmd);
+  static void reportLevels();
+
+protected:
+  size_t recordLength();
+  void recordDropped(uint32_t dropped);
+
+private:
+  void commit(uint32_t token, uint8_t *record, size_t len);
+  static char printLiteral(const char *&fmt);
+
+  /** Ends the argument list */
+  void pack(uint8_t *record, size_t &len) {}
+  /** Packs each argument in turn */
+  template <typename T, typename... Rest>
+  void pack(uint8_t *record, size_t &len, T arg, Rest... rest) {
+    packArg(record, len, arg);
+    pack(record, len, rest...);
+  }
+
+  /** Packs a signed integer */
+  template <typename T>
+  typename std::enable_if<std::is_integral<T>::value &&
+                          std::is_signed<T>::value>::type
+  packArg(uint8_t *record, size_t &len, T arg) {
+    packTagged(record, len, 'i', (uint32_t)(int32_t)arg);
+  }
+  /** Packs an unsigned integer */
+  template <typename T>
+  typename std::enable_if<std::is_integral<T>::value &&
+                          !std::is_signed<T>::value>::type
+  packArg(uint8_t *record, size_t &len, T arg) {
+    packTagged(record, len, 'u', (uint32_t)arg);
+  }
+  /** Packs a float or double, as a float */
+  template <typename T>
+  typename std::enable_if<std::is_floating_point<T>::value>::type
+  packArg(uint8_t *record, size_t &len, T arg) {
+    float value = (float)arg;
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    packTagged(record, len, 'f', bits);
+  }
+  void packArg(uint8_t *record, size_t &len, const char *arg);
+  /** Packs a string */
+  void packArg(uint8_t *record, size_t &len, char *arg) {
+    packArg(record, len, (const char *)arg);
+  }
+  void packTagged(uint8_t *record, size_t &len, char tag, uint32_t value);
+
+  /** Prints the rest of the format string */
+  static void printArgs(const char *fmt) {
+    while (printLiteral(fmt) != '\0')
+      ;
+  }
+  /** Prints each argument in turn */
+  template <typename T, typename... Rest>
+  static void printArgs(const char *fmt, T arg, Rest... rest) {
+    char conv = printLiteral(fmt);
+    if (conv == '\0')
+      return;
+    printArg(arg, conv);
+    printArgs(fmt, rest...);
+  }
+
+  /** Prints a signed integer */
+  template <typename T>
+  static typename std::enable_if<std::is_integral<T>::value &&
+                                 std::is_signed<T>::value>::type
+  printArg(T arg, char conv) {
+    if (conv == 'x' || conv == 'X')
+      WS_PRINTER.print((unsigned long)arg, HEX);
+    else
+      WS_PRINTER.print((long)arg);
+  }
+  /** Prints an unsigned integer */
+  template <typename T>
+  static typename std::enable_if<std::is_integral<T>::value &&
+                                 !std::is_signed<T>::value>::type
+  printArg(T arg, char conv) {
+    WS_PRINTER.print((unsigned long)arg,
+                     (conv == 'x' || conv == 'X') ? HEX : DEC);
+  }
+  /** Prints a float or double */
+  template <typename T>
+  static typename std::enable_if<std::is_floating_point<T>::value>::type
+  printArg(T arg, char conv) {
+    WS_PRINTER.print((double)arg);
+  }
+  /** Prints a string */
+  static void printArg(const char *arg, char conv) { WS_PRINTER.print(arg); }
+
+  uint8_t _buffer[WS_LOG_BUFFER_SIZE]; ///< Storage for the ring buffer
+  static uint8_t _levels[WS_LOG_MODULE_COUNT]; ///< Runtime level of modules
+};
+
+#if defined(WS_DEBUG) && defined(WS_DEBUG_TOKENIZED)
+#define WS_LOG(fmt, ...)                                                       \
+  WS._log->write(std::integral_constant<uint32_t, ws_log_token(fmt)>::value,  \
+                 ##__VA_ARGS__) ///< Logs a tokenized message
+#elif defined(WS_DEBUG)
+#define WS_LOG(fmt, ...)                                                       \
+  ws_log::print(fmt, ##__VA_ARGS__) ///< Logs a message as text
+#else
+#define WS_LOG(fmt, ...)                                                       \
+  {} ///< Logs a message
+#endif
+
+#define WS_LOG_AT(module, level, fmt, ...)                                     \
+  {                                                                            \
+    if (WS_LOG_LEVEL_##module >= level &&                                      \
+        ws_log::getLevel(WS_LOG_MODULE_##module) >= level)                     \
+      WS_LOG(fmt, ##__VA_ARGS__);                                              \
+  } ///< Logs a message if the module's level allows it
+#define WS_LOG_ERROR(module, fmt, ...)                                         \
+  WS_LOG_AT(module, WS_LOG_LEVEL_ERROR, fmt,                                   \
+            ##__VA_ARGS__) ///< Logs an error from a module
+#define WS_LOG_WARN(module, fmt, ...)                                          \
+  WS_LOG_AT(module, WS_LOG_LEVEL_WARN, fmt,                                    \
+            ##__VA_ARGS__) ///< Logs a warning from a module
+#define WS_LOG_INFO(module, fmt, ...)                                          \
+  WS_LOG_AT(module, WS_LOG_LEVEL_INFO, fmt,                                    \
+            ##__VA_ARGS__) ///< Logs a configuration change from a module
+#define WS_LOG_DEBUG(module, fmt, ...)                                         \
+  WS_LOG_AT(module, WS_LOG_LEVEL_DEBUG, fmt,                                   \
+            ##__VA_ARGS__) ///< Logs a reading or publish from a module
+
+#endif // WS_LOG_H
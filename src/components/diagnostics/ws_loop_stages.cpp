@@ -0,0 +1,91 @@
+/*!
+ * @file ws_loop_stages.cpp
+ *
+ * Times the stages of the run() loop for the loop profiler and the
+ * execution tracer.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * Copyright (c) Brent Rubell 2023 for Adafruit Industries.
+ *
+ * MIT license, all text here must be included in any redistribution.
+ *
+ */
+// Wippersnapper.h first, it holds the build flags
+#include "Wippersnapper.h"
+#include "ws_loop_stages.h"
+
+#if defined(WS_PROFILER) || defined(WS_TRACE)
+
+/**************************************************************************/
+/*!
+    @brief    Creates a loop stage timer.
+*/
+/**************************************************************************/
+ws_loop_stages::ws_loop_stages() {}
+
+/**************************************************************************/
+/*!
+    @brief    Destructor for the loop stage timer.
+*/
+/**************************************************************************/
+ws_loop_stages::~ws_loop_stages() {}
+
+/**************************************************************************/
+/*!
+    @brief    Marks the start of a run() loop, and of its first stage.
+*/
+/**************************************************************************/
+void ws_loop_stages::beginLoop() {
+  _loopStart = micros();
+  _stageStart = _loopStart;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Times a stage, the next stage starts now.
+    @param    stage
+              The stage which just ended.
+*/
+/**************************************************************************/
+void ws_loop_stages::endStage(ws_loop_stage_t stage) {
+  uint32_t curTime = micros();
+  emit(stage, _stageStart, curTime - _stageStart);
+  _stageStart = curTime;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Times the whole loop.
+*/
+/**************************************************************************/
+void ws_loop_stages::endLoop() {
+  emit(WS_LOOP_STAGE_LOOP, _loopStart, micros() - _loopStart);
+}
+
+/**************************************************************************/
+/*!
+    @brief    Hands a stage's timing to the profiler and the tracer.
+    @param    stage
+              The stage timed.
+    @param    start
+              When the stage began, in microseconds.
+    @param    duration
+              Length of the stage, in microseconds.
+*/
+/**************************************************************************/
+void ws_loop_stages::emit(ws_loop_stage_t stage, uint32_t start,
+                          uint32_t duration) {
+#ifdef WS_PROFILER
+  WS._profiler->record(stage, duration);
+#endif
+#ifdef WS_TRACE
+  WS._trace->record(stage, start, duration);
+#else
+  (void)start;
+#endif
+}
+
+#endif // WS_PROFILER || WS_TRACE
@@ -0,0 +1,77 @@
+/*!
+ * @file ws_loop_stages.h
+ *
+ * Times the stages of the run() loop for the loop profiler and the
+ * execution tracer.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * Copyright (c) Brent Rubell 2023 for Adafruit Industries.
+ *
+ * MIT license, all text here must be included in any redistribution.
+ *
+ */
+#ifndef WS_LOOP_STAGES_H
+#define WS_LOOP_STAGES_H
+
+// Included by ws_profiler.h and ws_trace.h from within Wippersnapper.h, so
+// the stages must not depend on it
+#include <Arduino.h>
+
+/** Stages of the run() loop */
+typedef enum {
+  WS_LOOP_STAGE_NET,     ///< runNetFSM()
+  WS_LOOP_STAGE_PING,    ///< pingBroker() and the status LED
+  WS_LOOP_STAGE_PACKETS, ///< processPackets() and QoS 1 retransmits
+  WS_LOOP_STAGE_DIGITAL, ///< Digital inputs
+  WS_LOOP_STAGE_ANALOG,  ///< Analog inputs
+  WS_LOOP_STAGE_I2C,     ///< I2C sensors
+  WS_LOOP_STAGE_DS18X20, ///< DS18x20 sensors
+  WS_LOOP_STAGE_LOOP,    ///< The whole loop
+  WS_LOOP_STAGE_COUNT,   ///< Number of stages
+} ws_loop_stage_t;
+
+#if defined(WS_PROFILER) || defined(WS_TRACE)
+
+class Wippersnapper;
+
+/**************************************************************************/
+/*!
+    @brief  Times the stages of the run() loop. Each stage's timing is
+            handed to the loop profiler and to the execution tracer,
+            whichever of the two are built in.
+*/
+/**************************************************************************/
+class ws_loop_stages {
+public:
+  ws_loop_stages();
+  ~ws_loop_stages();
+
+  void beginLoop();
+  void endStage(ws_loop_stage_t stage);
+  void endLoop();
+
+private:
+  void emit(ws_loop_stage_t stage, uint32_t start, uint32_t duration);
+
+  uint32_t _loopStart = 0;  ///< When the current loop began, in us
+  uint32_t _stageStart = 0; ///< When the current stage began, in us
+};
+extern Wippersnapper WS;
+
+#define WS_LOOP_BEGIN() WS._loopStages->beginLoop() ///< Starts a loop
+#define WS_LOOP_STAGE(stage)                                                   \
+  WS._loopStages->endStage(stage) ///< Ends a stage, starts the next
+#define WS_LOOP_END() WS._loopStages->endLoop() ///< Ends a loop
+#else
+#define WS_LOOP_BEGIN()                                                        \
+  {} ///< Starts a loop
+#define WS_LOOP_STAGE(stage)                                                   \
+  {} ///< Ends a stage, starts the next
+#define WS_LOOP_END()                                                          \
+  {} ///< Ends a loop
+#endif // WS_PROFILER || WS_TRACE
+
+#endif // WS_LOOP_STAGES_H
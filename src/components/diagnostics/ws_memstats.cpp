@@ -0,0 +1,169 @@
+/*!
+ * @file ws_memstats.cpp
+ *
+ * Tracks the device's heap, stack and PSRAM usage and publishes it to the
+ * device's diagnostics topic.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * Copyright (c) Brent Rubell 2023 for Adafruit Industries.
+ *
+ * MIT license, all text here must be included in any redistribution.
+ *
+ */
+#include "ws_memstats.h"
+
+// Bottom of core 0's stack, from the pico-sdk linker script
+#if defined(ARDUINO_ARCH_RP2040) && !defined(__FREERTOS)
+extern "C" uint32_t __StackBottom;
+#endif
+
+/**************************************************************************/
+/*!
+    @brief    Creates the memory usage tracker. Runs before setup(), while
+              little of the stack is in use, so it can be painted.
+*/
+/**************************************************************************/
+ws_memstats::ws_memstats() { paintStack(); }
+
+/**************************************************************************/
+/*!
+    @brief    Destructor for the memory usage tracker.
+*/
+/**************************************************************************/
+ws_memstats::~ws_memstats() {}
+
+/**************************************************************************/
+/*!
+    @brief    Fills the unused part of the stack with a known pattern.
+              The stack's high-water mark is the last word which still
+              holds the pattern.
+*/
+/**************************************************************************/
+void ws_memstats::paintStack() {
+#if defined(ARDUINO_ARCH_RP2040) && !defined(__FREERTOS)
+  uint32_t *p = &__StackBottom;
+  // leave this function's frame, and some margin, alone
+  uint32_t *top = (uint32_t *)__builtin_frame_address(0) - 32;
+  while (p < top)
+    *p++ = WS_MEMSTATS_STACK_PAINT;
+#endif
+}
+
+/**************************************************************************/
+/*!
+    @brief    Returns the lowest free heap seen since boot.
+    @returns  Free heap, in bytes.
+*/
+/**************************************************************************/
+uint32_t ws_memstats::getMinFreeHeap() {
+#ifdef ARDUINO_ARCH_ESP32
+  // tracked by the allocator, catches dips between samples
+  return ESP.getMinFreeHeap();
+#else
+  return _minFreeHeap;
+#endif
+}
+
+/**************************************************************************/
+/*!
+    @brief    Returns the least free stack the loop task has had.
+    @returns  Free stack, in bytes, or -1 if not known on this platform.
+*/
+/**************************************************************************/
+int32_t ws_memstats::getMinFreeStack() {
+#if defined(ARDUINO_ARCH_ESP32)
+  // in bytes on ESP-IDF, for the calling task
+  return (int32_t)uxTaskGetStackHighWaterMark(NULL);
+#elif defined(ARDUINO_ARCH_ESP8266)
+  return (int32_t)ESP.getFreeContStack();
+#elif defined(ARDUINO_ARCH_RP2040) && !defined(__FREERTOS)
+  uint32_t *p = &__StackBottom;
+  while (*p == WS_MEMSTATS_STACK_PAINT)
+    p++;
+  return (int32_t)((p - &__StackBottom) * sizeof(uint32_t));
+#else
+  return -1;
+#endif
+}
+
+/**************************************************************************/
+/*!
+    @brief    Samples the free heap.
+*/
+/**************************************************************************/
+void ws_memstats::sample() {
+  uint32_t freeHeap = WS.getFreeHeap();
+  if (freeHeap < _minFreeHeap)
+    _minFreeHeap = freeHeap;
+  _prvSample = millis();
+}
+
+/**************************************************************************/
+/*!
+    @brief    Samples the free heap every WS_MEMSTATS_SAMPLE_MS, and
+              reports memory usage every WS_MEMSTATS_INTERVAL_MS, if
+              enabled. Called from the run() loop.
+*/
+/**************************************************************************/
+void ws_memstats::update() {
+  if (millis() - _prvSample < WS_MEMSTATS_SAMPLE_MS)
+    return;
+  sample();
+  if (WS_MEMSTATS_INTERVAL_MS == 0 ||
+      millis() - _prvReport < WS_MEMSTATS_INTERVAL_MS)
+    return;
+  report();
+}
+
+/**************************************************************************/
+/*!
+    @brief    Prints memory usage, and publishes it to the diagnostics
+              topic, as a JSON object with sizes in bytes.
+    @param    isHalted
+              True if the device is about to halt, the report is then
+              published even if the publish budget has run low.
+*/
+/**************************************************************************/
+void ws_memstats::report(bool isHalted) {
+  sample();
+  _prvReport = millis();
+
+  char msg[192];
+  uint32_t freeHeap = WS.getFreeHeap();
+  uint32_t largestBlock = WS.getLargestFreeBlock();
+  int len = snprintf(
+      msg, sizeof(msg),
+      "{\"uptime\":%lu,\"heap\":%lu,\"heap_min\":%lu,\"block\":%lu,"
+      "\"frag\":%u,\"stack_min\":%ld",
+      millis() / 1000, (unsigned long)freeHeap,
+      (unsigned long)getMinFreeHeap(), (unsigned long)largestBlock,
+      freeHeap > 0 ? (unsigned)(100 - (uint64_t)largestBlock * 100 / freeHeap)
+                   : 0U,
+      (long)getMinFreeStack());
+#ifdef ARDUINO_ARCH_ESP32
+  if (psramFound() && len < (int)sizeof(msg))
+    len += snprintf(msg + len, sizeof(msg) - len,
+                    ",\"psram\":%lu,\"psram_min\":%lu,\"psram_size\":%lu",
+                    (unsigned long)ESP.getFreePsram(),
+                    (unsigned long)ESP.getMinFreePsram(),
+                    (unsigned long)ESP.getPsramSize());
+#endif
+  if (isHalted && len < (int)sizeof(msg))
+    len += snprintf(msg + len, sizeof(msg) - len, ",\"halt\":true");
+  if (len >= (int)sizeof(msg) - 1) {
+    WS_DEBUG_PRINTLN("ERROR: Memory report does not fit the payload!");
+    return;
+  }
+  msg[len++] = '}';
+  msg[len] = '\0';
+
+  WS_DEBUG_PRINT("Memory usage: ");
+  WS_DEBUG_PRINTLN(msg);
+  if (WS._topic_diagnostics == NULL || !WS._mqtt->connected())
+    return;
+  WS.publish(WS._topic_diagnostics, (uint8_t *)msg, len, 0,
+             isHalted ? WS_PUBLISH_PRIORITY_HIGH : WS_PUBLISH_PRIORITY_LOW);
+}
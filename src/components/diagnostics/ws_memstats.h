@@ -0,0 +1,67 @@
+/*!
+ * @file ws_memstats.h
+ *
+ * Tracks the device's heap, stack and PSRAM usage and publishes it to the
+ * device's diagnostics topic.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * Copyright (c) Brent Rubell 2023 for Adafruit Industries.
+ *
+ * MIT license, all text here must be included in any redistribution.
+ *
+ */
+#ifndef WS_MEMSTATS_H
+#define WS_MEMSTATS_H
+
+#include "Wippersnapper.h"
+
+// The periodic report is published to a topic the stock broker doesn't
+// define, add e.g. -DWS_MEMSTATS_INTERVAL_MS=300000 to the build flags to
+// enable it. The report made before a WDT reset is always published.
+#ifndef WS_MEMSTATS_INTERVAL_MS
+#define WS_MEMSTATS_INTERVAL_MS                                                \
+  0 ///< Time between memory usage reports, in milliseconds, 0 disables them
+#endif
+#define WS_MEMSTATS_SAMPLE_MS                                                  \
+  1000 ///< Time between samples of the free heap, in milliseconds
+#define WS_MEMSTATS_STACK_PAINT                                                \
+  0xA5A5A5A5 ///< Fills the unused stack, to find its high-water mark
+
+class Wippersnapper;
+
+/**************************************************************************/
+/*!
+    @brief  Heap, stack and PSRAM high-water tracking.
+
+            The free heap is sampled from the run() loop, so the lowest
+            free heap seen is known on platforms which don't track it.
+            The stack high-water mark is the least free stack the loop
+            task has had, read from FreeRTOS on ESP32, from the cont
+            stack guard on ESP8266, and by painting the stack on RP2040.
+*/
+/**************************************************************************/
+class ws_memstats {
+public:
+  ws_memstats();
+  ~ws_memstats();
+
+  void update();
+  void report(bool isHalted = false);
+
+  uint32_t getMinFreeHeap();
+  int32_t getMinFreeStack();
+
+private:
+  void sample();
+  void paintStack();
+
+  uint32_t _minFreeHeap = UINT32_MAX; ///< Lowest free heap seen, in bytes
+  unsigned long _prvSample = 0;       ///< When the heap was last sampled, ms
+  unsigned long _prvReport = 0;       ///< When usage was last reported, ms
+};
+extern Wippersnapper WS;
+
+#endif // WS_MEMSTATS_H
@@ -0,0 +1,106 @@
+/*!
+ * @file ws_profiler.cpp
+ *
+ * Measures the time spent within each stage of the run() loop and
+ * publishes the timings to the device's diagnostics topic.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * Copyright (c) Brent Rubell 2023 for Adafruit Industries.
+ *
+ * MIT license, all text here must be included in any redistribution.
+ *
+ */
+#include "ws_profiler.h"
+
+#ifdef WS_PROFILER
+
+/** Names of the stages, as reported */
+static const char *stageNames[WS_LOOP_STAGE_COUNT] = {
+    "net", "ping", "packets", "digital", "analog", "i2c", "ds18x20", "loop"};
+
+/**************************************************************************/
+/*!
+    @brief    Creates a loop profiler with empty timings.
+*/
+/**************************************************************************/
+ws_profiler::ws_profiler() { reset(); }
+
+/**************************************************************************/
+/*!
+    @brief    Destructor for the loop profiler.
+*/
+/**************************************************************************/
+ws_profiler::~ws_profiler() {}
+
+/**************************************************************************/
+/*!
+    @brief    Records the time taken by a stage. Once the whole loop has
+              been recorded, reports the timings if WS_PROFILER_INTERVAL_MS
+              has passed.
+    @param    stage
+              The stage timed.
+    @param    duration
+              Length of the stage, in microseconds.
+*/
+/**************************************************************************/
+void ws_profiler::record(ws_loop_stage_t stage, uint32_t duration) {
+  _stats[stage].record(duration);
+  if (stage != WS_LOOP_STAGE_LOOP ||
+      millis() - _prvReport < WS_PROFILER_INTERVAL_MS)
+    return;
+  report();
+  reset();
+}
+
+/**************************************************************************/
+/*!
+    @brief    Publishes the loop frequency and each stage's
+              min/avg/max/p99, in microseconds, to the diagnostics topic.
+*/
+/**************************************************************************/
+void ws_profiler::report() {
+  char msg[WS_MQTT_MAX_PAYLOAD_SIZE];
+  unsigned long elapsed = millis() - _prvReport;
+  uint32_t loops = _stats[WS_LOOP_STAGE_LOOP].getCount();
+  int len = snprintf(msg, sizeof(msg), "{\"hz\":%lu,\"loops\":%lu",
+                     elapsed > 0 ? (unsigned long)(loops * 1000ULL / elapsed)
+                                 : 0UL,
+                     (unsigned long)loops);
+  for (uint8_t i = 0; i < WS_LOOP_STAGE_COUNT && len < (int)sizeof(msg);
+       i++) {
+    if (_stats[i].getCount() == 0)
+      continue;
+    len += snprintf(msg + len, sizeof(msg) - len, ",\"%s\":", stageNames[i]);
+    if (len < (int)sizeof(msg))
+      len += _stats[i].print(msg + len, sizeof(msg) - len);
+  }
+  if (len >= (int)sizeof(msg) - 1) {
+    WS_DEBUG_PRINTLN("ERROR: Loop profile does not fit the payload!");
+    return;
+  }
+  msg[len++] = '}';
+  msg[len] = '\0';
+
+  WS_DEBUG_PRINT("Loop profile: ");
+  WS_DEBUG_PRINTLN(msg);
+  if (WS._topic_diagnostics == NULL)
+    return;
+  WS.publish(WS._topic_diagnostics, (uint8_t *)msg, len, 0,
+             WS_PUBLISH_PRIORITY_LOW);
+}
+
+/**************************************************************************/
+/*!
+    @brief    Clears the timings, starting a new report interval.
+*/
+/**************************************************************************/
+void ws_profiler::reset() {
+  for (uint8_t i = 0; i < WS_LOOP_STAGE_COUNT; i++)
+    _stats[i].reset();
+  _prvReport = millis();
+}
+
+#endif // WS_PROFILER
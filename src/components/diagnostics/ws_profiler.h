@@ -0,0 +1,63 @@
+/*!
+ * @file ws_profiler.h
+ *
+ * Measures the time spent within each stage of the run() loop and
+ * publishes the timings to the device's diagnostics topic.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * Copyright (c) Brent Rubell 2023 for Adafruit Industries.
+ *
+ * MIT license, all text here must be included in any redistribution.
+ *
+ */
+#ifndef WS_PROFILER_H
+#define WS_PROFILER_H
+
+#include "Wippersnapper.h"
+#include "ws_histogram.h"
+#include "ws_loop_stages.h"
+
+#ifdef WS_PROFILER
+
+#ifndef WS_PROFILER_INTERVAL_MS
+#define WS_PROFILER_INTERVAL_MS                                                \
+  60000 ///< Time between loop profile reports, in milliseconds
+#endif
+
+class Wippersnapper;
+
+/**************************************************************************/
+/*!
+    @brief  Main loop stage profiler.
+
+            Each stage's duration, in microseconds, as timed by
+            ws_loop_stages, is added to a ws_histogram, so the 99th
+            percentile can be estimated without keeping the samples.
+            Every WS_PROFILER_INTERVAL_MS the min/avg/max/p99 of each
+            stage and the loop frequency are published to the diagnostics
+            topic, then the counters are cleared.
+*/
+/**************************************************************************/
+class ws_profiler {
+public:
+  ws_profiler();
+  ~ws_profiler();
+
+  void record(ws_loop_stage_t stage, uint32_t duration);
+
+private:
+  void report();
+  void reset();
+
+  ws_histogram _stats[WS_LOOP_STAGE_COUNT]; ///< Stage timings
+
+  unsigned long _prvReport = 0; ///< When the timings were last reported, ms
+};
+extern Wippersnapper WS;
+
+#endif // WS_PROFILER
+
+#endif // WS_PROFILER_H
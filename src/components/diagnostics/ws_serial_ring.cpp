@@ -0,0 +1,125 @@
+/*!
+ * @file ws_serial_ring.cpp
+ *
+ * RAM ring buffer of binary records bound for the serial port, shared by
+ * the tokenized debug log and the execution tracer.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * Copyright (c) Brent Rubell 2023 for Adafruit Industries.
+ *
+ * MIT license, all text here must be included in any redistribution.
+ *
+ */
+#include "ws_serial_ring.h"
+#include "Wippersnapper.h"
+
+/**************************************************************************/
+/*!
+    @brief    Creates an empty ring buffer.
+    @param    buffer
+              Storage for the records.
+    @param    size
+              Size of the storage, in bytes. One byte is left unused to
+              tell a full buffer from an empty one.
+*/
+/**************************************************************************/
+ws_serial_ring::ws_serial_ring(uint8_t *buffer, size_t size) {
+  _buffer = buffer;
+  _size = size;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Destructor for the ring buffer.
+*/
+/**************************************************************************/
+ws_serial_ring::~ws_serial_ring() {}
+
+/**************************************************************************/
+/*!
+    @brief    Adds a record to the ring buffer. The record is dropped, and
+              counted, if the buffer is full.
+    @param    record
+              The record, starting with its sync byte.
+    @param    len
+              Length of the record, in bytes.
+    @returns  True if the record was added, False if it was dropped.
+*/
+/**************************************************************************/
+bool ws_serial_ring::push(const uint8_t *record, size_t len) {
+  size_t used = (_head + _size - _tail) % _size;
+  if (len > _size - 1 - used) {
+    _dropped++;
+    return false;
+  }
+  for (size_t i = 0; i < len; i++) {
+    _buffer[_head] = record[i];
+    _head = (_head + 1) % _size;
+  }
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Reads a byte of the oldest record.
+    @param    offset
+              Offset of the byte within the record.
+    @returns  The byte.
+*/
+/**************************************************************************/
+uint8_t ws_serial_ring::peek(size_t offset) {
+  return _buffer[(_tail + offset) % _size];
+}
+
+/**************************************************************************/
+/*!
+    @brief    Writes the oldest record out to the serial port.
+    @param    len
+              Length of the record, in bytes.
+*/
+/**************************************************************************/
+void ws_serial_ring::writeOut(size_t len) {
+  // the record may wrap around the end of the buffer
+  size_t first = min(len, _size - _tail);
+  WS_PRINTER.write(_buffer + _tail, first);
+  if (first < len)
+    WS_PRINTER.write(_buffer, len - first);
+  _tail = (_tail + len) % _size;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Writes out as many whole records as the serial port can
+              take without blocking. Records are never split, so text
+              printed between calls can't land inside one.
+*/
+/**************************************************************************/
+void ws_serial_ring::drain() {
+  while (_tail != _head) {
+    size_t len = recordLength();
+    if ((size_t)WS_PRINTER.availableForWrite() < len)
+      return;
+    writeOut(len);
+  }
+  // buffer is empty, tell the host about any records lost
+  if (_dropped > 0) {
+    uint32_t dropped = _dropped;
+    _dropped = 0;
+    recordDropped(dropped);
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief    Writes out every record, blocking until done. Used before
+              the device halts.
+*/
+/**************************************************************************/
+void ws_serial_ring::flush() {
+  while (_tail != _head)
+    writeOut(recordLength());
+  WS_PRINTER.flush();
+}
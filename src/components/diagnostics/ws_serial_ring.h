@@ -0,0 +1,75 @@
+/*!
+ * @file ws_serial_ring.h
+ *
+ * RAM ring buffer of binary records bound for the serial port, shared by
+ * the tokenized debug log and the execution tracer.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * Copyright (c) Brent Rubell 2023 for Adafruit Industries.
+ *
+ * MIT license, all text here must be included in any redistribution.
+ *
+ */
+#ifndef WS_SERIAL_RING_H
+#define WS_SERIAL_RING_H
+
+// Included by ws_log.h and ws_trace.h from within Wippersnapper.h, so the
+// base class must not depend on it
+#include <Arduino.h>
+
+/**************************************************************************/
+/*!
+    @brief  Ring buffer of binary records written out to the serial port
+            without blocking.
+
+            Each record starts with a sync byte, so a host tool can pick
+            it out of the text printed between records. Records which
+            don't fit the buffer are dropped and counted, and the count
+            is recorded once the buffer has been written out. Subclasses
+            give the length of the oldest record, and the record holding
+            the count.
+*/
+/**************************************************************************/
+class ws_serial_ring {
+public:
+  ws_serial_ring(uint8_t *buffer, size_t size);
+  virtual ~ws_serial_ring();
+
+  void drain();
+  void flush();
+
+protected:
+  bool push(const uint8_t *record, size_t len);
+  uint8_t peek(size_t offset);
+
+  /**********************************************************************/
+  /*!
+      @brief  Returns the length of the oldest record, using peek().
+      @returns The record's length, in bytes.
+  */
+  /**********************************************************************/
+  virtual size_t recordLength() = 0;
+
+  /**********************************************************************/
+  /*!
+      @brief  Adds a record counting the records which were dropped.
+      @param  dropped
+              Number of records dropped.
+  */
+  /**********************************************************************/
+  virtual void recordDropped(uint32_t dropped) = 0;
+
+private:
+  void writeOut(size_t len);
+
+  uint8_t *_buffer;      ///< Storage for the records, owned by the subclass
+  size_t _size;          ///< Size of the storage, in bytes
+  size_t _head = 0;      ///< Where the next record is added
+  size_t _tail = 0;      ///< Where the oldest record starts
+  uint32_t _dropped = 0; ///< Records dropped while the buffer was full
+};
+
+#endif // WS_SERIAL_RING_H
@@ -0,0 +1,100 @@
+/*!
+ * @file ws_trace.cpp
+ *
+ * Records timed spans around the run() loop's stages, protobuf encoding
+ * and decoding, I2C devices, publishes and display updates, and streams
+ * them over the serial port as compact binary records. tools/trace
+ * turns the stream into a timeline for Perfetto or chrome://tracing.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * Copyright (c) Brent Rubell 2023 for Adafruit Industries.
+ *
+ * MIT license, all text here must be included in any redistribution.
+ *
+ */
+#include "ws_trace.h"
+
+#ifdef WS_TRACE
+
+/**************************************************************************/
+/*!
+    @brief    Creates an execution tracer with an empty ring buffer.
+*/
+/**************************************************************************/
+ws_trace::ws_trace() : ws_serial_ring(_buffer, sizeof(_buffer)) {}
+
+/**************************************************************************/
+/*!
+    @brief    Destructor for the execution tracer.
+*/
+/**************************************************************************/
+ws_trace::~ws_trace() {}
+
+/**************************************************************************/
+/*!
+    @brief    Adds a span to the ring buffer.
+    @param    event
+              The event traced, a ws_loop_stage_t, a ws_trace_event_t or
+              WS_TRACE_DROPPED.
+    @param    start
+              When the span began, in microseconds.
+    @param    duration
+              Length of the span, in microseconds.
+*/
+/**************************************************************************/
+void ws_trace::record(uint8_t event, uint32_t start, uint32_t duration) {
+  uint8_t rec[WS_TRACE_RECORD_SIZE];
+  rec[0] = WS_TRACE_SYNC;
+  rec[1] = event;
+  for (uint8_t i = 0; i < 4; i++) {
+    rec[2 + i] = (uint8_t)(start >> (8 * i));
+    rec[6 + i] = (uint8_t)(duration >> (8 * i));
+  }
+  push(rec, sizeof(rec));
+}
+
+/**************************************************************************/
+/*!
+    @brief    Returns the length of the oldest record, all records are the
+              same length.
+    @returns  WS_TRACE_RECORD_SIZE.
+*/
+/**************************************************************************/
+size_t ws_trace::recordLength() { return WS_TRACE_RECORD_SIZE; }
+
+/**************************************************************************/
+/*!
+    @brief    Marks where records were lost on the timeline.
+    @param    dropped
+              Number of records dropped.
+*/
+/**************************************************************************/
+void ws_trace::recordDropped(uint32_t dropped) {
+  record(WS_TRACE_DROPPED, micros(), dropped);
+}
+
+/**************************************************************************/
+/*!
+    @brief    Starts a span.
+    @param    event
+              The event traced.
+*/
+/**************************************************************************/
+ws_trace_scope::ws_trace_scope(ws_trace_event_t event) {
+  _event = event;
+  _start = micros();
+}
+
+/**************************************************************************/
+/*!
+    @brief    Ends the span, and records it.
+*/
+/**************************************************************************/
+ws_trace_scope::~ws_trace_scope() {
+  WS._trace->record(_event, _start, micros() - _start);
+}
+
+#endif // WS_TRACE
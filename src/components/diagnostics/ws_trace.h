@@ -0,0 +1,105 @@
+/*!
+ * @file ws_trace.h
+ *
+ * Records timed spans around the run() loop's stages, protobuf encoding
+ * and decoding, I2C devices, publishes and display updates, and streams
+ * them over the serial port as compact binary records. tools/trace
+ * turns the stream into a timeline for Perfetto or chrome://tracing.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * Copyright (c) Brent Rubell 2023 for Adafruit Industries.
+ *
+ * MIT license, all text here must be included in any redistribution.
+ *
+ */
+#ifndef WS_TRACE_H
+#define WS_TRACE_H
+
+#include "Wippersnapper.h"
+#include "ws_loop_stages.h"
+#include "ws_serial_ring.h"
+
+#ifdef WS_TRACE
+
+#ifndef WS_TRACE_BUFFER_RECORDS
+#define WS_TRACE_BUFFER_RECORDS                                                \
+  200 ///< Number of records the ring buffer holds
+#endif
+#define WS_TRACE_RECORD_SIZE 10 ///< Sync, event, start and duration bytes
+#define WS_TRACE_SYNC 0x1F      ///< Starts each record in the serial output
+#define WS_TRACE_DROPPED 0xFF   ///< Event of a record counting lost records
+
+/** Events traced besides the run() loop's stages, whose ws_loop_stage_t
+ * values come first */
+typedef enum {
+  /** Decoding a message, and handling it */
+  WS_TRACE_EVENT_DECODE = WS_LOOP_STAGE_COUNT,
+  WS_TRACE_EVENT_ENCODE,     ///< Encoding a message
+  WS_TRACE_EVENT_I2C_DEVICE, ///< Polling one I2C device
+  WS_TRACE_EVENT_PUBLISH,    ///< publish()
+  WS_TRACE_EVENT_DISPLAY,    ///< Adding text to the display's terminal
+  WS_TRACE_EVENT_COUNT,      ///< Number of events
+} ws_trace_event_t;
+
+class Wippersnapper;
+
+/**************************************************************************/
+/*!
+    @brief  Execution tracer.
+
+            Each span is added to a ws_serial_ring when it ends, which
+            run() drains. The run() loop's stages are timed by
+            ws_loop_stages, other spans by a ws_trace_scope.
+
+            Record layout, little-endian:
+            [WS_TRACE_SYNC][event u8][start micros() u32][duration us u32]
+            A record whose event is WS_TRACE_DROPPED holds the number of
+            records lost in place of its duration.
+*/
+/**************************************************************************/
+class ws_trace : public ws_serial_ring {
+public:
+  ws_trace();
+  ~ws_trace();
+
+  void record(uint8_t event, uint32_t start, uint32_t duration);
+
+protected:
+  size_t recordLength();
+  void recordDropped(uint32_t dropped);
+
+private:
+  /** Storage for the ring buffer */
+  uint8_t _buffer[WS_TRACE_BUFFER_RECORDS * WS_TRACE_RECORD_SIZE];
+};
+
+/**************************************************************************/
+/*!
+    @brief  Traces a span from its creation until it goes out of scope.
+*/
+/**************************************************************************/
+class ws_trace_scope {
+public:
+  ws_trace_scope(ws_trace_event_t event);
+  ~ws_trace_scope();
+
+private:
+  ws_trace_event_t _event; ///< The event traced
+  uint32_t _start;         ///< When the span began, in us
+};
+extern Wippersnapper WS;
+
+#define WS_TRACE_CONCAT(a, b) a##b ///< Pastes two tokens together
+#define WS_TRACE_NAME(line)                                                    \
+  WS_TRACE_CONCAT(_wsTraceScope, line) ///< Names a scope by its line
+#define WS_TRACE_SCOPE(event)                                                  \
+  ws_trace_scope WS_TRACE_NAME(__LINE__)(event) ///< Traces the enclosing scope
+#else
+#define WS_TRACE_SCOPE(event)                                                  \
+  {} ///< Traces the enclosing scope
+#endif // WS_TRACE
+
+#endif // WS_TRACE_H
@@ -122,6 +122,10 @@ void Wippersnapper_DigitalGPIO::initDigitalPin(
       if (_digital_input_pins[i].period == -1L) {
         _digital_input_pins[i].pinName = pinName;
         _digital_input_pins[i].period = periodMs;
+        // stagger the first reading, see getPublishPhase()
+        if (periodMs > 0)
+          _digital_input_pins[i].prvPeriod =
+              millis() - periodMs + WS.getPublishOffset(periodMs);
         break;
       }
     }
@@ -241,8 +245,8 @@ void Wippersnapper_DigitalGPIO::processDigitalInputs() {
       if (curTime - _digital_input_pins[i].prvPeriod >
               _digital_input_pins[i].period &&
           _digital_input_pins[i].period != 0L) {
-        WS_DEBUG_PRINT("Executing periodic event on D");
-        WS_DEBUG_PRINTLN(_digital_input_pins[i].pinName);
+        WS_LOG_DEBUG(DIGITAL, "Executing periodic event on D%u",
+                     _digital_input_pins[i].pinName);
         // read the pin
         int pinVal = digitalReadSvc(_digital_input_pins[i].pinName);
 
@@ -257,14 +261,12 @@ void Wippersnapper_DigitalGPIO::processDigitalInputs() {
         wippersnapper_signal_v1_CreateSignalRequest _outgoingSignalMsg =
             wippersnapper_signal_v1_CreateSignalRequest_init_zero;
 
-        WS_DEBUG_PRINT("Encoding...")
         // Create and encode a pinEvent message
         if (!WS.encodePinEvent(&_outgoingSignalMsg,
                                _digital_input_pins[i].pinName, pinVal)) {
           WS_DEBUG_PRINTLN("ERROR: Unable to encode pinEvent");
           break;
         }
-        WS_DEBUG_PRINTLN("Encoded!")
 
         // Obtain size and only write out buffer to end
         size_t msgSz;
@@ -272,9 +274,9 @@ void Wippersnapper_DigitalGPIO::processDigitalInputs() {
                             wippersnapper_signal_v1_CreateSignalRequest_fields,
                             &_outgoingSignalMsg);
 
-        WS_DEBUG_PRINT("Publishing pinEvent...");
         WS.publish(WS._topic_signal_device, WS._buffer_outgoing, msgSz, 1);
-        WS_DEBUG_PRINTLN("Published!");
+        WS_LOG_DEBUG(DIGITAL, "Published pinEvent on D%u",
+                     _digital_input_pins[i].pinName);
 
         // reset the digital pin
         _digital_input_pins[i].prvPeriod = curTime;
@@ -283,8 +285,8 @@ void Wippersnapper_DigitalGPIO::processDigitalInputs() {
         int pinVal = digitalReadSvc(_digital_input_pins[i].pinName);
         // only send on-change
         if (pinVal != _digital_input_pins[i].prvPinVal) {
-          WS_DEBUG_PRINT("Executing state-based event on D");
-          WS_DEBUG_PRINTLN(_digital_input_pins[i].pinName);
+          WS_LOG_DEBUG(DIGITAL, "Executing state-based event on D%u",
+                       _digital_input_pins[i].pinName);
 
 #ifdef USE_DISPLAY
           char buffer[100];
@@ -297,23 +299,21 @@ void Wippersnapper_DigitalGPIO::processDigitalInputs() {
           wippersnapper_signal_v1_CreateSignalRequest _outgoingSignalMsg =
               wippersnapper_signal_v1_CreateSignalRequest_init_zero;
 
-          WS_DEBUG_PRINT("Encoding pinEvent...");
           // Create and encode a pinEvent message
           if (!WS.encodePinEvent(&_outgoingSignalMsg,
                                  _digital_input_pins[i].pinName, pinVal)) {
             WS_DEBUG_PRINTLN("ERROR: Unable to encode pinEvent");
             break;
           }
-          WS_DEBUG_PRINTLN("Encoded!");
 
           // Obtain size and only write out buffer to end
           size_t msgSz;
           pb_get_encoded_size(
               &msgSz, wippersnapper_signal_v1_CreateSignalRequest_fields,
               &_outgoingSignalMsg);
-          WS_DEBUG_PRINT("Publishing pinEvent...");
           WS.publish(WS._topic_signal_device, WS._buffer_outgoing, msgSz, 1);
-          WS_DEBUG_PRINTLN("Published!");
+          WS_LOG_DEBUG(DIGITAL, "Published pinEvent on D%u",
+                       _digital_input_pins[i].pinName);
 
           // set the pin value in the digital pin object for comparison on next
           // run
@@ -30,14 +30,26 @@ ws_ds18x20::ws_ds18x20() {}
 /*************************************************************/
 ws_ds18x20::~ws_ds18x20() {
   // delete DallasTemp sensors and release onewire buses
-  for (int idx = 0; idx < _ds18xDrivers.size(); idx++) {
-    delete _ds18xDrivers[idx]->dallasTempObj;
-    delete _ds18xDrivers[idx]->oneWire;
-  }
+  for (int idx = 0; idx < _ds18xDrivers.size(); idx++)
+    releaseDS18x20(_ds18xDrivers[idx]);
   // remove all elements
   _ds18xDrivers.clear();
 }
 
+/*************************************************************/
+/*!
+    @brief    Releases a ds18x20Obj, its DallasTemperature
+              object and its OneWire bus back to their pools.
+    @param    obj
+              Pointer to a ds18x20Obj.
+*/
+/*************************************************************/
+void ws_ds18x20::releaseDS18x20(ds18x20Obj *obj) {
+  _dallasTempPool.destroy(obj->dallasTempObj);
+  _oneWirePool.destroy(obj->oneWire);
+  _objPool.destroy(obj);
+}
+
 /********************************************************************/
 /*!
     @brief    Initializes a DS18x20 sensor using a
@@ -54,10 +66,10 @@ bool ws_ds18x20::addDS18x20(
   bool is_success = false;
 
   // init. new ds18x20 object
-  ds18x20Obj *newObj = new ds18x20Obj();
+  ds18x20Obj *newObj = _objPool.create();
   char *oneWirePin = msgDs18x20InitReq->onewire_pin + 1;
-  newObj->oneWire = new OneWire(atoi(oneWirePin));
-  newObj->dallasTempObj = new DallasTemperature(newObj->oneWire);
+  newObj->oneWire = _oneWirePool.create((uint8_t)atoi(oneWirePin));
+  newObj->dallasTempObj = _dallasTempPool.create(newObj->oneWire);
   newObj->dallasTempObj->begin();
   // attempt to obtain sensor address
   if (newObj->dallasTempObj->getAddress(newObj->dallasTempAddr, 0)) {
@@ -74,6 +86,12 @@ bool ws_ds18x20::addDS18x20(
           (long)msgDs18x20InitReq->i2c_device_properties[i].sensor_period *
           1000;
     }
+    // stagger the first reading, see getPublishPhase()
+    long periodMs = newObj->sensorPropertiesCount > 0
+                        ? newObj->sensorProperties[0].sensor_period
+                        : 0L;
+    newObj->sensorPeriodPrv =
+        millis() - periodMs + WS.getPublishOffset(periodMs);
     // set pin
     strcpy(newObj->onewire_pin, msgDs18x20InitReq->onewire_pin);
     // add the new ds18x20 driver to vec.
@@ -81,6 +99,7 @@ bool ws_ds18x20::addDS18x20(
     is_success = true;
   } else {
     WS_DEBUG_PRINTLN("Failed to find DSx sensor on specified pin.");
+    releaseDS18x20(newObj);
   }
 
   // fill and publish the initialization response back to the broker
@@ -116,8 +135,7 @@ bool ws_ds18x20::addDS18x20(
   pb_get_encoded_size(&msgSz, wippersnapper_signal_v1_Ds18x20Response_fields,
                       &msgInitResp);
   WS_DEBUG_PRINT("-> DS18x Init Response...");
-  WS._mqtt->publish(WS._topic_signal_ds18_device, WS._buffer_outgoing, msgSz,
-                    1);
+  WS.publish(WS._topic_signal_ds18_device, WS._buffer_outgoing, msgSz, 1);
   WS_DEBUG_PRINTLN("Published!");
 
   return is_success;
@@ -135,19 +153,19 @@ bool ws_ds18x20::addDS18x20(
 void ws_ds18x20::deleteDS18x20(
     wippersnapper_ds18x20_v1_Ds18x20DeInitRequest *msgDS18x20DeinitReq) {
   // Loop thru vector of drivers to find the unique address
-  for (int idx = 0; idx < _ds18xDrivers.size(); idx++) {
-    if (strcmp(_ds18xDrivers[idx]->onewire_pin,
-               msgDS18x20DeinitReq->onewire_pin) == 0) {
+  std::vector<ds18x20Obj *>::iterator iter = _ds18xDrivers.begin();
+  while (iter != _ds18xDrivers.end()) {
+    if (strcmp((*iter)->onewire_pin, msgDS18x20DeinitReq->onewire_pin) == 0) {
       WS_DEBUG_PRINT("Deleting OneWire instance on pin ");
       WS_DEBUG_PRINTLN(msgDS18x20DeinitReq->onewire_pin);
-      delete _ds18xDrivers[idx]
-          ->dallasTempObj; // delete dallas temp instance on pin
-      delete _ds18xDrivers[idx]
-          ->oneWire; // delete OneWire instance on pin and release pin for reuse
-      _ds18xDrivers.erase(_ds18xDrivers.begin() +
-                          idx); // erase vector and re-allocate
+      // delete dallas temp and OneWire instances, releasing the pin for reuse
+      releaseDS18x20(*iter);
+      iter = _ds18xDrivers.erase(iter);
+    } else {
+      ++iter;
     }
   }
+  WS.printHeapStats();
 
 #ifdef USE_DISPLAY
   char buffer[100];
@@ -186,6 +204,9 @@ void ws_ds18x20::update() {
       // has sensor_period elapsed?
       if (curTime - (*iter)->sensorPeriodPrv >
           (*iter)->sensorProperties[i].sensor_period) {
+        // defer the reading until the publish budget allows it
+        if (!WS._mqttBudget->isAvailable(WS_PUBLISH_PRIORITY_LOW))
+          return;
         // issue global temperature request to all DS sensors
         WS_DEBUG_PRINTLN("Requesting temperature..");
         (*iter)->dallasTempObj->requestTemperatures();
@@ -267,25 +288,21 @@ void ws_ds18x20::update() {
             return;
           }
 
-          WS_DEBUG_PRINTLN(
+          WS_LOG_DEBUG(
+              DS18X20,
               "DEBUG: msgDS18x20Response sensor_event message contents:");
           for (int i = 0;
                i <
                msgDS18x20Response.payload.resp_ds18x20_event.sensor_event_count;
                i++) {
-            WS_DEBUG_PRINT("sensor_event[#]: ");
-            WS_DEBUG_PRINTLN(i);
-            WS_DEBUG_PRINT("\tOneWire Bus: ");
-            WS_DEBUG_PRINTLN(
-                msgDS18x20Response.payload.resp_ds18x20_event.onewire_pin);
-            WS_DEBUG_PRINT("\tsensor_event type: ");
-            WS_DEBUG_PRINTLN(
-                msgDS18x20Response.payload.resp_ds18x20_event.sensor_event[i]
-                    .type);
-            WS_DEBUG_PRINT("\tsensor_event value: ");
-            WS_DEBUG_PRINTLN(
-                msgDS18x20Response.payload.resp_ds18x20_event.sensor_event[i]
-                    .value);
+            wippersnapper_i2c_v1_SensorEvent *sensorEvent =
+                &msgDS18x20Response.payload.resp_ds18x20_event.sensor_event[i];
+            WS_LOG_DEBUG(
+                DS18X20,
+                "sensor_event[#]: %d\n\tOneWire Bus: %s\n\tsensor_event "
+                "type: %d\n\tsensor_event value: %f",
+                i, msgDS18x20Response.payload.resp_ds18x20_event.onewire_pin,
+                (int)sensorEvent->type, sensorEvent->value);
           }
 
           // Publish I2CResponse msg
@@ -293,12 +310,12 @@ void ws_ds18x20::update() {
           pb_get_encoded_size(&msgSz,
                               wippersnapper_signal_v1_Ds18x20Response_fields,
                               &msgDS18x20Response);
-          WS_DEBUG_PRINT("PUBLISHING -> msgDS18x20Response Event Message...");
-          if (!WS._mqtt->publish(WS._topic_signal_ds18_device,
-                                 WS._buffer_outgoing, msgSz, 1)) {
+          if (!WS.publish(WS._topic_signal_ds18_device, WS._buffer_outgoing,
+                          msgSz, 1, WS_PUBLISH_PRIORITY_LOW)) {
             return;
           };
-          WS_DEBUG_PRINTLN("PUBLISHED!");
+          WS_LOG_DEBUG(DS18X20,
+                       "PUBLISHED -> msgDS18x20Response Event Message");
 #ifdef USE_DISPLAY
           WS._ui_helper->add_text_to_terminal(buffer);
 #endif
@@ -17,10 +17,13 @@
 #define WIPPERSNAPPER_DS18X20_H
 
 #include "Wippersnapper.h"
+#include "components/pool/ws_pool.h"
 
 #include <Adafruit_Sensor.h>
 #include <DallasTemperature.h>
 
+#define DS18X20_MAX_SENSORS 8 ///< Maximum number of pooled DS18x20 sensors
+
 /** DS18x20 Object */
 struct ds18x20Obj {
   OneWire *
@@ -59,6 +62,13 @@ public:
 private:
   std::vector<ds18x20Obj *>
       _ds18xDrivers; ///< Vec. of ptrs. to ds18x driver objects
+  void releaseDS18x20(ds18x20Obj *obj);
+  ws_pool<ds18x20Obj, DS18X20_MAX_SENSORS>
+      _objPool; ///< Storage for ds18x20Obj structs
+  ws_pool<OneWire, DS18X20_MAX_SENSORS>
+      _oneWirePool; ///< Storage for OneWire buses
+  ws_pool<DallasTemperature, DS18X20_MAX_SENSORS>
+      _dallasTempPool; ///< Storage for DallasTemperature objects
 };
 extern Wippersnapper WS;
 
@@ -21,6 +21,9 @@
 #define WIRE Wire
 #endif
 
+ws_block_pool<I2C_DRIVER_POOL_BLOCK_SIZE, I2C_DRIVER_POOL_SIZE>
+    i2cDriverPool; ///< Storage for I2C driver objects
+
 /***************************************************************************************************************/
 /*!
     @brief    Creates a new WipperSnapper I2C component.
@@ -57,6 +60,11 @@ WipperSnapper_Component_I2C::WipperSnapper_Component_I2C(
   digitalWrite(NEOPIXEL_I2C_POWER, HIGH);
 #endif
 
+  _pinSCL = msgInitRequest->i2c_pin_scl;
+  _pinSDA = msgInitRequest->i2c_pin_sda;
+  // the wiring and pull-ups may not allow the devices' fastest clock
+  _busFrequencyMax = msgInitRequest->i2c_frequency;
+
   // Enable pullups on SCL, SDA
   pinMode(msgInitRequest->i2c_pin_scl, INPUT_PULLUP);
   pinMode(msgInitRequest->i2c_pin_sda, INPUT_PULLUP);
@@ -82,23 +90,32 @@ WipperSnapper_Component_I2C::WipperSnapper_Component_I2C(
     } else {
       _isInit = true; // if the peripheral was configured incorrectly
     }
-    _i2c->setClock(50000);
+    _busFrequencyDefault = 50000;
+    _i2c->setClock(_busFrequencyDefault);
 #elif defined(ARDUINO_ARCH_ESP8266)
     _i2c = new TwoWire();
     _i2c->begin(msgInitRequest->i2c_pin_sda, msgInitRequest->i2c_pin_scl);
-    _i2c->setClock(50000);
+    _busFrequencyDefault = 50000;
+    _i2c->setClock(_busFrequencyDefault);
     _isInit = true;
 #elif defined(ARDUINO_ARCH_RP2040)
     _i2c = &WIRE;
     _i2c->begin();
+    _busFrequencyDefault = I2C_FREQ_STANDARD_MODE;
     _isInit = true;
 #else
     // SAMD
     _i2c = new TwoWire(&PERIPH_WIRE, msgInitRequest->i2c_pin_sda,
                        msgInitRequest->i2c_pin_scl);
     _i2c->begin();
+    _busFrequencyDefault = I2C_FREQ_STANDARD_MODE;
     _isInit = true;
 #endif
+    if (_busFrequencyMax != 0 && _busFrequencyDefault > _busFrequencyMax) {
+      _busFrequencyDefault = _busFrequencyMax;
+      _i2c->setClock(_busFrequencyDefault);
+    }
+    _busFrequency = _busFrequencyDefault;
 
     // set i2c obj. properties
     _portNum = msgInitRequest->i2c_port_number;
@@ -112,8 +129,12 @@ WipperSnapper_Component_I2C::WipperSnapper_Component_I2C(
 */
 /*************************************************************/
 WipperSnapper_Component_I2C::~WipperSnapper_Component_I2C() {
+  for (WipperSnapper_I2C_Driver *driver : drivers)
+    delete driver;
+  drivers.clear();
   _portNum = 100; // Invalid = 100
   _isInit = false;
+  invalidateScanCache();
 }
 
 /*****************************************************/
@@ -134,22 +155,349 @@ wippersnapper_i2c_v1_BusResponse WipperSnapper_Component_I2C::getBusStatus() {
   return _busStatusResponse;
 }
 
+/*****************************************************/
+/*!
+    @brief    Invalidates the cached bus scan result, forcing
+              the next call to scanAddresses() to probe the bus.
+*/
+/*****************************************************/
+void WipperSnapper_Component_I2C::invalidateScanCache() {
+  _isScanCached = false;
+}
+
+/*****************************************************/
+/*!
+    @brief    Returns the average time taken by a single
+              address probe during the most recent scan.
+    @returns  Time per probe, in microseconds.
+*/
+/*****************************************************/
+uint32_t WipperSnapper_Component_I2C::getScanProbeTime() {
+  return _scanProbeTimeUs;
+}
+
+/*****************************************************/
+/*!
+    @brief    Checks if SCL or SDA is held low while the
+              bus should be idle.
+    @returns  True if either line is stuck low, False otherwise.
+*/
+/*****************************************************/
+bool WipperSnapper_Component_I2C::isBusLineStuck() {
+  return (digitalRead(_pinSCL) == LOW) || (digitalRead(_pinSDA) == LOW);
+}
+
+/*****************************************************/
+/*!
+    @brief    Returns the number of bus recoveries performed.
+    @returns  Number of bus recoveries.
+*/
+/*****************************************************/
+uint32_t WipperSnapper_Component_I2C::getBusRecoveryCount() {
+  return _busRecoveryCount;
+}
+
+/*****************************************************/
+/*!
+    @brief    Returns the bus' current SCL frequency.
+    @returns  SCL frequency, in Hz.
+*/
+/*****************************************************/
+uint32_t WipperSnapper_Component_I2C::getBusFrequency() {
+  return _busFrequency;
+}
+
+/************************************************************************/
+/*!
+    @brief    Selects the highest SCL frequency which is safe for every
+              device attached to the bus, capped at the frequency
+              requested when the bus was initialized, and extends the I2C
+              timeout if any device requires clock stretching.
+*/
+/************************************************************************/
+void WipperSnapper_Component_I2C::updateBusFrequency() {
+  uint32_t freq;
+  bool needsStretch = false;
+#ifdef I2C_PER_TRANSACTION_CLOCK
+  // Run at the fastest device's clock, slower devices are handled in update()
+  freq = 0;
+#else
+  freq = I2C_FREQ_FAST_MODE;
+#endif
+  for (WipperSnapper_I2C_Driver *driver : drivers) {
+#ifdef I2C_PER_TRANSACTION_CLOCK
+    if (driver->getMaxBusFrequency() > freq)
+      freq = driver->getMaxBusFrequency();
+#else
+    if (driver->getMaxBusFrequency() < freq)
+      freq = driver->getMaxBusFrequency();
+#endif
+    if (driver->needsClockStretching())
+      needsStretch = true;
+  }
+  if (drivers.empty())
+    freq = _busFrequencyDefault;
+  if (_busFrequencyMax != 0 && freq > _busFrequencyMax)
+    freq = _busFrequencyMax;
+
+  if (freq != _busFrequency) {
+    _busFrequency = freq;
+    _i2c->setClock(_busFrequency);
+    WS_DEBUG_PRINT("I2C: Bus frequency set to (Hz): ");
+    WS_DEBUG_PRINTLN(_busFrequency);
+  }
+
+  if (needsStretch != _isClockStretching) {
+    _isClockStretching = needsStretch;
+#if defined(ARDUINO_ARCH_ESP32)
+    _i2c->setTimeOut(_isClockStretching ? I2C_CLOCK_STRETCH_TIMEOUT_MS
+                                        : I2C_TIMEOUT_MS);
+#elif defined(ARDUINO_ARCH_ESP8266)
+    // 230us is the ESP8266 core's default clock stretch limit
+    _i2c->setClockStretchLimit(
+        _isClockStretching ? I2C_CLOCK_STRETCH_TIMEOUT_MS * 1000 : 230);
+#endif
+  }
+}
+
+/************************************************************************/
+/*!
+    @brief    Attempts to free a bus wedged by a device holding SDA low
+              by clocking SCL up to 9 times, issuing a STOP condition and
+              re-initializing the I2C controller.
+    @returns  True if both lines are released after recovery, False
+              otherwise.
+*/
+/************************************************************************/
+bool WipperSnapper_Component_I2C::recoverBus() {
+  WS_DEBUG_PRINTLN("I2C: Attempting bus recovery...");
+  _busRecoveryCount++;
+
+  // Release the pins from the I2C controller
+#ifndef ARDUINO_ARCH_ESP8266
+  _i2c->end();
+#endif
+  pinMode(_pinSDA, INPUT_PULLUP);
+  pinMode(_pinSCL, INPUT_PULLUP);
+  delayMicroseconds(5);
+
+  // Clock SCL until the device lets go of SDA, a device can be at most
+  // 8 data bits + 1 ACK into a transfer
+  for (int i = 0; i < 9 && digitalRead(_pinSDA) == LOW; i++) {
+    pinMode(_pinSCL, OUTPUT);
+    digitalWrite(_pinSCL, LOW);
+    delayMicroseconds(5);
+    pinMode(_pinSCL, INPUT_PULLUP);
+    delayMicroseconds(5);
+  }
+
+  // Generate a STOP condition: SDA low->high while SCL is high
+  pinMode(_pinSDA, OUTPUT);
+  digitalWrite(_pinSDA, LOW);
+  delayMicroseconds(5);
+  pinMode(_pinSCL, INPUT_PULLUP);
+  delayMicroseconds(5);
+  pinMode(_pinSDA, INPUT_PULLUP);
+  delayMicroseconds(5);
+
+  bool isRecovered = !isBusLineStuck();
+
+  // Re-initialize the I2C controller
+  pinMode(_pinSCL, INPUT);
+  pinMode(_pinSDA, INPUT);
+#if defined(ARDUINO_ARCH_ESP32)
+  _i2c->begin((int)_pinSDA, (int)_pinSCL);
+#elif defined(ARDUINO_ARCH_ESP8266)
+  _i2c->begin(_pinSDA, _pinSCL);
+#else
+  _i2c->begin();
+#endif
+  _i2c->setClock(_busFrequency);
+
+  invalidateScanCache();
+  WS_DEBUG_PRINT("I2C: Bus recovery ");
+  WS_DEBUG_PRINTLN(isRecovered ? "succeeded" : "failed");
+  return isRecovered;
+}
+
+/************************************************************************/
+/*!
+    @brief    Tracks the outcome of polling a device. Devices which keep
+              failing trigger a bus recovery and are held off for an
+              exponentially increasing time so they don't starve the
+              healthy devices on the bus.
+    @param    driver
+              The I2C device driver which was polled.
+    @param    success
+              True if the device responded, False otherwise.
+    @param    latencyUs
+              Time taken to poll the device, in microseconds.
+*/
+/************************************************************************/
+void WipperSnapper_Component_I2C::supervisePoll(
+    WipperSnapper_I2C_Driver *driver, bool success, uint32_t latencyUs) {
+  driver->recordPoll(success, latencyUs);
+  if (success)
+    return;
+
+  uint8_t failures = driver->getConsecutiveFailures();
+  // A device which keeps failing may be wedged, holding SDA low
+  if (failures % I2C_RECOVERY_THRESHOLD == 0 && isBusLineStuck())
+    recoverBus();
+
+  // Hold off the device, doubling the time on each consecutive failure
+  unsigned long backoff = (unsigned long)I2C_BACKOFF_BASE_MS
+                          << (failures > 9 ? 9 : failures - 1);
+  if (backoff > I2C_BACKOFF_MAX_MS)
+    backoff = I2C_BACKOFF_MAX_MS;
+  driver->setBackoff(millis() + backoff);
+
+  WS_DEBUG_PRINT("I2C: Holding off device for (ms): ");
+  WS_DEBUG_PRINTLN(backoff);
+  printDeviceStats(driver);
+}
+
+/************************************************************************/
+/*!
+    @brief    Prints the error and latency counters of a device.
+    @param    driver
+              The I2C device driver.
+*/
+/************************************************************************/
+void WipperSnapper_Component_I2C::printDeviceStats(
+    WipperSnapper_I2C_Driver *driver) {
+  WS_DEBUG_PRINT("I2C Device 0x");
+  WS_DEBUG_PRINTHEX(driver->getI2CAddress());
+  WS_DEBUG_PRINTLN("");
+  WS_DEBUG_PRINT("\tPolls: ");
+  WS_DEBUG_PRINTLN(driver->getPollCount());
+  WS_DEBUG_PRINT("\tErrors: ");
+  WS_DEBUG_PRINTLN(driver->getErrorCount());
+  WS_DEBUG_PRINT("\tConsecutive Errors: ");
+  WS_DEBUG_PRINTLN(driver->getConsecutiveFailures());
+  WS_DEBUG_PRINT("\tLatency avg/max (us): ");
+  WS_DEBUG_PRINT(driver->getPollLatencyAvg());
+  WS_DEBUG_PRINT("/");
+  WS_DEBUG_PRINTLN(driver->getPollLatencyMax());
+  WS_DEBUG_PRINT("\tBus Recoveries: ");
+  WS_DEBUG_PRINTLN(_busRecoveryCount);
+}
+
+/************************************************************************/
+/*!
+    @brief    Checks whether a device still acknowledges its address. Its
+              multiplexer channel, if any, must already be connected.
+    @param    driver
+              The I2C device driver.
+    @returns  True if the device acknowledged, False otherwise.
+*/
+/************************************************************************/
+bool WipperSnapper_Component_I2C::isDeviceResponding(
+    WipperSnapper_I2C_Driver *driver) {
+  _i2c->beginTransmission(driver->getI2CAddress());
+  return _i2c->endTransmission() == 0;
+}
+
+/************************************************************************/
+/*!
+    @brief    Prints the bus health counters, and publishes them to the
+              diagnostics topic as a JSON object. Each device, keyed by
+              its encoded address, reports
+              [polls, errors, consecutive errors, avg us, max us].
+*/
+/************************************************************************/
+void WipperSnapper_Component_I2C::reportBusHealth() {
+  _prvHealthReport = millis();
+
+  char msg[WS_MQTT_MAX_PAYLOAD_SIZE];
+  int len = snprintf(msg, sizeof(msg),
+                     "{\"i2c\":{\"port\":%ld,\"freq\":%lu,"
+                     "\"recoveries\":%lu,\"devices\":{",
+                     (long)_portNum, (unsigned long)_busFrequency,
+                     (unsigned long)_busRecoveryCount);
+  bool isFirst = true;
+  std::vector<WipperSnapper_I2C_Driver *>::iterator iter, end;
+  for (iter = drivers.begin(), end = drivers.end(); iter != end; ++iter) {
+    char device[64];
+    int deviceLen =
+        snprintf(device, sizeof(device), "%s\"0x%lx\":[%lu,%lu,%u,%lu,%lu]",
+                 isFirst ? "" : ",",
+                 (unsigned long)(*iter)->getEncodedI2CAddress(),
+                 (unsigned long)(*iter)->getPollCount(),
+                 (unsigned long)(*iter)->getErrorCount(),
+                 (unsigned)(*iter)->getConsecutiveFailures(),
+                 (unsigned long)(*iter)->getPollLatencyAvg(),
+                 (unsigned long)(*iter)->getPollLatencyMax());
+    // leave room for the closing braces, the rest don't fit the payload
+    if (len + deviceLen + 3 >= (int)sizeof(msg)) {
+      WS_LOG_WARN(I2C, "I2C: Bus health report truncated");
+      break;
+    }
+    memcpy(msg + len, device, deviceLen);
+    len += deviceLen;
+    isFirst = false;
+  }
+  msg[len++] = '}';
+  msg[len++] = '}';
+  msg[len++] = '}';
+  msg[len] = '\0';
+
+  WS_DEBUG_PRINT("I2C bus health: ");
+  WS_DEBUG_PRINTLN(msg);
+  if (WS._topic_diagnostics == NULL || !WS._mqtt->connected())
+    return;
+  WS.publish(WS._topic_diagnostics, (uint8_t *)msg, len, 0,
+             WS_PUBLISH_PRIORITY_LOW);
+}
+
 /************************************************************************/
 /*!
     @brief    Scans all I2C addresses on the bus between 0x08 and 0x7F
               inclusive and returns an array of the devices found.
+    @param    useCache
+              If True, returns the cached result of a previous scan
+              while it is still valid.
     @returns  wippersnapper_i2c_v1_I2CBusScanResponse
 */
 /************************************************************************/
 wippersnapper_i2c_v1_I2CBusScanResponse
-WipperSnapper_Component_I2C::scanAddresses() {
+WipperSnapper_Component_I2C::scanAddresses(bool useCache) {
   uint8_t endTransmissionRC;
   uint16_t address;
+  uint8_t busFaults = 0;
+  uint16_t numProbes = 0;
   wippersnapper_i2c_v1_I2CBusScanResponse scanResp =
       wippersnapper_i2c_v1_I2CBusScanResponse_init_zero;
+  scanResp.bus_response = wippersnapper_i2c_v1_BusResponse_BUS_RESPONSE_SUCCESS;
 
-#ifndef ARDUINO_ARCH_ESP32
-  // Set I2C WDT timeout to catch I2C hangs, SAMD-specific
+  // Return the previous result if nothing changed on the bus since
+  if (useCache && _isScanCached &&
+      millis() - _scanCacheTime < I2C_SCAN_CACHE_TTL_MS) {
+    WS_DEBUG_PRINTLN("EXEC: I2C Scan (cached)");
+    return _scanCache;
+  }
+
+  // Don't probe a bus with a line held low, every probe would fail
+  if (isBusLineStuck()) {
+    WS_DEBUG_PRINTLN("ERROR: I2C SCL or SDA line stuck low, aborting scan!");
+    scanResp.bus_response =
+        wippersnapper_i2c_v1_BusResponse_BUS_RESPONSE_ERROR_PULLUPS;
+    _isScanCached = false;
+    return scanResp;
+  }
+
+  // Disconnect every multiplexer channel so only the main bus is scanned
+  disconnectMuxes();
+
+#if defined(ARDUINO_ARCH_ESP32)
+  // Shorten the per-transaction timeout so an absent or
+  // misbehaving address can not stall the scan
+  uint16_t prvTimeout = _i2c->getTimeOut();
+  _i2c->setTimeOut(I2C_SCAN_PROBE_TIMEOUT_MS);
+#else
+  // Set I2C WDT timeout to catch I2C hangs, SAMD-specific.
+  // The WDT is fed after each probe so this bounds a single probe,
+  // not the entire scan.
   WS.enableWDT(I2C_TIMEOUT_MS);
   WS.feedWDT();
 #endif
@@ -157,9 +505,14 @@ WipperSnapper_Component_I2C::scanAddresses() {
   // Scan all I2C addresses between 0x08 and 0x7F inclusive and return a list of
   // those that respond.
   WS_DEBUG_PRINTLN("EXEC: I2C Scan");
+  unsigned long scanStart = micros();
   for (address = 0x08; address < 0x7F; address++) {
     _i2c->beginTransmission(address);
     endTransmissionRC = _i2c->endTransmission();
+    numProbes++;
+#ifndef ARDUINO_ARCH_ESP32
+    WS.feedWDT();
+#endif
 
 #if defined(ARDUINO_ARCH_ESP32)
     // Check endTransmission()'s return code (Arduino-ESP32 ONLY)
@@ -175,6 +528,8 @@ WipperSnapper_Component_I2C::scanAddresses() {
     } else if (endTransmissionRC == 7) {
       WS_DEBUG_PRINT("I2C_ESP_ERR: SDA/SCL shorted, requests queued: ");
       WS_DEBUG_PRINTLN(endTransmissionRC);
+      scanResp.bus_response =
+          wippersnapper_i2c_v1_BusResponse_BUS_RESPONSE_ERROR_WIRING;
       break;
     }
 #endif
@@ -186,22 +541,203 @@ WipperSnapper_Component_I2C::scanAddresses() {
       scanResp.addresses_found[scanResp.addresses_found_count] =
           (uint32_t)address;
       scanResp.addresses_found_count++;
+      busFaults = 0;
+    } else if (endTransmissionRC == 2) {
+      // NACK on address, nobody home
+      busFaults = 0;
+    } else {
+      // Bus-level error (arbitration lost, timeout, ...), bail out
+      // early rather than probing every remaining address
+      busFaults++;
+      if (busFaults >= I2C_SCAN_MAX_BUS_FAULTS) {
+        WS_DEBUG_PRINT("ERROR: I2C bus fault during scan, rc: ");
+        WS_DEBUG_PRINTLN(endTransmissionRC);
+        scanResp.bus_response =
+            isBusLineStuck()
+                ? wippersnapper_i2c_v1_BusResponse_BUS_RESPONSE_ERROR_PULLUPS
+                : wippersnapper_i2c_v1_BusResponse_BUS_RESPONSE_ERROR_HANG;
+        break;
+      }
     }
   }
+  _scanProbeTimeUs = (uint32_t)(micros() - scanStart) / numProbes;
 
-#ifndef ARDUINO_ARCH_ESP32
+#if defined(ARDUINO_ARCH_ESP32)
+  _i2c->setTimeOut(prvTimeout);
+#else
   // re-enable WipperSnapper SAMD WDT global timeout
   WS.enableWDT(WS_WDT_TIMEOUT);
   WS.feedWDT();
 #endif
 
+  // Attempt to free the bus if the scan was aborted by a wedged device
+  if (scanResp.bus_response !=
+          wippersnapper_i2c_v1_BusResponse_BUS_RESPONSE_SUCCESS &&
+      isBusLineStuck())
+    recoverBus();
+
   WS_DEBUG_PRINT("I2C Devices Found: ")
   WS_DEBUG_PRINTLN(scanResp.addresses_found_count);
-
-  scanResp.bus_response = wippersnapper_i2c_v1_BusResponse_BUS_RESPONSE_SUCCESS;
+  WS_DEBUG_PRINT("I2C Time per probe (us): ");
+  WS_DEBUG_PRINTLN(_scanProbeTimeUs);
+
+  // Only cache a clean scan, a faulted bus should be re-probed
+  if (scanResp.bus_response ==
+      wippersnapper_i2c_v1_BusResponse_BUS_RESPONSE_SUCCESS) {
+    _scanCache = scanResp;
+    _scanCacheTime = millis();
+    _isScanCached = true;
+  } else {
+    _isScanCached = false;
+  }
   return scanResp;
 }
 
+/*******************************************************************************/
+/*!
+    @brief    Creates a new I2C device driver object.
+    @param    deviceName
+              The I2C device's name, from an I2CDeviceInitRequest.
+    @param    i2cAddress
+              The I2C device's 7-bit address.
+    @returns  Pointer to the new driver, nullptr if the device type is not
+              supported.
+*/
+/*******************************************************************************/
+WipperSnapper_I2C_Driver *
+WipperSnapper_Component_I2C::createI2CDriver(const char *deviceName,
+                                             uint16_t i2cAddress) {
+  if (strcmp("aht20", deviceName) == 0)
+    return new WipperSnapper_I2C_Driver_AHTX0(_i2c, i2cAddress);
+  if (strcmp("bh1750", deviceName) == 0)
+    return new WipperSnapper_I2C_Driver_BH1750(_i2c, i2cAddress);
+  if (strcmp("bme280", deviceName) == 0)
+    return new WipperSnapper_I2C_Driver_BME280(_i2c, i2cAddress);
+  if (strcmp("bmp280", deviceName) == 0)
+    return new WipperSnapper_I2C_Driver_BMP280(_i2c, i2cAddress);
+  if (strcmp("bme680", deviceName) == 0)
+    return new WipperSnapper_I2C_Driver_BME680(_i2c, i2cAddress);
+  if (strcmp("dps310", deviceName) == 0)
+    return new WipperSnapper_I2C_Driver_DPS310(_i2c, i2cAddress);
+  if (strcmp("hts221", deviceName) == 0)
+    return new WipperSnapper_I2C_Driver_HTS221(_i2c, i2cAddress);
+  if (strcmp("scd30", deviceName) == 0)
+    return new WipperSnapper_I2C_Driver_SCD30(_i2c, i2cAddress);
+  if (strcmp("sgp30", deviceName) == 0)
+    return new WipperSnapper_I2C_Driver_SGP30(_i2c, i2cAddress);
+  if ((strcmp("sht20", deviceName) == 0) || (strcmp("si7021", deviceName) == 0))
+    return new WipperSnapper_I2C_Driver_SI7021(_i2c, i2cAddress);
+  if (strcmp("mcp9808", deviceName) == 0)
+    return new WipperSnapper_I2C_Driver_MCP9808(_i2c, i2cAddress);
+  if (strcmp("tmp117", deviceName) == 0)
+    return new WipperSnapper_I2C_Driver_TMP117(_i2c, i2cAddress);
+  if (strcmp("tsl2591", deviceName) == 0)
+    return new WipperSnapper_I2C_Driver_TSL2591(_i2c, i2cAddress);
+  if (strcmp("veml7700", deviceName) == 0)
+    return new WipperSnapper_I2C_Driver_VEML7700(_i2c, i2cAddress);
+  if (strcmp("scd40", deviceName) == 0)
+    return new WipperSnapper_I2C_Driver_SCD4X(_i2c, i2cAddress);
+  if (strcmp("sen5x", deviceName) == 0)
+    return new WipperSnapper_I2C_Driver_SEN5X(_i2c, i2cAddress);
+  if ((strcmp("sht40", deviceName) == 0) || (strcmp("sht45", deviceName) == 0))
+    return new WipperSnapper_I2C_Driver_SHT4X(_i2c, i2cAddress);
+  if (strcmp("sht3x", deviceName) == 0)
+    return new WipperSnapper_I2C_Driver_SHT3X(_i2c, i2cAddress);
+  if (strcmp("shtc3", deviceName) == 0)
+    return new WipperSnapper_I2C_Driver_SHTC3(_i2c, i2cAddress);
+  if (strcmp("pct2075", deviceName) == 0)
+    return new WipperSnapper_I2C_Driver_PCT2075(_i2c, i2cAddress);
+  if (strcmp("pmsa003i", deviceName) == 0)
+    return new WipperSnapper_I2C_Driver_PM25(_i2c, i2cAddress);
+  if (strcmp("lc709203f", deviceName) == 0)
+    return new WipperSnapper_I2C_Driver_LC709203F(_i2c, i2cAddress);
+  if (strcmp("stemma_soil", deviceName) == 0)
+    return new WipperSnapper_I2C_Driver_STEMMA_Soil_Sensor(_i2c, i2cAddress);
+  if (strcmp("vl53l0x", deviceName) == 0)
+    return new WipperSnapper_I2C_Driver_VL53L0X(_i2c, i2cAddress);
+  if (strcmp("max17048", deviceName) == 0)
+    return new WipperSnapper_I2C_Driver_MAX17048(_i2c, i2cAddress);
+  if (strcmp("adt7410", deviceName) == 0)
+    return new WipperSnapper_I2C_Driver_ADT7410(_i2c, i2cAddress);
+  return nullptr;
+}
+
+/*******************************************************************************/
+/*!
+    @brief    Connects a device behind a TCA9548A I2C multiplexer to the bus.
+              The selected channel is cached so consecutive transactions on
+              the same channel don't re-write the multiplexer.
+    @param    muxAddress
+              The multiplexer's I2C address, 0 to disconnect all
+              multiplexer channels.
+    @param    muxChannel
+              The multiplexer channel, 0-7.
+    @returns  True if the channel was selected, False otherwise.
+*/
+/*******************************************************************************/
+bool WipperSnapper_Component_I2C::selectMuxChannel(uint8_t muxAddress,
+                                                   uint8_t muxChannel) {
+  if (muxAddress == 0)
+    muxChannel = 0;
+  if (muxAddress == _muxAddressSelected && muxChannel == _muxChannelSelected)
+    return true;
+
+  // Disconnect the previously selected multiplexer so devices on its
+  // channel can't collide with devices on the next channel
+  if (_muxAddressSelected != 0 && _muxAddressSelected != muxAddress) {
+    _i2c->beginTransmission(_muxAddressSelected);
+    _i2c->write((uint8_t)0);
+    _i2c->endTransmission();
+  }
+  _muxAddressSelected = 0;
+  _muxChannelSelected = 0;
+
+  if (muxAddress != 0) {
+    _i2c->beginTransmission(muxAddress);
+    _i2c->write((uint8_t)(1 << muxChannel));
+    if (_i2c->endTransmission() != 0) {
+      WS_DEBUG_PRINT("ERROR: Unable to select I2C mux channel on 0x");
+      WS_DEBUG_PRINTHEX(muxAddress);
+      WS_DEBUG_PRINTLN("");
+      return false;
+    }
+  }
+  _muxAddressSelected = muxAddress;
+  _muxChannelSelected = muxChannel;
+  return true;
+}
+
+/*******************************************************************************/
+/*!
+    @brief    Disconnects the channels of every multiplexer on the bus, not
+              only the cached one. Multiplexers used by attached devices are
+              written to, or every TCA9548A address when none are known,
+              since a multiplexer may have been left connected before a
+              reset.
+*/
+/*******************************************************************************/
+void WipperSnapper_Component_I2C::disconnectMuxes() {
+  bool isMuxKnown = false;
+  for (WipperSnapper_I2C_Driver *driver : drivers) {
+    if (driver->getMuxAddress() == 0)
+      continue;
+    _i2c->beginTransmission(driver->getMuxAddress());
+    _i2c->write((uint8_t)0);
+    _i2c->endTransmission();
+    isMuxKnown = true;
+  }
+  if (!isMuxKnown) {
+    for (uint8_t muxAddress = I2C_MUX_ADDRESS_MIN;
+         muxAddress <= I2C_MUX_ADDRESS_MAX; muxAddress++) {
+      _i2c->beginTransmission(muxAddress);
+      _i2c->write((uint8_t)0);
+      _i2c->endTransmission();
+    }
+  }
+  _muxAddressSelected = 0;
+  _muxChannelSelected = 0;
+}
+
 /*******************************************************************************/
 /*!
     @brief    Initializes I2C device driver.
@@ -214,301 +750,53 @@ bool WipperSnapper_Component_I2C::initI2CDevice(
     wippersnapper_i2c_v1_I2CDeviceInitRequest *msgDeviceInitReq) {
   WS_DEBUG_PRINT("Attempting to initialize I2C device: ");
   WS_DEBUG_PRINTLN(msgDeviceInitReq->i2c_device_name);
-
-  uint16_t i2cAddress = (uint16_t)msgDeviceInitReq->i2c_device_address;
-  if (strcmp("aht20", msgDeviceInitReq->i2c_device_name) == 0) {
-    _ahtx0 = new WipperSnapper_I2C_Driver_AHTX0(this->_i2c, i2cAddress);
-    if (!_ahtx0->begin()) {
-      WS_DEBUG_PRINTLN("ERROR: Failed to initialize AHTX0 chip!");
-      _busStatusResponse =
-          wippersnapper_i2c_v1_BusResponse_BUS_RESPONSE_DEVICE_INIT_FAIL;
-      return false;
-    }
-    _ahtx0->configureDriver(msgDeviceInitReq);
-    drivers.push_back(_ahtx0);
-  } else if (strcmp("bh1750", msgDeviceInitReq->i2c_device_name) == 0) {
-    _bh1750 = new WipperSnapper_I2C_Driver_BH1750(this->_i2c, i2cAddress);
-    if (!_bh1750->begin()) {
-      WS_DEBUG_PRINTLN("ERROR: Failed to initialize BH1750 chip!");
-      _busStatusResponse =
-          wippersnapper_i2c_v1_BusResponse_BUS_RESPONSE_DEVICE_INIT_FAIL;
-      return false;
-    }
-    _bh1750->configureDriver(msgDeviceInitReq);
-    drivers.push_back(_bh1750);
-  } else if (strcmp("bme280", msgDeviceInitReq->i2c_device_name) == 0) {
-    _bme280 = new WipperSnapper_I2C_Driver_BME280(this->_i2c, i2cAddress);
-    if (!_bme280->begin()) {
-      WS_DEBUG_PRINTLN("ERROR: Failed to initialize BME280!");
-      _busStatusResponse =
-          wippersnapper_i2c_v1_BusResponse_BUS_RESPONSE_DEVICE_INIT_FAIL;
-      return false;
-    }
-    _bme280->configureDriver(msgDeviceInitReq);
-    drivers.push_back(_bme280);
-    WS_DEBUG_PRINTLN("BME280 Initialized Successfully!");
-  } else if (strcmp("bmp280", msgDeviceInitReq->i2c_device_name) == 0) {
-    _bmp280 = new WipperSnapper_I2C_Driver_BMP280(this->_i2c, i2cAddress);
-    if (!_bmp280->begin()) {
-      WS_DEBUG_PRINTLN("ERROR: Failed to initialize BMP280!");
-      _busStatusResponse =
-          wippersnapper_i2c_v1_BusResponse_BUS_RESPONSE_DEVICE_INIT_FAIL;
-      return false;
-    }
-    _bmp280->configureDriver(msgDeviceInitReq);
-    drivers.push_back(_bmp280);
-    WS_DEBUG_PRINTLN("BMP280 Initialized Successfully!");
-  } else if (strcmp("bme680", msgDeviceInitReq->i2c_device_name) == 0) {
-    _bme680 = new WipperSnapper_I2C_Driver_BME680(this->_i2c, i2cAddress);
-    if (!_bme680->begin()) {
-      WS_DEBUG_PRINTLN("ERROR: Failed to initialize BME680!");
-      _busStatusResponse =
-          wippersnapper_i2c_v1_BusResponse_BUS_RESPONSE_DEVICE_INIT_FAIL;
-      return false;
-    }
-    _bme680->configureDriver(msgDeviceInitReq);
-    drivers.push_back(_bme680);
-    WS_DEBUG_PRINTLN("BME680 Initialized Successfully!");
-  } else if (strcmp("dps310", msgDeviceInitReq->i2c_device_name) == 0) {
-    _dps310 = new WipperSnapper_I2C_Driver_DPS310(this->_i2c, i2cAddress);
-    if (!_dps310->begin()) {
-      WS_DEBUG_PRINTLN("ERROR: Failed to initialize DPS310!");
-      _busStatusResponse =
-          wippersnapper_i2c_v1_BusResponse_BUS_RESPONSE_DEVICE_INIT_FAIL;
-      return false;
-    }
-    _dps310->configureDriver(msgDeviceInitReq);
-    drivers.push_back(_dps310);
-    WS_DEBUG_PRINTLN("DPS310 Initialized Successfully!");
-  } else if (strcmp("hts221", msgDeviceInitReq->i2c_device_name) == 0) {
-    _hts221 = new WipperSnapper_I2C_Driver_HTS221(this->_i2c, i2cAddress);
-    if (!_hts221->begin()) {
-      WS_DEBUG_PRINTLN("ERROR: Failed to initialize HTS221!");
-      _busStatusResponse =
-          wippersnapper_i2c_v1_BusResponse_BUS_RESPONSE_DEVICE_INIT_FAIL;
-      return false;
-    }
-    _hts221->configureDriver(msgDeviceInitReq);
-    drivers.push_back(_hts221);
-    WS_DEBUG_PRINTLN("HTS221 Initialized Successfully!");
-  } else if (strcmp("scd30", msgDeviceInitReq->i2c_device_name) == 0) {
-    _scd30 = new WipperSnapper_I2C_Driver_SCD30(this->_i2c, i2cAddress);
-    if (!_scd30->begin()) {
-      WS_DEBUG_PRINTLN("ERROR: Failed to initialize SCD30!");
-      _busStatusResponse =
-          wippersnapper_i2c_v1_BusResponse_BUS_RESPONSE_DEVICE_INIT_FAIL;
-      return false;
-    }
-    _scd30->configureDriver(msgDeviceInitReq);
-    drivers.push_back(_scd30);
-    WS_DEBUG_PRINTLN("SCD30 Initialized Successfully!");
-  } else if (strcmp("sgp30", msgDeviceInitReq->i2c_device_name) == 0) {
-    _sgp30 = new WipperSnapper_I2C_Driver_SGP30(this->_i2c, i2cAddress);
-    if (!_sgp30->begin()) {
-      WS_DEBUG_PRINTLN("ERROR: Failed to initialize SGP30!");
-      _busStatusResponse =
-          wippersnapper_i2c_v1_BusResponse_BUS_RESPONSE_DEVICE_INIT_FAIL;
-      return false;
-    }
-    _sgp30->configureDriver(msgDeviceInitReq);
-    drivers.push_back(_sgp30);
-    WS_DEBUG_PRINTLN("SGP30 Initialized Successfully!");
-  } else if ((strcmp("sht20", msgDeviceInitReq->i2c_device_name) == 0) ||
-             (strcmp("si7021", msgDeviceInitReq->i2c_device_name) == 0)) {
-    _si7021 = new WipperSnapper_I2C_Driver_SI7021(this->_i2c, i2cAddress);
-    if (!_si7021->begin()) {
-      WS_DEBUG_PRINTLN("ERROR: Failed to initialize SI7021/SHT20!");
-      _busStatusResponse =
-          wippersnapper_i2c_v1_BusResponse_BUS_RESPONSE_DEVICE_INIT_FAIL;
-      return false;
-    }
-    _si7021->configureDriver(msgDeviceInitReq);
-    drivers.push_back(_si7021);
-    WS_DEBUG_PRINTLN("SI7021/SHT20 Initialized Successfully!");
-  } else if (strcmp("mcp9808", msgDeviceInitReq->i2c_device_name) == 0) {
-    _mcp9808 = new WipperSnapper_I2C_Driver_MCP9808(this->_i2c, i2cAddress);
-    if (!_mcp9808->begin()) {
-      WS_DEBUG_PRINTLN("ERROR: Failed to initialize MCP9808!");
-      _busStatusResponse =
-          wippersnapper_i2c_v1_BusResponse_BUS_RESPONSE_DEVICE_INIT_FAIL;
-      return false;
-    }
-    _mcp9808->configureDriver(msgDeviceInitReq);
-    drivers.push_back(_mcp9808);
-    WS_DEBUG_PRINTLN("MCP9808 Initialized Successfully!");
-  } else if (strcmp("tmp117", msgDeviceInitReq->i2c_device_name) == 0) {
-    _tmp117 = new WipperSnapper_I2C_Driver_TMP117(this->_i2c, i2cAddress);
-    if (!_tmp117->begin()) {
-      WS_DEBUG_PRINTLN("ERROR: Failed to initialize TMP117!");
-      _busStatusResponse =
-          wippersnapper_i2c_v1_BusResponse_BUS_RESPONSE_DEVICE_INIT_FAIL;
-      return false;
-    }
-    _tmp117->configureDriver(msgDeviceInitReq);
-    drivers.push_back(_tmp117);
-    WS_DEBUG_PRINTLN("TMP117 Initialized Successfully!");
-  } else if (strcmp("tsl2591", msgDeviceInitReq->i2c_device_name) == 0) {
-    _tsl2591 = new WipperSnapper_I2C_Driver_TSL2591(this->_i2c, i2cAddress);
-    if (!_tsl2591->begin()) {
-      WS_DEBUG_PRINTLN("ERROR: Failed to initialize TSL2591!");
-      _busStatusResponse =
-          wippersnapper_i2c_v1_BusResponse_BUS_RESPONSE_DEVICE_INIT_FAIL;
-      return false;
-    }
-    _tsl2591->configureDriver(msgDeviceInitReq);
-    drivers.push_back(_tsl2591);
-    WS_DEBUG_PRINTLN("TSL2591 Initialized Successfully!");
-  } else if (strcmp("veml7700", msgDeviceInitReq->i2c_device_name) == 0) {
-    _veml7700 = new WipperSnapper_I2C_Driver_VEML7700(this->_i2c, i2cAddress);
-    if (!_veml7700->begin()) {
-      WS_DEBUG_PRINTLN("ERROR: Failed to initialize VEML7700!");
-      _busStatusResponse =
-          wippersnapper_i2c_v1_BusResponse_BUS_RESPONSE_DEVICE_INIT_FAIL;
-      return false;
-    }
-    _veml7700->configureDriver(msgDeviceInitReq);
-    drivers.push_back(_veml7700);
-    WS_DEBUG_PRINTLN("VEML7700 Initialized Successfully!");
-  } else if (strcmp("scd40", msgDeviceInitReq->i2c_device_name) == 0) {
-    _scd40 = new WipperSnapper_I2C_Driver_SCD4X(this->_i2c, i2cAddress);
-    if (!_scd40->begin()) {
-      WS_DEBUG_PRINTLN("ERROR: Failed to initialize SCD4x!");
-      _busStatusResponse =
-          wippersnapper_i2c_v1_BusResponse_BUS_RESPONSE_DEVICE_INIT_FAIL;
-      return false;
-    }
-    _scd40->configureDriver(msgDeviceInitReq);
-    drivers.push_back(_scd40);
-    WS_DEBUG_PRINTLN("SCD4x Initialized Successfully!");
-  } else if (strcmp("sen5x", msgDeviceInitReq->i2c_device_name) == 0) {
-    _sen5x = new WipperSnapper_I2C_Driver_SEN5X(this->_i2c, i2cAddress);
-    if (!_sen5x->begin()) {
-      WS_DEBUG_PRINTLN("ERROR: Failed to initialize SEN5X!");
-      _busStatusResponse =
-          wippersnapper_i2c_v1_BusResponse_BUS_RESPONSE_DEVICE_INIT_FAIL;
-      return false;
-    }
-    _sen5x->configureDriver(msgDeviceInitReq);
-    drivers.push_back(_sen5x);
-    WS_DEBUG_PRINTLN("SEN5X Initialized Successfully!");
-  } else if ((strcmp("sht40", msgDeviceInitReq->i2c_device_name) == 0) ||
-             (strcmp("sht45", msgDeviceInitReq->i2c_device_name) == 0)) {
-    _sht4x = new WipperSnapper_I2C_Driver_SHT4X(this->_i2c, i2cAddress);
-    if (!_sht4x->begin()) {
-      WS_DEBUG_PRINTLN("ERROR: Failed to initialize sht4x!");
-      _busStatusResponse =
-          wippersnapper_i2c_v1_BusResponse_BUS_RESPONSE_DEVICE_INIT_FAIL;
-      return false;
-    }
-    _sht4x->configureDriver(msgDeviceInitReq);
-    drivers.push_back(_sht4x);
-    WS_DEBUG_PRINTLN("SHT4X Initialized Successfully!");
-  } else if (strcmp("sht3x", msgDeviceInitReq->i2c_device_name) == 0) {
-    _sht3x = new WipperSnapper_I2C_Driver_SHT3X(this->_i2c, i2cAddress);
-    if (!_sht3x->begin()) {
-      WS_DEBUG_PRINTLN("ERROR: Failed to initialize sht3x!");
-      _busStatusResponse =
-          wippersnapper_i2c_v1_BusResponse_BUS_RESPONSE_DEVICE_INIT_FAIL;
-      return false;
-    }
-    _sht3x->configureDriver(msgDeviceInitReq);
-    drivers.push_back(_sht3x);
-    WS_DEBUG_PRINTLN("SHT3X Initialized Successfully!");
-  } else if (strcmp("shtc3", msgDeviceInitReq->i2c_device_name) == 0) {
-    _shtc3 = new WipperSnapper_I2C_Driver_SHTC3(this->_i2c, i2cAddress);
-    if (!_shtc3->begin()) {
-      WS_DEBUG_PRINTLN("ERROR: Failed to initialize SHTC3!");
-      _busStatusResponse =
-          wippersnapper_i2c_v1_BusResponse_BUS_RESPONSE_DEVICE_INIT_FAIL;
-      return false;
-    }
-    _shtc3->configureDriver(msgDeviceInitReq);
-    drivers.push_back(_shtc3);
-    WS_DEBUG_PRINTLN("SHTC3 Initialized Successfully!");
-  } else if (strcmp("pct2075", msgDeviceInitReq->i2c_device_name) == 0) {
-    _pct2075 = new WipperSnapper_I2C_Driver_PCT2075(this->_i2c, i2cAddress);
-    if (!_pct2075->begin()) {
-      WS_DEBUG_PRINTLN("ERROR: Failed to initialize PCT2075 Temp Sensor!");
-      _busStatusResponse =
-          wippersnapper_i2c_v1_BusResponse_BUS_RESPONSE_DEVICE_INIT_FAIL;
-      return false;
-    }
-    _pct2075->configureDriver(msgDeviceInitReq);
-    drivers.push_back(_pct2075);
-    WS_DEBUG_PRINTLN("PCT2075 Temp Sensor Initialized Successfully!");
-  } else if (strcmp("pmsa003i", msgDeviceInitReq->i2c_device_name) == 0) {
-    _pm25 = new WipperSnapper_I2C_Driver_PM25(this->_i2c, i2cAddress);
-    if (!_pm25->begin()) {
-      WS_DEBUG_PRINTLN("ERROR: Failed to initialize PM2.5 AQI Sensor!");
-      _busStatusResponse =
-          wippersnapper_i2c_v1_BusResponse_BUS_RESPONSE_DEVICE_INIT_FAIL;
-      return false;
-    }
-    _pm25->configureDriver(msgDeviceInitReq);
-    drivers.push_back(_pm25);
-    WS_DEBUG_PRINTLN("PM2.5 AQI Sensor Initialized Successfully!");
-  } else if (strcmp("lc709203f", msgDeviceInitReq->i2c_device_name) == 0) {
-    _lc = new WipperSnapper_I2C_Driver_LC709203F(this->_i2c, i2cAddress);
-    if (!_lc->begin()) {
-      WS_DEBUG_PRINTLN("ERROR: Failed to initialize LC709203F Sensor!");
-      _busStatusResponse =
-          wippersnapper_i2c_v1_BusResponse_BUS_RESPONSE_DEVICE_INIT_FAIL;
-      return false;
-    }
-    _lc->configureDriver(msgDeviceInitReq);
-    drivers.push_back(_lc);
-    WS_DEBUG_PRINTLN("LC709203F Sensor Initialized Successfully!");
-  } else if (strcmp("stemma_soil", msgDeviceInitReq->i2c_device_name) == 0) {
-    _ss =
-        new WipperSnapper_I2C_Driver_STEMMA_Soil_Sensor(this->_i2c, i2cAddress);
-    if (!_ss->begin()) {
-      WS_DEBUG_PRINTLN("ERROR: Failed to initialize STEMMA Soil Sensor!");
-      _busStatusResponse =
-          wippersnapper_i2c_v1_BusResponse_BUS_RESPONSE_DEVICE_INIT_FAIL;
-      return false;
-    }
-    _ss->configureDriver(msgDeviceInitReq);
-    drivers.push_back(_ss);
-    WS_DEBUG_PRINTLN("STEMMA Soil Sensor Initialized Successfully!");
-  } else if (strcmp("vl53l0x", msgDeviceInitReq->i2c_device_name) == 0) {
-    _vl53l0x = new WipperSnapper_I2C_Driver_VL53L0X(this->_i2c, i2cAddress);
-    if (!_vl53l0x->begin()) {
-      WS_DEBUG_PRINTLN("ERROR: Failed to initialize VL53L0X!");
-      _busStatusResponse =
-          wippersnapper_i2c_v1_BusResponse_BUS_RESPONSE_DEVICE_INIT_FAIL;
-      return false;
-    }
-    _vl53l0x->configureDriver(msgDeviceInitReq);
-    drivers.push_back(_vl53l0x);
-    WS_DEBUG_PRINTLN("VL53L0X Initialized Successfully!");
-  } else if (strcmp("max17048", msgDeviceInitReq->i2c_device_name) == 0) {
-    _max17048 = new WipperSnapper_I2C_Driver_MAX17048(this->_i2c, i2cAddress);
-    if (!_max17048->begin()) {
-      WS_DEBUG_PRINTLN("ERROR: Failed to initialize MAX17048/MAX17049!");
-      _busStatusResponse =
-          wippersnapper_i2c_v1_BusResponse_BUS_RESPONSE_DEVICE_INIT_FAIL;
-      return false;
-    }
-    _max17048->configureDriver(msgDeviceInitReq);
-    drivers.push_back(_max17048);
-    WS_DEBUG_PRINTLN("MAX17048/MAX17049 Initialized Successfully!");
-  } else if (strcmp("adt7410", msgDeviceInitReq->i2c_device_name) == 0) {
-    _adt7410 = new WipperSnapper_I2C_Driver_ADT7410(this->_i2c, i2cAddress);
-    if (!_adt7410->begin()) {
-      WS_DEBUG_PRINTLN("ERROR: Failed to initialize ADT7410!");
-      _busStatusResponse =
-          wippersnapper_i2c_v1_BusResponse_BUS_RESPONSE_DEVICE_INIT_FAIL;
-      return false;
-    }
-    _adt7410->configureDriver(msgDeviceInitReq);
-    drivers.push_back(_adt7410);
-    WS_DEBUG_PRINTLN("ADT7410 Initialized Successfully!");
-  } else {
-    WS_DEBUG_PRINTLN("ERROR: I2C device type not found!")
+  // The set of devices on the bus is changing
+  invalidateScanCache();
+
+  // Devices behind a multiplexer encode the mux address and channel
+  // within the upper bits of i2c_device_address
+  uint32_t encodedAddress = msgDeviceInitReq->i2c_device_address;
+  uint16_t i2cAddress = I2C_DEVICE_ADDRESS(encodedAddress);
+  uint8_t muxAddress = I2C_MUX_ADDRESS(encodedAddress);
+  uint8_t muxChannel = I2C_MUX_CHANNEL(encodedAddress);
+  // A device re-sent after a warm start replaces the one replayed for it
+  removeI2CDevice(encodedAddress);
+
+  WipperSnapper_I2C_Driver *driver =
+      createI2CDriver(msgDeviceInitReq->i2c_device_name, i2cAddress);
+  if (driver == nullptr) {
+    WS_DEBUG_PRINTLN("ERROR: I2C device type not found, or out of memory!")
     _busStatusResponse =
         wippersnapper_i2c_v1_BusResponse_BUS_RESPONSE_UNSUPPORTED_SENSOR;
     return false;
   }
+  driver->setMuxChannel(muxAddress, muxChannel);
+
+  if (!selectMuxChannel(muxAddress, muxChannel) || !driver->begin()) {
+    WS_DEBUG_PRINT("ERROR: Failed to initialize ");
+    WS_DEBUG_PRINTLN(msgDeviceInitReq->i2c_device_name);
+    delete driver;
+    _busStatusResponse =
+        wippersnapper_i2c_v1_BusResponse_BUS_RESPONSE_DEVICE_INIT_FAIL;
+    return false;
+  }
+  driver->configureDriver(msgDeviceInitReq);
+  // stagger the first readings, see Wippersnapper::getPublishPhase()
+  driver->schedulePolls(millis(), WS.getPublishPhase());
+  drivers.push_back(driver);
+  WS_DEBUG_PRINT(msgDeviceInitReq->i2c_device_name);
+  WS_DEBUG_PRINTLN(" Initialized Successfully!");
+
+  // Group drivers by multiplexer channel so update() switches channels as
+  // rarely as possible
+  std::stable_sort(
+      drivers.begin(), drivers.end(),
+      [](WipperSnapper_I2C_Driver *a, WipperSnapper_I2C_Driver *b) {
+        return a->getMuxKey() < b->getMuxKey();
+      });
+
+  // Re-evaluate the bus clock for the new set of devices
+  updateBusFrequency();
   _busStatusResponse = wippersnapper_i2c_v1_BusResponse_BUS_RESPONSE_SUCCESS;
   return true;
 }
@@ -522,11 +810,11 @@ bool WipperSnapper_Component_I2C::initI2CDevice(
 /*********************************************************************************/
 void WipperSnapper_Component_I2C::updateI2CDeviceProperties(
     wippersnapper_i2c_v1_I2CDeviceUpdateRequest *msgDeviceUpdateReq) {
-  uint16_t i2cAddress = (uint16_t)msgDeviceUpdateReq->i2c_device_address;
+  uint32_t i2cAddress = msgDeviceUpdateReq->i2c_device_address;
 
   // Loop thru vector of drivers to find the unique address
   for (int i = 0; i < drivers.size(); i++) {
-    if (drivers[i]->getI2CAddress() == i2cAddress) {
+    if (drivers[i]->getEncodedI2CAddress() == i2cAddress) {
       // Update the properties of each driver
       for (int j = 0; j < msgDeviceUpdateReq->i2c_device_properties_count;
            j++) {
@@ -550,27 +838,33 @@ void WipperSnapper_Component_I2C::updateI2CDeviceProperties(
 /*******************************************************************************/
 void WipperSnapper_Component_I2C::deinitI2CDevice(
     wippersnapper_i2c_v1_I2CDeviceDeinitRequest *msgDeviceDeinitReq) {
-  uint16_t deviceAddr = (uint16_t)msgDeviceDeinitReq->i2c_device_address;
-  std::vector<WipperSnapper_I2C_Driver *>::iterator iter, end;
+  invalidateScanCache();
+  removeI2CDevice(msgDeviceDeinitReq->i2c_device_address);
+  // Re-evaluate the bus clock for the remaining devices
+  updateBusFrequency();
+  WS.printHeapStats();
+  _busStatusResponse = wippersnapper_i2c_v1_BusResponse_BUS_RESPONSE_SUCCESS;
+}
 
-  for (iter = drivers.begin(), end = drivers.end(); iter != end; ++iter) {
-    if ((*iter)->getI2CAddress() == deviceAddr) {
-      // Delete the object that iter points to
-      // delete *iter;
-      *iter = nullptr;
-// ESP-IDF, Erase–remove iter ptr from driver vector
-#if defined(ARDUINO_ARCH_ESP32) || defined(ARDUINO_ARCH_ESP8266)
-      *iter = nullptr;
-      drivers.erase(remove(drivers.begin(), drivers.end(), nullptr),
-                    drivers.end());
-#else
-      // Arduino can not erase-remove, erase only
-      drivers.erase(iter);
-#endif
+/*******************************************************************************/
+/*!
+    @brief    Deletes the drivers of the I2C device at an address.
+    @param    encodedAddress
+              The device's address, including its multiplexer channel.
+*/
+/*******************************************************************************/
+void WipperSnapper_Component_I2C::removeI2CDevice(uint32_t encodedAddress) {
+  std::vector<WipperSnapper_I2C_Driver *>::iterator iter = drivers.begin();
+  while (iter != drivers.end()) {
+    if ((*iter)->getEncodedI2CAddress() == encodedAddress) {
+      // Delete the driver object, returning it to the driver pool
+      delete *iter;
+      iter = drivers.erase(iter);
       WS_DEBUG_PRINTLN("I2C Device De-initialized!");
+    } else {
+      ++iter;
     }
   }
-  _busStatusResponse = wippersnapper_i2c_v1_BusResponse_BUS_RESPONSE_SUCCESS;
 }
 
 /*******************************************************************************/
@@ -589,10 +883,15 @@ bool WipperSnapper_Component_I2C::encodePublishI2CDeviceEventMsg(
   // Encode I2CResponse msg
   msgi2cResponse->payload.resp_i2c_device_event.sensor_address = sensorAddress;
   memset(WS._buffer_outgoing, 0, sizeof(WS._buffer_outgoing));
-  pb_ostream_t ostream =
-      pb_ostream_from_buffer(WS._buffer_outgoing, sizeof(WS._buffer_outgoing));
-  if (!pb_encode(&ostream, wippersnapper_signal_v1_I2CResponse_fields,
-                 msgi2cResponse)) {
+  bool isEncoded;
+  {
+    WS_TRACE_SCOPE(WS_TRACE_EVENT_ENCODE);
+    pb_ostream_t ostream = pb_ostream_from_buffer(WS._buffer_outgoing,
+                                                  sizeof(WS._buffer_outgoing));
+    isEncoded = pb_encode(&ostream, wippersnapper_signal_v1_I2CResponse_fields,
+                          msgi2cResponse);
+  }
+  if (!isEncoded) {
     WS_DEBUG_PRINTLN(
         "ERROR: Unable to encode I2C device event response message!");
     return false;
@@ -602,12 +901,11 @@ bool WipperSnapper_Component_I2C::encodePublishI2CDeviceEventMsg(
   size_t msgSz;
   pb_get_encoded_size(&msgSz, wippersnapper_signal_v1_I2CResponse_fields,
                       msgi2cResponse);
-  WS_DEBUG_PRINT("PUBLISHING -> I2C Device Sensor Event Message...");
-  if (!WS._mqtt->publish(WS._topic_signal_i2c_device, WS._buffer_outgoing,
-                         msgSz, 1)) {
+  if (!WS.publish(WS._topic_signal_i2c_device, WS._buffer_outgoing, msgSz, 1,
+                  WS_PUBLISH_PRIORITY_LOW)) {
     return false;
   };
-  WS_DEBUG_PRINTLN("PUBLISHED!");
+  WS_LOG_DEBUG(I2C, "PUBLISHED -> I2C Device Sensor Event Message");
   return true;
 }
 
@@ -743,12 +1041,37 @@ void WipperSnapper_Component_I2C::update() {
   msgi2cResponse.which_payload =
       wippersnapper_signal_v1_I2CResponse_resp_i2c_device_event_tag;
 
+  // Publish the bus health counters now and then, if enabled
+  if (I2C_HEALTH_INTERVAL_MS > 0 &&
+      millis() - _prvHealthReport >= I2C_HEALTH_INTERVAL_MS)
+    reportBusHealth();
+
   long curTime;
   std::vector<WipperSnapper_I2C_Driver *>::iterator iter, end;
   for (iter = drivers.begin(), end = drivers.end(); iter != end; ++iter) {
+    WS_TRACE_SCOPE(WS_TRACE_EVENT_I2C_DEVICE);
     // Number of events which occured for this driver
     msgi2cResponse.payload.resp_i2c_device_event.sensor_event_count = 0;
 
+    // Skip devices held off by the bus supervisor
+    if ((*iter)->isBackedOff(millis()))
+      continue;
+    uint8_t readsFailed = 0;
+    unsigned long pollStart = micros();
+
+    // Connect the device's multiplexer channel, if any
+    if (!selectMuxChannel((*iter)->getMuxAddress(),
+                          (*iter)->getMuxChannel())) {
+      supervisePoll(*iter, false, (uint32_t)(micros() - pollStart));
+      continue;
+    }
+#ifdef I2C_PER_TRANSACTION_CLOCK
+    // Temporarily lower the clock for devices slower than the bus
+    bool isClockLowered = (*iter)->getMaxBusFrequency() < _busFrequency;
+    if (isClockLowered)
+      _i2c->setClock((*iter)->getMaxBusFrequency());
+#endif
+
     // Event struct
     sensors_event_t event;
 
@@ -756,14 +1079,11 @@ void WipperSnapper_Component_I2C::update() {
     curTime = millis();
     if ((*iter)->getSensorAmbientTempPeriod() != 0L &&
         curTime - (*iter)->getSensorAmbientTempPeriodPrv() >
-            (*iter)->getSensorAmbientTempPeriod()) {
+            (*iter)->getSensorAmbientTempPeriod() &&
+        WS._mqttBudget->isAvailable(WS_PUBLISH_PRIORITY_LOW)) {
       if ((*iter)->getEventAmbientTemp(&event)) {
-        WS_DEBUG_PRINT("Sensor 0x");
-        WS_DEBUG_PRINTHEX((*iter)->getI2CAddress());
-        WS_DEBUG_PRINTLN("");
-        WS_DEBUG_PRINT("\tTemperature: ");
-        WS_DEBUG_PRINT(event.temperature);
-        WS_DEBUG_PRINTLN(" degrees C");
+        WS_LOG_DEBUG(I2C, "Sensor 0x%x\n\tTemperature: %f degrees C",
+                     (*iter)->getI2CAddress(), event.temperature);
 
         // pack event data into msg
         fillEventMessage(
@@ -772,8 +1092,10 @@ void WipperSnapper_Component_I2C::update() {
 
         (*iter)->setSensorAmbientTempPeriodPrv(curTime);
       } else {
-        WS_DEBUG_PRINTLN(
-            "ERROR: Failed to get ambient temperature sensor reading!");
+        readsFailed++;
+        WS_LOG_WARN(
+            I2C, "Failed to get ambient temperature sensor reading from 0x%x!",
+            (*iter)->getI2CAddress());
       }
     }
 
@@ -781,14 +1103,11 @@ void WipperSnapper_Component_I2C::update() {
     curTime = millis();
     if ((*iter)->getSensorAmbientTempFPeriod() != 0L &&
         curTime - (*iter)->getSensorAmbientTempFPeriodPrv() >
-            (*iter)->getSensorAmbientTempFPeriod()) {
+            (*iter)->getSensorAmbientTempFPeriod() &&
+        WS._mqttBudget->isAvailable(WS_PUBLISH_PRIORITY_LOW)) {
       if ((*iter)->getEventAmbientTempF(&event)) {
-        WS_DEBUG_PRINT("Sensor 0x");
-        WS_DEBUG_PRINTHEX((*iter)->getI2CAddress());
-        WS_DEBUG_PRINTLN("");
-        WS_DEBUG_PRINT("\tAmbient Temp.: ");
-        WS_DEBUG_PRINT(event.temperature);
-        WS_DEBUG_PRINTLN("°F");
+        WS_LOG_DEBUG(I2C, "Sensor 0x%x\n\tAmbient Temp.: %f°F",
+                     (*iter)->getI2CAddress(), event.temperature);
 
         (*iter)->setSensorAmbientTempFPeriodPrv(curTime);
 
@@ -796,8 +1115,10 @@ void WipperSnapper_Component_I2C::update() {
             &msgi2cResponse, event.temperature,
             wippersnapper_i2c_v1_SensorType_SENSOR_TYPE_AMBIENT_TEMPERATURE_FAHRENHEIT);
       } else {
-        WS_DEBUG_PRINTLN(
-            "ERROR: Failed to obtain ambient temp. (°F)) sensor reading!");
+        readsFailed++;
+        WS_LOG_WARN(
+            I2C, "Failed to get ambient temp. (°F) sensor reading from 0x%x!",
+            (*iter)->getI2CAddress());
       }
     }
 
@@ -805,14 +1126,11 @@ void WipperSnapper_Component_I2C::update() {
     curTime = millis();
     if ((*iter)->getSensorObjectTempPeriod() != 0L &&
         curTime - (*iter)->getSensorObjectTempPeriodPrv() >
-            (*iter)->getSensorObjectTempPeriod()) {
+            (*iter)->getSensorObjectTempPeriod() &&
+        WS._mqttBudget->isAvailable(WS_PUBLISH_PRIORITY_LOW)) {
       if ((*iter)->getEventObjectTemp(&event)) {
-        WS_DEBUG_PRINT("Sensor 0x");
-        WS_DEBUG_PRINTHEX((*iter)->getI2CAddress());
-        WS_DEBUG_PRINTLN("");
-        WS_DEBUG_PRINT("\tTemperature: ");
-        WS_DEBUG_PRINT(event.temperature);
-        WS_DEBUG_PRINTLN("°C");
+        WS_LOG_DEBUG(I2C, "Sensor 0x%x\n\tTemperature: %f°C",
+                     (*iter)->getI2CAddress(), event.temperature);
 
         // pack event data into msg
         fillEventMessage(
@@ -821,8 +1139,10 @@ void WipperSnapper_Component_I2C::update() {
 
         (*iter)->setSensorObjectTempPeriodPrv(curTime);
       } else {
-        WS_DEBUG_PRINTLN(
-            "ERROR: Failed to get object temperature sensor (°C) reading!");
+        readsFailed++;
+        WS_LOG_WARN(
+            I2C, "Failed to get object temp. (°C) sensor reading from 0x%x!",
+            (*iter)->getI2CAddress());
       }
     }
 
@@ -830,14 +1150,11 @@ void WipperSnapper_Component_I2C::update() {
     curTime = millis();
     if ((*iter)->getSensorObjectTempFPeriod() != 0L &&
         curTime - (*iter)->getSensorObjectTempFPeriodPrv() >
-            (*iter)->getSensorObjectTempFPeriod()) {
+            (*iter)->getSensorObjectTempFPeriod() &&
+        WS._mqttBudget->isAvailable(WS_PUBLISH_PRIORITY_LOW)) {
       if ((*iter)->getEventObjectTempF(&event)) {
-        WS_DEBUG_PRINT("Sensor 0x");
-        WS_DEBUG_PRINTHEX((*iter)->getI2CAddress());
-        WS_DEBUG_PRINTLN("");
-        WS_DEBUG_PRINT("\tTemperature: ");
-        WS_DEBUG_PRINT(event.temperature);
-        WS_DEBUG_PRINTLN("°F");
+        WS_LOG_DEBUG(I2C, "Sensor 0x%x\n\tTemperature: %f°F",
+                     (*iter)->getI2CAddress(), event.temperature);
 
         // pack event data into msg
         fillEventMessage(
@@ -846,8 +1163,10 @@ void WipperSnapper_Component_I2C::update() {
 
         (*iter)->setSensorObjectTempFPeriodPrv(curTime);
       } else {
-        WS_DEBUG_PRINTLN(
-            "ERROR: Failed to get object temperature sensor (°F) reading!");
+        readsFailed++;
+        WS_LOG_WARN(
+            I2C, "Failed to get object temp. (°F) sensor reading from 0x%x!",
+            (*iter)->getI2CAddress());
       }
     }
 
@@ -855,14 +1174,11 @@ void WipperSnapper_Component_I2C::update() {
     curTime = millis();
     if ((*iter)->getSensorRelativeHumidityPeriod() != 0L &&
         curTime - (*iter)->getSensorRelativeHumidityPeriodPrv() >
-            (*iter)->getSensorRelativeHumidityPeriod()) {
+            (*iter)->getSensorRelativeHumidityPeriod() &&
+        WS._mqttBudget->isAvailable(WS_PUBLISH_PRIORITY_LOW)) {
       if ((*iter)->getEventRelativeHumidity(&event)) {
-        WS_DEBUG_PRINT("Sensor 0x");
-        WS_DEBUG_PRINTHEX((*iter)->getI2CAddress());
-        WS_DEBUG_PRINTLN("");
-        WS_DEBUG_PRINT("\tHumidity: ");
-        WS_DEBUG_PRINT(event.relative_humidity);
-        WS_DEBUG_PRINTLN("%RH");
+        WS_LOG_DEBUG(I2C, "Sensor 0x%x\n\tHumidity: %f%%RH",
+                     (*iter)->getI2CAddress(), event.relative_humidity);
 
         // pack event data into msg
         fillEventMessage(
@@ -871,7 +1187,9 @@ void WipperSnapper_Component_I2C::update() {
 
         (*iter)->setSensorRelativeHumidityPeriodPrv(curTime);
       } else {
-        WS_DEBUG_PRINTLN("ERROR: Failed to get humidity sensor reading!");
+        readsFailed++;
+        WS_LOG_WARN(I2C, "Failed to get humidity sensor reading from 0x%x!",
+                    (*iter)->getI2CAddress());
       }
     }
 
@@ -879,14 +1197,11 @@ void WipperSnapper_Component_I2C::update() {
     curTime = millis();
     if ((*iter)->getSensorPressurePeriod() != 0L &&
         curTime - (*iter)->getSensorPressurePeriodPrv() >
-            (*iter)->getSensorPressurePeriod()) {
+            (*iter)->getSensorPressurePeriod() &&
+        WS._mqttBudget->isAvailable(WS_PUBLISH_PRIORITY_LOW)) {
       if ((*iter)->getEventPressure(&event)) {
-        WS_DEBUG_PRINT("Sensor 0x");
-        WS_DEBUG_PRINTHEX((*iter)->getI2CAddress());
-        WS_DEBUG_PRINTLN("");
-        WS_DEBUG_PRINT("\tPressure: ");
-        WS_DEBUG_PRINT(event.pressure);
-        WS_DEBUG_PRINTLN(" hPa");
+        WS_LOG_DEBUG(I2C, "Sensor 0x%x\n\tPressure: %f hPa",
+                     (*iter)->getI2CAddress(), event.pressure);
 
         // pack event data into msg
         fillEventMessage(&msgi2cResponse, event.pressure,
@@ -894,7 +1209,9 @@ void WipperSnapper_Component_I2C::update() {
 
         (*iter)->setSensorPressurePeriodPrv(curTime);
       } else {
-        WS_DEBUG_PRINTLN("ERROR: Failed to get Pressure sensor reading!");
+        readsFailed++;
+        WS_LOG_WARN(I2C, "Failed to get Pressure sensor reading from 0x%x!",
+                    (*iter)->getI2CAddress());
       }
     }
 
@@ -902,20 +1219,19 @@ void WipperSnapper_Component_I2C::update() {
     curTime = millis();
     if ((*iter)->getSensorCO2Period() != 0L &&
         curTime - (*iter)->getSensorCO2PeriodPrv() >
-            (*iter)->getSensorCO2Period()) {
+            (*iter)->getSensorCO2Period() &&
+        WS._mqttBudget->isAvailable(WS_PUBLISH_PRIORITY_LOW)) {
       if ((*iter)->getEventCO2(&event)) {
-        WS_DEBUG_PRINT("Sensor 0x");
-        WS_DEBUG_PRINTHEX((*iter)->getI2CAddress());
-        WS_DEBUG_PRINTLN("");
-        WS_DEBUG_PRINT("\tCO2: ");
-        WS_DEBUG_PRINT(event.CO2);
-        WS_DEBUG_PRINTLN(" ppm");
+        WS_LOG_DEBUG(I2C, "Sensor 0x%x\n\tCO2: %f ppm",
+                     (*iter)->getI2CAddress(), event.CO2);
 
         fillEventMessage(&msgi2cResponse, event.CO2,
                          wippersnapper_i2c_v1_SensorType_SENSOR_TYPE_CO2);
         (*iter)->setSensorCO2PeriodPrv(curTime);
       } else {
-        WS_DEBUG_PRINTLN("ERROR: Failed to obtain CO2 sensor reading!");
+        readsFailed++;
+        WS_LOG_WARN(I2C, "Failed to obtain CO2 sensor reading from 0x%x!",
+                    (*iter)->getI2CAddress());
       }
     }
 
@@ -923,20 +1239,19 @@ void WipperSnapper_Component_I2C::update() {
     curTime = millis();
     if ((*iter)->getSensorECO2Period() != 0L &&
         curTime - (*iter)->getSensorECO2PeriodPrv() >
-            (*iter)->getSensorECO2Period()) {
+            (*iter)->getSensorECO2Period() &&
+        WS._mqttBudget->isAvailable(WS_PUBLISH_PRIORITY_LOW)) {
       if ((*iter)->getEventECO2(&event)) {
-        WS_DEBUG_PRINT("Sensor 0x");
-        WS_DEBUG_PRINTHEX((*iter)->getI2CAddress());
-        WS_DEBUG_PRINTLN("");
-        WS_DEBUG_PRINT("\teCO2: ");
-        WS_DEBUG_PRINT(event.eCO2);
-        WS_DEBUG_PRINTLN(" ppm");
+        WS_LOG_DEBUG(I2C, "Sensor 0x%x\n\teCO2: %f ppm",
+                     (*iter)->getI2CAddress(), event.eCO2);
 
         fillEventMessage(&msgi2cResponse, event.eCO2,
                          wippersnapper_i2c_v1_SensorType_SENSOR_TYPE_ECO2);
         (*iter)->setSensorECO2PeriodPrv(curTime);
       } else {
-        WS_DEBUG_PRINTLN("ERROR: Failed to obtain eCO2 sensor reading!");
+        readsFailed++;
+        WS_LOG_WARN(I2C, "Failed to obtain eCO2 sensor reading from 0x%x!",
+                    (*iter)->getI2CAddress());
       }
     }
 
@@ -944,20 +1259,19 @@ void WipperSnapper_Component_I2C::update() {
     curTime = millis();
     if ((*iter)->getSensorTVOCPeriod() != 0L &&
         curTime - (*iter)->getSensorTVOCPeriodPrv() >
-            (*iter)->getSensorTVOCPeriod()) {
+            (*iter)->getSensorTVOCPeriod() &&
+        WS._mqttBudget->isAvailable(WS_PUBLISH_PRIORITY_LOW)) {
       if ((*iter)->getEventTVOC(&event)) {
-        WS_DEBUG_PRINT("Sensor 0x");
-        WS_DEBUG_PRINTHEX((*iter)->getI2CAddress());
-        WS_DEBUG_PRINTLN("");
-        WS_DEBUG_PRINT("\tTVOC: ");
-        WS_DEBUG_PRINT(event.tvoc);
-        WS_DEBUG_PRINTLN(" ppb");
+        WS_LOG_DEBUG(I2C, "Sensor 0x%x\n\tTVOC: %f ppb",
+                     (*iter)->getI2CAddress(), event.tvoc);
 
         fillEventMessage(&msgi2cResponse, event.tvoc,
                          wippersnapper_i2c_v1_SensorType_SENSOR_TYPE_TVOC);
         (*iter)->setSensorTVOCPeriodPrv(curTime);
       } else {
-        WS_DEBUG_PRINTLN("ERROR: Failed to obtain TVOC sensor reading!");
+        readsFailed++;
+        WS_LOG_WARN(I2C, "Failed to obtain TVOC sensor reading from 0x%x!",
+                    (*iter)->getI2CAddress());
       }
     }
 
@@ -965,14 +1279,11 @@ void WipperSnapper_Component_I2C::update() {
     curTime = millis();
     if ((*iter)->getSensorAltitudePeriod() != 0L &&
         curTime - (*iter)->getSensorAltitudePeriodPrv() >
-            (*iter)->getSensorAltitudePeriod()) {
+            (*iter)->getSensorAltitudePeriod() &&
+        WS._mqttBudget->isAvailable(WS_PUBLISH_PRIORITY_LOW)) {
       if ((*iter)->getEventAltitude(&event)) {
-        WS_DEBUG_PRINT("Sensor 0x");
-        WS_DEBUG_PRINTHEX((*iter)->getI2CAddress());
-        WS_DEBUG_PRINTLN("");
-        WS_DEBUG_PRINT("\tAltitude: ");
-        WS_DEBUG_PRINT(event.data[0]);
-        WS_DEBUG_PRINTLN(" m");
+        WS_LOG_DEBUG(I2C, "Sensor 0x%x\n\tAltitude: %f m",
+                     (*iter)->getI2CAddress(), event.data[0]);
 
         // pack event data into msg
         fillEventMessage(&msgi2cResponse, event.data[0],
@@ -980,7 +1291,9 @@ void WipperSnapper_Component_I2C::update() {
 
         (*iter)->setSensorAltitudePeriodPrv(curTime);
       } else {
-        WS_DEBUG_PRINTLN("ERROR: Failed to get altitude sensor reading!");
+        readsFailed++;
+        WS_LOG_WARN(I2C, "Failed to get altitude sensor reading from 0x%x!",
+                    (*iter)->getI2CAddress());
       }
     }
 
@@ -988,14 +1301,11 @@ void WipperSnapper_Component_I2C::update() {
     curTime = millis();
     if ((*iter)->getSensorLightPeriod() != 0L &&
         curTime - (*iter)->getSensorLightPeriodPrv() >
-            (*iter)->getSensorLightPeriod()) {
+            (*iter)->getSensorLightPeriod() &&
+        WS._mqttBudget->isAvailable(WS_PUBLISH_PRIORITY_LOW)) {
       if ((*iter)->getEventLight(&event)) {
-        WS_DEBUG_PRINT("Sensor 0x");
-        WS_DEBUG_PRINTHEX((*iter)->getI2CAddress());
-        WS_DEBUG_PRINTLN("");
-        WS_DEBUG_PRINT("\tLight: ");
-        WS_DEBUG_PRINT(event.light);
-        WS_DEBUG_PRINTLN(" lux");
+        WS_LOG_DEBUG(I2C, "Sensor 0x%x\n\tLight: %f lux",
+                     (*iter)->getI2CAddress(), event.light);
 
         // pack event data into msg
         fillEventMessage(&msgi2cResponse, event.light,
@@ -1003,7 +1313,9 @@ void WipperSnapper_Component_I2C::update() {
 
         (*iter)->setSensorLightPeriodPrv(curTime);
       } else {
-        WS_DEBUG_PRINTLN("ERROR: Failed to get light sensor reading!");
+        readsFailed++;
+        WS_LOG_WARN(I2C, "Failed to get light sensor reading from 0x%x!",
+                    (*iter)->getI2CAddress());
       }
     }
 
@@ -1011,20 +1323,19 @@ void WipperSnapper_Component_I2C::update() {
     curTime = millis();
     if ((*iter)->getSensorPM10_STDPeriod() != 0L &&
         curTime - (*iter)->getSensorPM10_STDPeriodPrv() >
-            (*iter)->getSensorPM10_STDPeriod()) {
+            (*iter)->getSensorPM10_STDPeriod() &&
+        WS._mqttBudget->isAvailable(WS_PUBLISH_PRIORITY_LOW)) {
       if ((*iter)->getEventPM10_STD(&event)) {
-        WS_DEBUG_PRINT("Sensor 0x");
-        WS_DEBUG_PRINTHEX((*iter)->getI2CAddress());
-        WS_DEBUG_PRINTLN("");
-        WS_DEBUG_PRINT("\tPM1.0: ");
-        WS_DEBUG_PRINT(event.pm10_std);
-        WS_DEBUG_PRINTLN(" ppm");
+        WS_LOG_DEBUG(I2C, "Sensor 0x%x\n\tPM1.0: %f ppm",
+                     (*iter)->getI2CAddress(), event.pm10_std);
 
         // pack event data into msg
         fillEventMessage(&msgi2cResponse, event.pm10_std,
                          wippersnapper_i2c_v1_SensorType_SENSOR_TYPE_PM10_STD);
       } else {
-        WS_DEBUG_PRINTLN("ERROR: Failed to get PM1.0 sensor reading!");
+        readsFailed++;
+        WS_LOG_WARN(I2C, "Failed to get PM1.0 sensor reading from 0x%x!",
+                    (*iter)->getI2CAddress());
       }
       // try again in curTime seconds
       (*iter)->setSensorPM10_STDPeriodPrv(curTime);
@@ -1034,20 +1345,19 @@ void WipperSnapper_Component_I2C::update() {
     curTime = millis();
     if ((*iter)->getSensorPM25_STDPeriod() != 0L &&
         curTime - (*iter)->getSensorPM25_STDPeriodPrv() >
-            (*iter)->getSensorPM25_STDPeriod()) {
+            (*iter)->getSensorPM25_STDPeriod() &&
+        WS._mqttBudget->isAvailable(WS_PUBLISH_PRIORITY_LOW)) {
       if ((*iter)->getEventPM25_STD(&event)) {
-        WS_DEBUG_PRINT("Sensor 0x");
-        WS_DEBUG_PRINTHEX((*iter)->getI2CAddress());
-        WS_DEBUG_PRINTLN("");
-        WS_DEBUG_PRINT("\tPM2.5: ");
-        WS_DEBUG_PRINT(event.pm25_std);
-        WS_DEBUG_PRINTLN(" ppm");
+        WS_LOG_DEBUG(I2C, "Sensor 0x%x\n\tPM2.5: %f ppm",
+                     (*iter)->getI2CAddress(), event.pm25_std);
 
         // pack event data into msg
         fillEventMessage(&msgi2cResponse, event.pm25_std,
                          wippersnapper_i2c_v1_SensorType_SENSOR_TYPE_PM25_STD);
       } else {
-        WS_DEBUG_PRINTLN("ERROR: Failed to get PM2.5 sensor reading!");
+        readsFailed++;
+        WS_LOG_WARN(I2C, "Failed to get PM2.5 sensor reading from 0x%x!",
+                    (*iter)->getI2CAddress());
       }
       // try again in curTime seconds
       (*iter)->setSensorPM25_STDPeriodPrv(curTime);
@@ -1057,20 +1367,19 @@ void WipperSnapper_Component_I2C::update() {
     curTime = millis();
     if ((*iter)->getSensorPM100_STDPeriod() != 0L &&
         curTime - (*iter)->getSensorPM100_STDPeriodPrv() >
-            (*iter)->getSensorPM100_STDPeriod()) {
+            (*iter)->getSensorPM100_STDPeriod() &&
+        WS._mqttBudget->isAvailable(WS_PUBLISH_PRIORITY_LOW)) {
       if ((*iter)->getEventPM100_STD(&event)) {
-        WS_DEBUG_PRINT("Sensor 0x");
-        WS_DEBUG_PRINTHEX((*iter)->getI2CAddress());
-        WS_DEBUG_PRINTLN("");
-        WS_DEBUG_PRINT("\tPM10.0: ");
-        WS_DEBUG_PRINT(event.pm25_std);
-        WS_DEBUG_PRINTLN(" ppm");
+        WS_LOG_DEBUG(I2C, "Sensor 0x%x\n\tPM10.0: %f ppm",
+                     (*iter)->getI2CAddress(), event.pm25_std);
 
         // pack event data into msg
         fillEventMessage(&msgi2cResponse, event.pm25_std,
                          wippersnapper_i2c_v1_SensorType_SENSOR_TYPE_PM100_STD);
       } else {
-        WS_DEBUG_PRINTLN("ERROR: Failed to get PM10.0 sensor reading!");
+        readsFailed++;
+        WS_LOG_WARN(I2C, "Failed to get PM10.0 sensor reading from 0x%x!",
+                    (*iter)->getI2CAddress());
       }
       (*iter)->setSensorPM100_STDPeriodPrv(
           curTime); // try again in curTime seconds
@@ -1080,20 +1389,19 @@ void WipperSnapper_Component_I2C::update() {
     curTime = millis();
     if ((*iter)->getSensorVoltagePeriod() != 0L &&
         curTime - (*iter)->getSensorVoltagePeriodPrv() >
-            (*iter)->getSensorVoltagePeriod()) {
+            (*iter)->getSensorVoltagePeriod() &&
+        WS._mqttBudget->isAvailable(WS_PUBLISH_PRIORITY_LOW)) {
       if ((*iter)->getEventVoltage(&event)) {
-        WS_DEBUG_PRINT("Sensor 0x");
-        WS_DEBUG_PRINTHEX((*iter)->getI2CAddress());
-        WS_DEBUG_PRINTLN("");
-        WS_DEBUG_PRINT("\tVoltage: ");
-        WS_DEBUG_PRINT(event.voltage);
-        WS_DEBUG_PRINTLN(" v");
+        WS_LOG_DEBUG(I2C, "Sensor 0x%x\n\tVoltage: %f v",
+                     (*iter)->getI2CAddress(), event.voltage);
 
         // pack event data into msg
         fillEventMessage(&msgi2cResponse, event.voltage,
                          wippersnapper_i2c_v1_SensorType_SENSOR_TYPE_VOLTAGE);
       } else {
-        WS_DEBUG_PRINTLN("ERROR: Failed to get voltage sensor reading!");
+        readsFailed++;
+        WS_LOG_WARN(I2C, "Failed to get voltage sensor reading from 0x%x!",
+                    (*iter)->getI2CAddress());
       }
       // try again in curTime seconds
       (*iter)->setSensorVoltagePeriodPrv(curTime);
@@ -1103,22 +1411,21 @@ void WipperSnapper_Component_I2C::update() {
     curTime = millis();
     if ((*iter)->getSensorUnitlessPercentPeriod() != 0L &&
         curTime - (*iter)->getSensorUnitlessPercentPeriodPrv() >
-            (*iter)->getSensorUnitlessPercentPeriod()) {
+            (*iter)->getSensorUnitlessPercentPeriod() &&
+        WS._mqttBudget->isAvailable(WS_PUBLISH_PRIORITY_LOW)) {
       if ((*iter)->getEventUnitlessPercent(&event)) {
-        WS_DEBUG_PRINT("Sensor 0x");
-        WS_DEBUG_PRINTHEX((*iter)->getI2CAddress());
-        WS_DEBUG_PRINTLN("");
-        WS_DEBUG_PRINT("\tRead: ");
-        WS_DEBUG_PRINT(event.unitless_percent);
-        WS_DEBUG_PRINTLN(" %");
+        WS_LOG_DEBUG(I2C, "Sensor 0x%x\n\tRead: %f %%",
+                     (*iter)->getI2CAddress(), event.unitless_percent);
 
         // pack event data into msg
         fillEventMessage(
             &msgi2cResponse, event.unitless_percent,
             wippersnapper_i2c_v1_SensorType_SENSOR_TYPE_UNITLESS_PERCENT);
       } else {
-        WS_DEBUG_PRINTLN(
-            "ERROR: Failed to get unitless percent sensor reading!");
+        readsFailed++;
+        WS_LOG_WARN(
+            I2C, "Failed to get unitless percent sensor reading from 0x%x!",
+            (*iter)->getI2CAddress());
       }
       // try again in curTime seconds
       (*iter)->setSensorUnitlessPercentPeriodPrv(curTime);
@@ -1128,18 +1435,18 @@ void WipperSnapper_Component_I2C::update() {
     curTime = millis();
     if ((*iter)->getSensorRawPeriod() != 0L &&
         curTime - (*iter)->getSensorRawPeriodPrv() >
-            (*iter)->getSensorRawPeriod()) {
+            (*iter)->getSensorRawPeriod() &&
+        WS._mqttBudget->isAvailable(WS_PUBLISH_PRIORITY_LOW)) {
       if ((*iter)->getEventRaw(&event)) {
-        WS_DEBUG_PRINT("Sensor 0x");
-        WS_DEBUG_PRINTHEX((*iter)->getI2CAddress());
-        WS_DEBUG_PRINTLN("");
-        WS_DEBUG_PRINT("\tRaw: ");
-        WS_DEBUG_PRINTLN(event.data[0]);
+        WS_LOG_DEBUG(I2C, "Sensor 0x%x\n\tRaw: %f", (*iter)->getI2CAddress(),
+                     event.data[0]);
 
         fillEventMessage(&msgi2cResponse, event.data[0],
                          wippersnapper_i2c_v1_SensorType_SENSOR_TYPE_RAW);
       } else {
-        WS_DEBUG_PRINTLN("ERROR: Failed to obtain Raw sensor reading!");
+        readsFailed++;
+        WS_LOG_WARN(I2C, "Failed to obtain Raw sensor reading from 0x%x!",
+                    (*iter)->getI2CAddress());
       }
       (*iter)->setSensorRawPeriodPrv(curTime);
     }
@@ -1148,21 +1455,20 @@ void WipperSnapper_Component_I2C::update() {
     curTime = millis();
     if ((*iter)->getSensorGasResistancePeriod() != 0L &&
         curTime - (*iter)->getSensorGasResistancePeriodPrv() >
-            (*iter)->getSensorGasResistancePeriod()) {
+            (*iter)->getSensorGasResistancePeriod() &&
+        WS._mqttBudget->isAvailable(WS_PUBLISH_PRIORITY_LOW)) {
       if ((*iter)->getEventGasResistance(&event)) {
-        WS_DEBUG_PRINT("Sensor 0x");
-        WS_DEBUG_PRINTHEX((*iter)->getI2CAddress());
-        WS_DEBUG_PRINTLN("");
-        WS_DEBUG_PRINT("\tGas Resistance: ");
-        WS_DEBUG_PRINT(event.gas_resistance);
-        WS_DEBUG_PRINT(" ohms");
+        WS_LOG_DEBUG(I2C, "Sensor 0x%x\n\tGas Resistance: %f ohms",
+                     (*iter)->getI2CAddress(), event.gas_resistance);
 
         fillEventMessage(
             &msgi2cResponse, event.gas_resistance,
             wippersnapper_i2c_v1_SensorType_SENSOR_TYPE_GAS_RESISTANCE);
       } else {
-        WS_DEBUG_PRINTLN(
-            "ERROR: Failed to obtain gas resistance sensor reading!");
+        readsFailed++;
+        WS_LOG_WARN(
+            I2C, "Failed to obtain gas resistance sensor reading from 0x%x!",
+            (*iter)->getI2CAddress());
       }
       (*iter)->setSensorGasResistancePeriodPrv(curTime);
     }
@@ -1171,18 +1477,18 @@ void WipperSnapper_Component_I2C::update() {
     curTime = millis();
     if ((*iter)->getSensorNOxIndexPeriod() != 0L &&
         curTime - (*iter)->getSensorNOxIndexPeriodPrv() >
-            (*iter)->getSensorNOxIndexPeriod()) {
+            (*iter)->getSensorNOxIndexPeriod() &&
+        WS._mqttBudget->isAvailable(WS_PUBLISH_PRIORITY_LOW)) {
       if ((*iter)->getEventNOxIndex(&event)) {
-        WS_DEBUG_PRINT("Sensor 0x");
-        WS_DEBUG_PRINTHEX((*iter)->getI2CAddress());
-        WS_DEBUG_PRINTLN("");
-        WS_DEBUG_PRINT("\tNOx Index: ");
-        WS_DEBUG_PRINT(event.nox_index);
+        WS_LOG_DEBUG(I2C, "Sensor 0x%x\n\tNOx Index: %f",
+                     (*iter)->getI2CAddress(), event.nox_index);
 
         fillEventMessage(&msgi2cResponse, event.data[0],
                          wippersnapper_i2c_v1_SensorType_SENSOR_TYPE_NOX_INDEX);
       } else {
-        WS_DEBUG_PRINTLN("ERROR: Failed to obtain NOx index sensor reading!");
+        readsFailed++;
+        WS_LOG_WARN(I2C, "Failed to obtain NOx index sensor reading from 0x%x!",
+                    (*iter)->getI2CAddress());
       }
       (*iter)->setSensorNOxIndexPeriodPrv(curTime);
     }
@@ -1191,18 +1497,18 @@ void WipperSnapper_Component_I2C::update() {
     curTime = millis();
     if ((*iter)->getSensorVOCIndexPeriod() != 0L &&
         curTime - (*iter)->getSensorVOCIndexPeriodPrv() >
-            (*iter)->getSensorVOCIndexPeriod()) {
+            (*iter)->getSensorVOCIndexPeriod() &&
+        WS._mqttBudget->isAvailable(WS_PUBLISH_PRIORITY_LOW)) {
       if ((*iter)->getEventVOCIndex(&event)) {
-        WS_DEBUG_PRINT("Sensor 0x");
-        WS_DEBUG_PRINTHEX((*iter)->getI2CAddress());
-        WS_DEBUG_PRINTLN("");
-        WS_DEBUG_PRINT("\tVOC Index: ");
-        WS_DEBUG_PRINT(event.voc_index);
+        WS_LOG_DEBUG(I2C, "Sensor 0x%x\n\tVOC Index: %f",
+                     (*iter)->getI2CAddress(), event.voc_index);
 
         fillEventMessage(&msgi2cResponse, event.data[0],
                          wippersnapper_i2c_v1_SensorType_SENSOR_TYPE_VOC_INDEX);
       } else {
-        WS_DEBUG_PRINTLN("ERROR: Failed to obtain VOC index sensor reading!");
+        readsFailed++;
+        WS_LOG_WARN(I2C, "Failed to obtain VOC index sensor reading from 0x%x!",
+                    (*iter)->getI2CAddress());
       }
       (*iter)->setSensorVOCIndexPeriodPrv(curTime);
     }
@@ -1210,13 +1516,11 @@ void WipperSnapper_Component_I2C::update() {
     curTime = millis();
     if ((*iter)->sensorProximityPeriod() != 0L &&
         curTime - (*iter)->SensorProximityPeriodPrv() >
-            (*iter)->sensorProximityPeriod()) {
+            (*iter)->sensorProximityPeriod() &&
+        WS._mqttBudget->isAvailable(WS_PUBLISH_PRIORITY_LOW)) {
       if ((*iter)->getEventProximity(&event)) {
-        WS_DEBUG_PRINT("Sensor 0x");
-        WS_DEBUG_PRINTHEX((*iter)->getI2CAddress());
-        WS_DEBUG_PRINTLN("");
-        WS_DEBUG_PRINT("\tProximity: ");
-        WS_DEBUG_PRINT(event.data[0]);
+        WS_LOG_DEBUG(I2C, "Sensor 0x%x\n\tProximity: %f",
+                     (*iter)->getI2CAddress(), event.data[0]);
 
         // pack event data into msg
         fillEventMessage(&msgi2cResponse, event.data[0],
@@ -1224,19 +1528,38 @@ void WipperSnapper_Component_I2C::update() {
 
         (*iter)->setSensorProximityPeriodPrv(curTime);
       } else {
-        WS_DEBUG_PRINTLN("ERROR: Failed to get proximity sensor reading!");
+        readsFailed++;
+        WS_LOG_WARN(I2C, "Failed to get proximity sensor reading from 0x%x!",
+                    (*iter)->getI2CAddress());
       }
     }
 
+    // Report the outcome of this poll to the bus supervisor. A read can
+    // fail without a bus error, such as an SCD30 or SCD4x with no new
+    // measurement yet, so the poll only fails if no read succeeded and
+    // the device no longer acknowledges its address.
+    uint32_t pollLatency = (uint32_t)(micros() - pollStart);
+    pb_size_t eventCount =
+        msgi2cResponse.payload.resp_i2c_device_event.sensor_event_count;
+    if (eventCount > 0 || readsFailed > 0)
+      supervisePoll(*iter, eventCount > 0 || isDeviceResponding(*iter),
+                    pollLatency);
+
+#ifdef I2C_PER_TRANSACTION_CLOCK
+    if (isClockLowered)
+      _i2c->setClock(_busFrequency);
+#endif
+
     // Did this driver obtain data from sensors?
     if (msgi2cResponse.payload.resp_i2c_device_event.sensor_event_count == 0)
       continue;
 
-    displayDeviceEventMessage(&msgi2cResponse, (*iter)->getI2CAddress());
+    displayDeviceEventMessage(&msgi2cResponse,
+                              (*iter)->getEncodedI2CAddress());
 
     // Encode and publish I2CDeviceEvent message
     if (!encodePublishI2CDeviceEventMsg(&msgi2cResponse,
-                                        (*iter)->getI2CAddress())) {
+                                        (*iter)->getEncodedI2CAddress())) {
       WS_DEBUG_PRINTLN("ERROR: Failed to encode and publish I2CDeviceEvent!");
       continue;
     }
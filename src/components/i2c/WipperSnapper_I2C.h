@@ -18,6 +18,7 @@
 
 #include "Wippersnapper.h"
 #include <Wire.h>
+#include <algorithm>
 
 #include "drivers/WipperSnapper_I2C_Driver.h"
 #include "drivers/WipperSnapper_I2C_Driver_ADT7410.h"
@@ -48,6 +49,42 @@
 #include "drivers/WipperSnapper_I2C_Driver_VL53L0X.h"
 
 #define I2C_TIMEOUT_MS 50 ///< Default I2C timeout, in milliseconds.
+#define I2C_SCAN_PROBE_TIMEOUT_MS                                              \
+  5 ///< Per-address timeout used while scanning, in milliseconds.
+#define I2C_SCAN_MAX_BUS_FAULTS                                                \
+  3 ///< Consecutive bus faults tolerated before a scan is aborted.
+#define I2C_SCAN_CACHE_TTL_MS                                                  \
+  10000 ///< Time a cached scan result remains valid, in milliseconds.
+#define I2C_RECOVERY_THRESHOLD                                                 \
+  3 ///< Consecutive failed polls of a device before bus recovery is attempted
+#define I2C_BACKOFF_BASE_MS                                                    \
+  1000 ///< Initial time a failing device is held off, in milliseconds.
+#define I2C_BACKOFF_MAX_MS                                                     \
+  300000 ///< Maximum time a failing device is held off, in milliseconds.
+// The bus health report is published to a topic the stock broker doesn't
+// define, add e.g. -DI2C_HEALTH_INTERVAL_MS=300000 to the build flags to
+// enable it.
+#ifndef I2C_HEALTH_INTERVAL_MS
+#define I2C_HEALTH_INTERVAL_MS                                                 \
+  0 ///< Time between bus health reports, in milliseconds, 0 disables them.
+#endif
+#define I2C_CLOCK_STRETCH_TIMEOUT_MS                                           \
+  200 ///< I2C timeout used while a device requires clock stretching, in ms.
+// Devices behind a TCA9548A multiplexer are addressed as
+// (mux channel << 16) | (mux address << 8) | device address
+#define I2C_DEVICE_ADDRESS(addr)                                               \
+  ((uint16_t)((addr)&0x7F)) ///< Device address from an encoded address
+#define I2C_MUX_ADDRESS(addr)                                                  \
+  ((uint8_t)(((addr) >> 8) & 0x7F)) ///< Mux address from an encoded address
+#define I2C_MUX_CHANNEL(addr)                                                  \
+  ((uint8_t)(((addr) >> 16) & 0x07)) ///< Mux channel from an encoded address
+#define I2C_MUX_ADDRESS_MIN                                                    \
+  0x70 ///< Lowest address a TCA9548A multiplexer can be strapped to
+#define I2C_MUX_ADDRESS_MAX                                                    \
+  0x77 ///< Highest address a TCA9548A multiplexer can be strapped to
+// Uncomment to run the bus at the fastest attached device's SCL frequency and
+// temporarily lower the clock while polling slower devices.
+// #define I2C_PER_TRANSACTION_CLOCK
 
 // forward decl.
 class Wippersnapper;
@@ -65,7 +102,14 @@ public:
   bool isInitialized();
   wippersnapper_i2c_v1_BusResponse getBusStatus();
 
-  wippersnapper_i2c_v1_I2CBusScanResponse scanAddresses();
+  wippersnapper_i2c_v1_I2CBusScanResponse scanAddresses(bool useCache = true);
+  void invalidateScanCache();
+  uint32_t getScanProbeTime();
+  bool isBusLineStuck();
+  bool recoverBus();
+  uint32_t getBusRecoveryCount();
+  void updateBusFrequency();
+  uint32_t getBusFrequency();
   bool
   initI2CDevice(wippersnapper_i2c_v1_I2CDeviceInitRequest *msgDeviceInitReq);
 
@@ -88,38 +132,39 @@ public:
       uint32_t sensorAddress);
 
 private:
+  WipperSnapper_I2C_Driver *createI2CDriver(const char *deviceName,
+                                            uint16_t i2cAddress);
+  bool selectMuxChannel(uint8_t muxAddress, uint8_t muxChannel);
+  void disconnectMuxes();
+  void removeI2CDevice(uint32_t encodedAddress);
+  void supervisePoll(WipperSnapper_I2C_Driver *driver, bool success,
+                     uint32_t latencyUs);
+  void printDeviceStats(WipperSnapper_I2C_Driver *driver);
+  bool isDeviceResponding(WipperSnapper_I2C_Driver *driver);
+  void reportBusHealth();
   bool _isInit = false;
   int32_t _portNum;
   TwoWire *_i2c = nullptr;
   wippersnapper_i2c_v1_BusResponse _busStatusResponse;
+  int32_t _pinSCL; ///< SCL pin, used for stuck-line detection
+  int32_t _pinSDA; ///< SDA pin, used for stuck-line detection
+  uint32_t _busFrequencyDefault; ///< SCL frequency used with no devices, Hz
+  uint32_t _busFrequency;        ///< Current SCL frequency, in Hz
+  uint32_t _busFrequencyMax = 0; ///< Requested SCL frequency, 0 if none, Hz
+  bool _isClockStretching = false; ///< True if the I2C timeout was extended
+                                   ///< for a clock-stretching device
+  // Bus scan cache
+  bool _isScanCached = false; ///< True if _scanCache holds a valid result
+  unsigned long _scanCacheTime = 0; ///< Time the cached scan was taken, in ms
+  wippersnapper_i2c_v1_I2CBusScanResponse
+      _scanCache; ///< Result of the most recent bus scan
+  uint32_t _scanProbeTimeUs = 0; ///< Average time per scan probe, in us
+  uint32_t _busRecoveryCount = 0; ///< Number of bus recoveries performed
+  unsigned long _prvHealthReport = 0; ///< When bus health was last reported
   std::vector<WipperSnapper_I2C_Driver *> drivers; ///< List of sensor drivers
-  // Sensor driver objects
-  WipperSnapper_I2C_Driver_AHTX0 *_ahtx0 = nullptr;
-  WipperSnapper_I2C_Driver_DPS310 *_dps310 = nullptr;
-  WipperSnapper_I2C_Driver_SCD30 *_scd30 = nullptr;
-  WipperSnapper_I2C_Driver_BH1750 *_bh1750 = nullptr;
-  WipperSnapper_I2C_Driver_BME280 *_bme280 = nullptr;
-  WipperSnapper_I2C_Driver_BMP280 *_bmp280 = nullptr;
-  WipperSnapper_I2C_Driver_BME680 *_bme680 = nullptr;
-  WipperSnapper_I2C_Driver_HTS221 *_hts221 = nullptr;
-  WipperSnapper_I2C_Driver_MCP9808 *_mcp9808 = nullptr;
-  WipperSnapper_I2C_Driver_TMP117 *_tmp117 = nullptr;
-  WipperSnapper_I2C_Driver_TSL2591 *_tsl2591 = nullptr;
-  WipperSnapper_I2C_Driver_VEML7700 *_veml7700 = nullptr;
-  WipperSnapper_I2C_Driver_SCD4X *_scd40 = nullptr;
-  WipperSnapper_I2C_Driver_SEN5X *_sen5x = nullptr;
-  WipperSnapper_I2C_Driver_SGP30 *_sgp30 = nullptr;
-  WipperSnapper_I2C_Driver_PCT2075 *_pct2075 = nullptr;
-  WipperSnapper_I2C_Driver_PM25 *_pm25 = nullptr;
-  WipperSnapper_I2C_Driver_SI7021 *_si7021 = nullptr;
-  WipperSnapper_I2C_Driver_SHT4X *_sht4x = nullptr;
-  WipperSnapper_I2C_Driver_SHT3X *_sht3x = nullptr;
-  WipperSnapper_I2C_Driver_SHTC3 *_shtc3 = nullptr;
-  WipperSnapper_I2C_Driver_LC709203F *_lc = nullptr;
-  WipperSnapper_I2C_Driver_STEMMA_Soil_Sensor *_ss = nullptr;
-  WipperSnapper_I2C_Driver_VL53L0X *_vl53l0x = nullptr;
-  WipperSnapper_I2C_Driver_MAX17048 *_max17048 = nullptr;
-  WipperSnapper_I2C_Driver_ADT7410 *_adt7410 = nullptr;
+  // TCA9548A multiplexer channel cache
+  uint8_t _muxAddressSelected = 0; ///< Address of the connected multiplexer
+  uint8_t _muxChannelSelected = 0; ///< Connected multiplexer channel
 };
 extern Wippersnapper WS;
 
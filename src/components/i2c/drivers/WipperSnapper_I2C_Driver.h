@@ -16,9 +16,20 @@
 #ifndef WipperSnapper_I2C_Driver_H
 #define WipperSnapper_I2C_Driver_H
 
+#include "components/pool/ws_pool.h"
 #include <Adafruit_Sensor.h>
 #include <Arduino.h>
 
+#define I2C_FREQ_STANDARD_MODE 100000 ///< Standard-mode SCL frequency, in Hz
+#define I2C_FREQ_FAST_MODE 400000     ///< Fast-mode SCL frequency, in Hz
+
+#define I2C_DRIVER_POOL_SIZE 8 ///< Number of I2C drivers held by the pool
+#define I2C_DRIVER_POOL_BLOCK_SIZE                                             \
+  256 ///< Size of an I2C driver pool block, larger drivers use the heap
+
+extern ws_block_pool<I2C_DRIVER_POOL_BLOCK_SIZE, I2C_DRIVER_POOL_SIZE>
+    i2cDriverPool; ///< Storage for I2C driver objects
+
 /**************************************************************************/
 /*!
     @brief  Base class for I2C Drivers.
@@ -46,7 +57,30 @@ public:
       @brief    Destructor for an I2C sensor.
   */
   /*******************************************************************************/
-  ~WipperSnapper_I2C_Driver() { _sensorAddress = 0; }
+  virtual ~WipperSnapper_I2C_Driver() { _sensorAddress = 0; }
+
+  /*******************************************************************************/
+  /*!
+      @brief    Allocates an I2C driver object from the driver pool.
+                Declared noexcept so a failed allocation makes the new
+                expression yield nullptr instead of constructing into it.
+      @param    size
+                Size of the driver object, in bytes.
+      @returns  Pointer to the allocated memory, nullptr on failure.
+  */
+  /*******************************************************************************/
+  static void *operator new(size_t size) noexcept {
+    return i2cDriverPool.allocate(size);
+  }
+
+  /*******************************************************************************/
+  /*!
+      @brief    Returns an I2C driver object's memory to the driver pool.
+      @param    ptr
+                Pointer to the driver object.
+  */
+  /*******************************************************************************/
+  static void operator delete(void *ptr) { i2cDriverPool.release(ptr); }
 
   /*******************************************************************************/
   /*!
@@ -54,7 +88,7 @@ public:
       @returns  True if initialized successfully, False otherwise.
   */
   /*******************************************************************************/
-  bool begin() { return false; }
+  virtual bool begin() { return false; }
 
   /*******************************************************************************/
   /*!
@@ -158,6 +192,49 @@ public:
     }
   }
 
+  /*******************************************************************************/
+  /*!
+      @brief    Schedules the first reading of each configured sensor at
+                its phase within the sensor's period, instead of as soon
+                as the device is configured.
+      @param    configuredAt
+                When the device was configured, in milliseconds.
+      @param    phase
+                Phase within each period, in 1/65536ths of the period.
+  */
+  /*******************************************************************************/
+  void schedulePolls(long configuredAt, uint16_t phase) {
+    long *periods[][2] = {
+        {&_tempSensorPeriod, &_tempSensorPeriodPrv},
+        {&_humidSensorPeriod, &_humidSensorPeriodPrv},
+        {&_pressureSensorPeriod, &_pressureSensorPeriodPrv},
+        {&_CO2SensorPeriod, &_CO2SensorPeriodPrv},
+        {&_ECO2SensorPeriod, &_ECO2SensorPeriodPrv},
+        {&_TVOCSensorPeriod, &_TVOCSensorPeriodPrv},
+        {&_altitudeSensorPeriod, &_altitudeSensorPeriodPrv},
+        {&_objectTempSensorPeriod, &_objectTempSensorPeriodPrv},
+        {&_lightSensorPeriod, &_lightSensorPeriodPrv},
+        {&_PM10SensorPeriod, &_PM10SensorPeriodPrv},
+        {&_PM25SensorPeriod, &_PM25SensorPeriodPrv},
+        {&_PM100SensorPeriod, &_PM100SensorPeriodPrv},
+        {&_unitlessPercentPeriod, &_unitlessPercentPeriodPrv},
+        {&_voltagePeriod, &_voltagePeriodPrv},
+        {&_rawSensorPeriod, &_rawSensorPeriodPrv},
+        {&_ambientTempFPeriod, &_ambientTempFPeriodPrv},
+        {&_objectTempFPeriod, &_objectTempFPeriodPrv},
+        {&_gasResistancePeriod, &_gasResistancePeriodPrv},
+        {&_NOxIndexPeriod, &_NOxIndexPeriodPrv},
+        {&_VOCIndexPeriod, &_VOCIndexPeriodPrv},
+        {&_proximitySensorPeriod, &_proximitySensorPeriodPrv},
+    };
+    for (size_t i = 0; i < sizeof(periods) / sizeof(periods[0]); i++) {
+      long period = *periods[i][0];
+      if (period > 0)
+        *periods[i][1] =
+            configuredAt - period + (long)(((uint64_t)period * phase) >> 16);
+    }
+  }
+
   /*******************************************************************************/
   /*!
       @brief    Gets the I2C device's address.
@@ -166,6 +243,167 @@ public:
   /*******************************************************************************/
   uint16_t getI2CAddress() { return _sensorAddress; }
 
+  /*******************************************************************************/
+  /*!
+      @brief    Sets the TCA9548A multiplexer channel the device is
+                connected to.
+      @param    muxAddress
+                The multiplexer's I2C address, 0 if the device is not
+                behind a multiplexer.
+      @param    muxChannel
+                The multiplexer channel, 0-7.
+  */
+  /*******************************************************************************/
+  void setMuxChannel(uint8_t muxAddress, uint8_t muxChannel) {
+    _muxAddress = muxAddress;
+    _muxChannel = muxChannel;
+  }
+
+  /*******************************************************************************/
+  /*!
+      @brief    Gets the address of the multiplexer the device is behind.
+      @returns  The multiplexer's I2C address, 0 if there is none.
+  */
+  /*******************************************************************************/
+  uint8_t getMuxAddress() { return _muxAddress; }
+
+  /*******************************************************************************/
+  /*!
+      @brief    Gets the multiplexer channel the device is connected to.
+      @returns  The multiplexer channel.
+  */
+  /*******************************************************************************/
+  uint8_t getMuxChannel() { return _muxChannel; }
+
+  /*******************************************************************************/
+  /*!
+      @brief    Gets a key which sorts devices by multiplexer and channel.
+      @returns  Multiplexer address and channel, packed.
+  */
+  /*******************************************************************************/
+  uint16_t getMuxKey() { return ((uint16_t)_muxAddress << 8) | _muxChannel; }
+
+  /*******************************************************************************/
+  /*!
+      @brief    Gets the device's address as sent by the broker, including
+                the multiplexer address and channel for devices behind a
+                multiplexer.
+      @returns  (mux channel << 16) | (mux address << 8) | device address.
+  */
+  /*******************************************************************************/
+  uint32_t getEncodedI2CAddress() {
+    if (_muxAddress == 0)
+      return _sensorAddress;
+    return ((uint32_t)_muxChannel << 16) | ((uint32_t)_muxAddress << 8) |
+           _sensorAddress;
+  }
+
+  /*******************************************************************************/
+  /*!
+      @brief    Base implementation - Gets the maximum SCL frequency
+                supported by the device.
+      @returns  Maximum SCL frequency, in Hz.
+  */
+  /*******************************************************************************/
+  virtual uint32_t getMaxBusFrequency() { return I2C_FREQ_STANDARD_MODE; }
+
+  /*******************************************************************************/
+  /*!
+      @brief    Base implementation - Checks if the device holds SCL low
+                (clock stretching) for longer than a typical I2C timeout.
+      @returns  True if the device requires long clock stretching, False
+                otherwise.
+  */
+  /*******************************************************************************/
+  virtual bool needsClockStretching() { return false; }
+
+  /*******************************************************************************/
+  /*!
+      @brief    Records the outcome of polling the device's sensors.
+      @param    success
+                True if every sensor read succeeded, False otherwise.
+      @param    latencyUs
+                Time taken to poll the device, in microseconds.
+  */
+  /*******************************************************************************/
+  void recordPoll(bool success, uint32_t latencyUs) {
+    _pollCount++;
+    _pollLatencyTotalUs += latencyUs;
+    if (latencyUs > _pollLatencyMaxUs)
+      _pollLatencyMaxUs = latencyUs;
+    if (success) {
+      _consecutiveFailures = 0;
+      _backoffUntil = 0;
+    } else {
+      _errorCount++;
+      if (_consecutiveFailures < 0xFF)
+        _consecutiveFailures++;
+    }
+  }
+
+  /*******************************************************************************/
+  /*!
+      @brief    Gets the number of consecutive failed polls.
+      @returns  Consecutive failed polls since the last successful poll.
+  */
+  /*******************************************************************************/
+  uint8_t getConsecutiveFailures() { return _consecutiveFailures; }
+
+  /*******************************************************************************/
+  /*!
+      @brief    Gets the total number of failed polls.
+      @returns  Number of failed polls.
+  */
+  /*******************************************************************************/
+  uint32_t getErrorCount() { return _errorCount; }
+
+  /*******************************************************************************/
+  /*!
+      @brief    Gets the total number of polls.
+      @returns  Number of polls.
+  */
+  /*******************************************************************************/
+  uint32_t getPollCount() { return _pollCount; }
+
+  /*******************************************************************************/
+  /*!
+      @brief    Gets the average time taken to poll the device.
+      @returns  Average poll latency, in microseconds.
+  */
+  /*******************************************************************************/
+  uint32_t getPollLatencyAvg() {
+    return _pollCount == 0 ? 0 : (uint32_t)(_pollLatencyTotalUs / _pollCount);
+  }
+
+  /*******************************************************************************/
+  /*!
+      @brief    Gets the longest time taken to poll the device.
+      @returns  Maximum poll latency, in microseconds.
+  */
+  /*******************************************************************************/
+  uint32_t getPollLatencyMax() { return _pollLatencyMaxUs; }
+
+  /*******************************************************************************/
+  /*!
+      @brief    Holds off polling the device until a point in time.
+      @param    until
+                Time, from millis(), at which polling may resume.
+  */
+  /*******************************************************************************/
+  void setBackoff(unsigned long until) { _backoffUntil = until; }
+
+  /*******************************************************************************/
+  /*!
+      @brief    Checks if the device is being held off after failures.
+      @param    curTime
+                Current time, from millis().
+      @returns  True if the device should not be polled, False otherwise.
+  */
+  /*******************************************************************************/
+  bool isBackedOff(unsigned long curTime) {
+    return _backoffUntil != 0 && (long)(curTime - _backoffUntil) < 0;
+  }
+
   /****************************** SENSOR_TYPE: CO2
    * *******************************/
   /*********************************************************************************/
@@ -1207,6 +1445,14 @@ public:
 protected:
   TwoWire *_i2c;           ///< Pointer to the I2C driver's Wire object
   uint16_t _sensorAddress; ///< The I2C driver's unique I2C address.
+  uint8_t _muxAddress = 0; ///< Address of the TCA9548A the device is behind
+  uint8_t _muxChannel = 0; ///< TCA9548A channel the device is connected to
+  uint8_t _consecutiveFailures = 0; ///< Failed polls since the last success
+  uint32_t _errorCount = 0;         ///< Total number of failed polls
+  uint32_t _pollCount = 0;          ///< Total number of polls
+  uint64_t _pollLatencyTotalUs = 0; ///< Sum of all poll latencies, in us
+  uint32_t _pollLatencyMaxUs = 0;   ///< Longest poll latency, in us
+  unsigned long _backoffUntil = 0;  ///< Time at which polling may resume
   long _tempSensorPeriod =
       0L; ///< The time period between reading the temperature sensor's value.
   long _tempSensorPeriodPrv =
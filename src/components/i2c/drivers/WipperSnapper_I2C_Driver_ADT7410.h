@@ -50,6 +50,14 @@ public:
     delete _ADT7410;
   }
 
+  /*******************************************************************************/
+  /*!
+      @brief    Gets the maximum SCL frequency supported by the ADT7410.
+      @returns  Maximum SCL frequency, in Hz.
+  */
+  /*******************************************************************************/
+  uint32_t getMaxBusFrequency() { return I2C_FREQ_FAST_MODE; }
+
   /*******************************************************************************/
   /*!
       @brief    Initializes the ADT7410 sensor and begins I2C.
@@ -76,7 +84,8 @@ public:
   }
 
 protected:
-  Adafruit_ADT7410 *_ADT7410; ///< Pointer to ADT7410 temperature sensor object
+  Adafruit_ADT7410 *_ADT7410 =
+      nullptr; ///< Pointer to ADT7410 temperature sensor object
 };
 
 #endif // WipperSnapper_I2C_Driver_ADT7410
\ No newline at end of file
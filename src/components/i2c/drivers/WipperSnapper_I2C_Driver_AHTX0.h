@@ -50,6 +50,14 @@ public:
   /*******************************************************************************/
   ~WipperSnapper_I2C_Driver_AHTX0() { delete _aht; }
 
+  /*******************************************************************************/
+  /*!
+      @brief    Gets the maximum SCL frequency supported by the AHTX0.
+      @returns  Maximum SCL frequency, in Hz.
+  */
+  /*******************************************************************************/
+  uint32_t getMaxBusFrequency() { return I2C_FREQ_FAST_MODE; }
+
   /*******************************************************************************/
   /*!
       @brief    Initializes the AHTX0 sensor and begins I2C.
@@ -107,7 +115,7 @@ public:
   }
 
 protected:
-  Adafruit_AHTX0 *_aht; ///< Pointer to an AHTX0 object
+  Adafruit_AHTX0 *_aht = nullptr; ///< Pointer to an AHTX0 object
   Adafruit_Sensor *_aht_temp =
       NULL; ///< Holds data for the AHTX0's temperature sensor
   Adafruit_Sensor *_aht_humidity =
@@ -44,6 +44,14 @@ public:
     delete _bh1750;
   }
 
+  /*******************************************************************************/
+  /*!
+      @brief    Gets the maximum SCL frequency supported by the BH1750.
+      @returns  Maximum SCL frequency, in Hz.
+  */
+  /*******************************************************************************/
+  uint32_t getMaxBusFrequency() { return I2C_FREQ_FAST_MODE; }
+
   /*******************************************************************************/
   /*!
       @brief  Initializes the BH1750 sensor and begins I2C.
@@ -79,7 +87,7 @@ public:
   }
 
 protected:
-  hp_BH1750 *_bh1750; ///< Pointer to BH1750 light sensor object
+  hp_BH1750 *_bh1750 = nullptr; ///< Pointer to BH1750 light sensor object
 };
 
 #endif // WipperSnapper_I2C_Driver_BH1750
\ No newline at end of file
@@ -52,6 +52,14 @@ public:
   /*******************************************************************************/
   ~WipperSnapper_I2C_Driver_BME280() { delete _bme; }
 
+  /*******************************************************************************/
+  /*!
+      @brief    Gets the maximum SCL frequency supported by the BME280.
+      @returns  Maximum SCL frequency, in Hz.
+  */
+  /*******************************************************************************/
+  uint32_t getMaxBusFrequency() { return I2C_FREQ_FAST_MODE; }
+
   /*******************************************************************************/
   /*!
       @brief    Initializes the BME280 sensor and begins I2C.
@@ -136,7 +144,7 @@ public:
   }
 
 protected:
-  Adafruit_BME280 *_bme; ///< BME280  object
+  Adafruit_BME280 *_bme = nullptr; ///< BME280  object
   Adafruit_Sensor *_bme_temp =
       NULL; ///< Ptr to an adafruit_sensor representing the temperature
   Adafruit_Sensor *_bme_pressure =
@@ -52,6 +52,14 @@ public:
   /*******************************************************************************/
   ~WipperSnapper_I2C_Driver_BME680() { delete _bme; }
 
+  /*******************************************************************************/
+  /*!
+      @brief    Gets the maximum SCL frequency supported by the BME680.
+      @returns  Maximum SCL frequency, in Hz.
+  */
+  /*******************************************************************************/
+  uint32_t getMaxBusFrequency() { return I2C_FREQ_FAST_MODE; }
+
   /*******************************************************************************/
   /*!
       @brief    Initializes the BME680 sensor and begins I2C.
@@ -171,7 +179,7 @@ public:
   }
 
 protected:
-  Adafruit_BME680 *_bme; ///< BME680 object
+  Adafruit_BME680 *_bme = nullptr; ///< BME680 object
 };
 
 #endif // WipperSnapper_I2C_Driver_BME680
\ No newline at end of file
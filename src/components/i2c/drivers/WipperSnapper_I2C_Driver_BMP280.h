@@ -52,6 +52,14 @@ public:
   /*******************************************************************************/
   ~WipperSnapper_I2C_Driver_BMP280() { delete _bmp; }
 
+  /*******************************************************************************/
+  /*!
+      @brief    Gets the maximum SCL frequency supported by the BMP280.
+      @returns  Maximum SCL frequency, in Hz.
+  */
+  /*******************************************************************************/
+  uint32_t getMaxBusFrequency() { return I2C_FREQ_FAST_MODE; }
+
   /*******************************************************************************/
   /*!
       @brief    Initializes the BMP280 sensor and begins I2C.
@@ -127,7 +135,7 @@ public:
   }
 
 protected:
-  Adafruit_BMP280 *_bmp; ///< BMP280  object
+  Adafruit_BMP280 *_bmp = nullptr; ///< BMP280  object
   Adafruit_Sensor *_bmp_temp =
       NULL; ///< Ptr to an adafruit_sensor representing the temperature
   Adafruit_Sensor *_bmp_pressure =
@@ -50,6 +50,14 @@ public:
   /*******************************************************************************/
   ~WipperSnapper_I2C_Driver_DPS310() { delete _dps310; }
 
+  /*******************************************************************************/
+  /*!
+      @brief    Gets the maximum SCL frequency supported by the DPS310.
+      @returns  Maximum SCL frequency, in Hz.
+  */
+  /*******************************************************************************/
+  uint32_t getMaxBusFrequency() { return I2C_FREQ_FAST_MODE; }
+
   /*******************************************************************************/
   /*!
       @brief    Initializes the DPS310 sensor and begins I2C.
@@ -109,7 +117,7 @@ public:
   }
 
 protected:
-  Adafruit_DPS310 *_dps310; ///< DPS310 driver object
+  Adafruit_DPS310 *_dps310 = nullptr; ///< DPS310 driver object
   Adafruit_Sensor *_dps_temp =
       NULL; ///< Holds data for the DPS310's temperature sensor
   Adafruit_Sensor *_dps_pressure =
@@ -41,6 +41,14 @@ public:
   /*******************************************************************************/
   ~WipperSnapper_I2C_Driver_HTS221() { delete _hts221; }
 
+  /*******************************************************************************/
+  /*!
+      @brief    Gets the maximum SCL frequency supported by the HTS221.
+      @returns  Maximum SCL frequency, in Hz.
+  */
+  /*******************************************************************************/
+  uint32_t getMaxBusFrequency() { return I2C_FREQ_FAST_MODE; }
+
   /*******************************************************************************/
   /*!
       @brief    Initializes the HTS221 sensor and begins I2C.
@@ -99,7 +107,7 @@ public:
   }
 
 protected:
-  Adafruit_HTS221 *_hts221; ///< Pointer to an HTS221 object
+  Adafruit_HTS221 *_hts221 = nullptr; ///< Pointer to an HTS221 object
   Adafruit_Sensor *_hts221_temp =
       NULL; ///< Holds data for the HTS221's temperature sensor
   Adafruit_Sensor *_hts221_humidity =
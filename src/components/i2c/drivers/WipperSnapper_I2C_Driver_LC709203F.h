@@ -99,7 +99,7 @@ public:
   }
 
 protected:
-  Adafruit_LC709203F *_lc; ///< Pointer to LC709203F sensor object
+  Adafruit_LC709203F *_lc = nullptr; ///< Pointer to LC709203F sensor object
 };
 
 #endif // WipperSnapper_I2C_Driver_LC709203F
\ No newline at end of file
@@ -48,6 +48,14 @@ public:
   /*******************************************************************************/
   ~WipperSnapper_I2C_Driver_MAX17048() { delete _maxlipo; }
 
+  /*******************************************************************************/
+  /*!
+      @brief    Gets the maximum SCL frequency supported by the MAX17048.
+      @returns  Maximum SCL frequency, in Hz.
+  */
+  /*******************************************************************************/
+  uint32_t getMaxBusFrequency() { return I2C_FREQ_FAST_MODE; }
+
   /*******************************************************************************/
   /*!
       @brief    Initializes the MAX17048 sensor and begins I2C.
@@ -92,7 +100,7 @@ public:
   }
 
 protected:
-  Adafruit_MAX17048 *_maxlipo; ///< Pointer to MAX17048 sensor object
+  Adafruit_MAX17048 *_maxlipo = nullptr; ///< Pointer to MAX17048 sensor object
 };
 
 #endif // WipperSnapper_I2C_Driver_MAX17048
\ No newline at end of file
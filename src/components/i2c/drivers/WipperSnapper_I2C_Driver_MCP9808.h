@@ -50,6 +50,14 @@ public:
     delete _mcp9808;
   }
 
+  /*******************************************************************************/
+  /*!
+      @brief    Gets the maximum SCL frequency supported by the MCP9808.
+      @returns  Maximum SCL frequency, in Hz.
+  */
+  /*******************************************************************************/
+  uint32_t getMaxBusFrequency() { return I2C_FREQ_FAST_MODE; }
+
   /*******************************************************************************/
   /*!
       @brief    Initializes the MCP9808 sensor and begins I2C.
@@ -76,7 +84,8 @@ public:
   }
 
 protected:
-  Adafruit_MCP9808 *_mcp9808; ///< Pointer to MCP9808 temperature sensor object
+  Adafruit_MCP9808 *_mcp9808 =
+      nullptr; ///< Pointer to MCP9808 temperature sensor object
 };
 
 #endif // WipperSnapper_I2C_Driver_MCP9808
\ No newline at end of file
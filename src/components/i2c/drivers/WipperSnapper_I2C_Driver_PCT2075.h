@@ -50,6 +50,14 @@ public:
     delete _pct2075;
   }
 
+  /*******************************************************************************/
+  /*!
+      @brief    Gets the maximum SCL frequency supported by the PCT2075.
+      @returns  Maximum SCL frequency, in Hz.
+  */
+  /*******************************************************************************/
+  uint32_t getMaxBusFrequency() { return I2C_FREQ_FAST_MODE; }
+
   /*******************************************************************************/
   /*!
       @brief    Initializes the PCT2075 sensor and begins I2C.
@@ -76,7 +84,8 @@ public:
   }
 
 protected:
-  Adafruit_PCT2075 *_pct2075; ///< Pointer to PCT2075 temperature sensor object
+  Adafruit_PCT2075 *_pct2075 =
+      nullptr; ///< Pointer to PCT2075 temperature sensor object
 };
 
 #endif // WipperSnapper_I2C_Driver_PCT2075
\ No newline at end of file
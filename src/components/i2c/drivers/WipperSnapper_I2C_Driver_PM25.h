@@ -43,6 +43,13 @@ public:
     _sensorAddress = sensorAddress;
   }
 
+  /*******************************************************************************/
+  /*!
+      @brief    Destructor for an PM25 sensor.
+  */
+  /*******************************************************************************/
+  ~WipperSnapper_I2C_Driver_PM25() { delete _pm25; }
+
   /*******************************************************************************/
   /*!
       @brief    Initializes the PM25 sensor and begins I2C.
@@ -116,7 +123,7 @@ public:
   }
 
 protected:
-  Adafruit_PM25AQI *_pm25; ///< PM25 driver object
+  Adafruit_PM25AQI *_pm25 = nullptr; ///< PM25 driver object
 };
 
 #endif // WipperSnapper_I2C_Driver_PM25
\ No newline at end of file
@@ -42,6 +42,22 @@ public:
     _sensorAddress = sensorAddress;
   }
 
+  /*******************************************************************************/
+  /*!
+      @brief    Destructor for an SCD30 sensor.
+  */
+  /*******************************************************************************/
+  ~WipperSnapper_I2C_Driver_SCD30() { delete _scd; }
+
+  /*******************************************************************************/
+  /*!
+      @brief    Checks if the SCD30 stretches SCL. The SCD30 may hold SCL low
+                for up to 150ms while it prepares a response.
+      @returns  True.
+  */
+  /*******************************************************************************/
+  bool needsClockStretching() { return true; }
+
   /*******************************************************************************/
   /*!
       @brief    Initializes the SCD30 sensor and begins I2C.
@@ -116,7 +132,7 @@ public:
   }
 
 protected:
-  Adafruit_SCD30 *_scd; ///< SCD30 driver object
+  Adafruit_SCD30 *_scd = nullptr; ///< SCD30 driver object
 };
 
 #endif // WipperSnapper_I2C_Driver_SCD30
\ No newline at end of file
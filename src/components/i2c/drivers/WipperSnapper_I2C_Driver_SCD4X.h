@@ -44,6 +44,21 @@ public:
     _sensorAddress = sensorAddress;
   }
 
+  /*******************************************************************************/
+  /*!
+      @brief    Destructor for an SCD4X sensor.
+  */
+  /*******************************************************************************/
+  ~WipperSnapper_I2C_Driver_SCD4X() { delete _scd; }
+
+  /*******************************************************************************/
+  /*!
+      @brief    Gets the maximum SCL frequency supported by the SCD4X.
+      @returns  Maximum SCL frequency, in Hz.
+  */
+  /*******************************************************************************/
+  uint32_t getMaxBusFrequency() { return I2C_FREQ_FAST_MODE; }
+
   /*******************************************************************************/
   /*!
       @brief    Initializes the SCD40 sensor and begins I2C.
@@ -145,7 +160,7 @@ public:
   }
 
 protected:
-  SensirionI2CScd4x *_scd; ///< SCD4x driver object
+  SensirionI2CScd4x *_scd = nullptr; ///< SCD4x driver object
   uint16_t _co2;           ///< SCD4x co2 reading
   float _temperature;      ///< SCD4x temperature reading
   float _humidity;         ///< SCD4x humidity reading
@@ -46,6 +46,13 @@ public:
     _sensorAddress = sensorAddress;
   }
 
+  /*******************************************************************************/
+  /*!
+      @brief    Destructor for an SEN5X sensor.
+  */
+  /*******************************************************************************/
+  ~WipperSnapper_I2C_Driver_SEN5X() { delete _sen; }
+
   /*******************************************************************************/
   /*!
       @brief    Initializes the SEN5X sensor and begins I2C.
@@ -297,7 +304,7 @@ public:
   }
 
 protected:
-  SensirionI2CSen5x *_sen; ///< SEN5X driver object
+  SensirionI2CSen5x *_sen = nullptr; ///< SEN5X driver object
 };
 
 #endif // WipperSnapper_I2C_Driver_SEN5X
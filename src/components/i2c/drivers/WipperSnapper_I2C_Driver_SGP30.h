@@ -36,6 +36,14 @@ public:
     delete _sgp30;
   }
 
+  /*******************************************************************************/
+  /*!
+      @brief    Gets the maximum SCL frequency supported by the SGP30.
+      @returns  Maximum SCL frequency, in Hz.
+  */
+  /*******************************************************************************/
+  uint32_t getMaxBusFrequency() { return I2C_FREQ_FAST_MODE; }
+
   /*******************************************************************************/
   /*!
       @brief    Initializes the SGP30 sensor and begins I2C.
@@ -68,7 +76,8 @@ public:
   }
 
 protected:
-  Adafruit_SGP30 *_sgp30; ///< Pointer to SGP30 temperature sensor object
+  Adafruit_SGP30 *_sgp30 =
+      nullptr; ///< Pointer to SGP30 temperature sensor object
 };
 
 #endif // WipperSnapper_I2C_Driver_SGP30
\ No newline at end of file
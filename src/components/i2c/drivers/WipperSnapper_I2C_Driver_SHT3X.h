@@ -45,6 +45,21 @@ public:
     _sensorAddress = sensorAddress;
   }
 
+  /*******************************************************************************/
+  /*!
+      @brief    Destructor for an SHT3X sensor.
+  */
+  /*******************************************************************************/
+  ~WipperSnapper_I2C_Driver_SHT3X() { delete _sht3x; }
+
+  /*******************************************************************************/
+  /*!
+      @brief    Gets the maximum SCL frequency supported by the SHT3X.
+      @returns  Maximum SCL frequency, in Hz.
+  */
+  /*******************************************************************************/
+  uint32_t getMaxBusFrequency() { return I2C_FREQ_FAST_MODE; }
+
   /*******************************************************************************/
   /*!
       @brief    Initializes the SHT3X sensor and begins I2C.
@@ -99,7 +114,7 @@ public:
   }
 
 protected:
-  SHTSensor *_sht3x; ///< SHT3X object
+  SHTSensor *_sht3x = nullptr; ///< SHT3X object
 };
 
 #endif // WipperSnapper_I2C_Driver_SHT3X
\ No newline at end of file
@@ -45,6 +45,21 @@ public:
     _sensorAddress = sensorAddress;
   }
 
+  /*******************************************************************************/
+  /*!
+      @brief    Destructor for an SHT4X sensor.
+  */
+  /*******************************************************************************/
+  ~WipperSnapper_I2C_Driver_SHT4X() { delete _sht4x; }
+
+  /*******************************************************************************/
+  /*!
+      @brief    Gets the maximum SCL frequency supported by the SHT4X.
+      @returns  Maximum SCL frequency, in Hz.
+  */
+  /*******************************************************************************/
+  uint32_t getMaxBusFrequency() { return I2C_FREQ_FAST_MODE; }
+
   /*******************************************************************************/
   /*!
       @brief    Initializes the SHT4X sensor and begins I2C.
@@ -97,7 +112,7 @@ public:
   }
 
 protected:
-  SHTSensor *_sht4x; ///< SHT4X object
+  SHTSensor *_sht4x = nullptr; ///< SHT4X object
 };
 
 #endif // WipperSnapper_I2C_Driver_SHT4X
\ No newline at end of file
@@ -45,6 +45,21 @@ public:
     _sensorAddress = sensorAddress;
   }
 
+  /*******************************************************************************/
+  /*!
+      @brief    Destructor for an SHTC3 sensor.
+  */
+  /*******************************************************************************/
+  ~WipperSnapper_I2C_Driver_SHTC3() { delete _shtc3; }
+
+  /*******************************************************************************/
+  /*!
+      @brief    Gets the maximum SCL frequency supported by the SHTC3.
+      @returns  Maximum SCL frequency, in Hz.
+  */
+  /*******************************************************************************/
+  uint32_t getMaxBusFrequency() { return I2C_FREQ_FAST_MODE; }
+
   /*******************************************************************************/
   /*!
       @brief    Initializes the SHTC3 sensor and begins I2C.
@@ -91,7 +106,7 @@ public:
   }
 
 protected:
-  SHTSensor *_shtc3; ///< SHTC3 object
+  SHTSensor *_shtc3 = nullptr; ///< SHTC3 object
 };
 
 #endif // WipperSnapper_I2C_Driver_SHTC3
\ No newline at end of file
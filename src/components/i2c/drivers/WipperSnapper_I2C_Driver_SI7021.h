@@ -54,6 +54,14 @@ public:
     delete _si7021;
   }
 
+  /*******************************************************************************/
+  /*!
+      @brief    Gets the maximum SCL frequency supported by the SI7021.
+      @returns  Maximum SCL frequency, in Hz.
+  */
+  /*******************************************************************************/
+  uint32_t getMaxBusFrequency() { return I2C_FREQ_FAST_MODE; }
+
   /*******************************************************************************/
   /*!
       @brief    Initializes the SI7021 sensor and begins I2C.
@@ -96,7 +104,7 @@ public:
   }
 
 protected:
-  Adafruit_Si7021 *_si7021; ///< SI7021 driver object
+  Adafruit_Si7021 *_si7021 = nullptr; ///< SI7021 driver object
 };
 
 #endif // WipperSnapper_I2C_Driver_SI7021
\ No newline at end of file
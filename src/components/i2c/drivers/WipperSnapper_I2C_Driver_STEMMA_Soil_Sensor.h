@@ -99,7 +99,7 @@ public:
   }
 
 protected:
-  Adafruit_seesaw *_seesaw; ///< Seesaw object
+  Adafruit_seesaw *_seesaw = nullptr; ///< Seesaw object
 };
 
 #endif // WipperSnapper_I2C_Driver_STEMMA_Soil_Sensor_H
\ No newline at end of file
@@ -50,6 +50,14 @@ public:
     delete _tmp117;
   }
 
+  /*******************************************************************************/
+  /*!
+      @brief    Gets the maximum SCL frequency supported by the TMP117.
+      @returns  Maximum SCL frequency, in Hz.
+  */
+  /*******************************************************************************/
+  uint32_t getMaxBusFrequency() { return I2C_FREQ_FAST_MODE; }
+
   /*******************************************************************************/
   /*!
       @brief    Initializes the TMP117 sensor and begins I2C.
@@ -75,7 +83,8 @@ public:
   }
 
 protected:
-  Adafruit_TMP117 *_tmp117; ///< Pointer to TMP117 temperature sensor object
+  Adafruit_TMP117 *_tmp117 =
+      nullptr; ///< Pointer to TMP117 temperature sensor object
 };
 
 #endif // WipperSnapper_I2C_Driver_TMP117
\ No newline at end of file
@@ -47,6 +47,14 @@ public:
   /*******************************************************************************/
   ~WipperSnapper_I2C_Driver_TSL2591() { delete _tsl; }
 
+  /*******************************************************************************/
+  /*!
+      @brief    Gets the maximum SCL frequency supported by the TSL2591.
+      @returns  Maximum SCL frequency, in Hz.
+  */
+  /*******************************************************************************/
+  uint32_t getMaxBusFrequency() { return I2C_FREQ_FAST_MODE; }
+
   /*******************************************************************************/
   /*!
       @brief    Initializes the TSL2591 sensor and begins I2C.
@@ -92,7 +100,7 @@ public:
   }
 
 protected:
-  Adafruit_TSL2591 *_tsl; ///< Pointer to TSL2591 light sensor object
+  Adafruit_TSL2591 *_tsl = nullptr; ///< Pointer to TSL2591 light sensor object
 };
 
 #endif // WipperSnapper_I2C_Driver_TSL2591
\ No newline at end of file
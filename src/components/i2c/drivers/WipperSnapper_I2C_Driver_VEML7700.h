@@ -47,6 +47,14 @@ public:
   /*******************************************************************************/
   ~WipperSnapper_I2C_Driver_VEML7700() { delete _veml; }
 
+  /*******************************************************************************/
+  /*!
+      @brief    Gets the maximum SCL frequency supported by the VEML7700.
+      @returns  Maximum SCL frequency, in Hz.
+  */
+  /*******************************************************************************/
+  uint32_t getMaxBusFrequency() { return I2C_FREQ_FAST_MODE; }
+
   /*******************************************************************************/
   /*!
       @brief    Initializes the VEML7700 sensor and begins I2C.
@@ -78,7 +86,8 @@ public:
   }
 
 protected:
-  Adafruit_VEML7700 *_veml; ///< Pointer to VEML7700 light sensor object
+  Adafruit_VEML7700 *_veml =
+      nullptr; ///< Pointer to VEML7700 light sensor object
 };
 
 #endif // WipperSnapper_I2C_Driver_VEML7700
\ No newline at end of file
@@ -51,6 +51,14 @@ public:
     delete _vl53l0x;
   }
 
+  /*******************************************************************************/
+  /*!
+      @brief    Gets the maximum SCL frequency supported by the VL53L0X.
+      @returns  Maximum SCL frequency, in Hz.
+  */
+  /*******************************************************************************/
+  uint32_t getMaxBusFrequency() { return I2C_FREQ_FAST_MODE; }
+
   /*******************************************************************************/
   /*!
       @brief    Initializes the VL53L0X sensor and begins I2C.
@@ -84,7 +92,8 @@ public:
   }
 
 protected:
-  Adafruit_VL53L0X *_vl53l0x; ///< Pointer to VL53L0X temperature sensor object
+  Adafruit_VL53L0X *_vl53l0x =
+      nullptr; ///< Pointer to VL53L0X temperature sensor object
 };
 
 #endif // WipperSnapper_I2C_Driver_VL53L0X
\ No newline at end of file
@@ -0,0 +1,154 @@
+/*!
+ * @file ws_mqtt_budget.cpp
+ *
+ * Token bucket which holds the device's publishes to the Adafruit IO
+ * account's data rate.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * Copyright (c) Brent Rubell 2023 for Adafruit Industries.
+ *
+ * MIT license, all text here must be included in any redistribution.
+ *
+ */
+#include "ws_mqtt_budget.h"
+
+/**************************************************************************/
+/*!
+    @brief    Creates a publish governor with a full bucket.
+*/
+/**************************************************************************/
+ws_mqtt_budget::ws_mqtt_budget() {
+  _milliTokens = WS_PUBLISH_BUDGET_BURST * 1000UL;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Destructor for the publish governor.
+*/
+/**************************************************************************/
+ws_mqtt_budget::~ws_mqtt_budget() {}
+
+/**************************************************************************/
+/*!
+    @brief    Sets the account's data rate budget.
+    @param    perMinute
+              Publishes allowed per minute.
+*/
+/**************************************************************************/
+void ws_mqtt_budget::setBudget(uint16_t perMinute) {
+  refill();
+  _refillPerMin =
+      perMinute > WS_PUBLISH_BUDGET_BURST ? perMinute - WS_PUBLISH_BUDGET_BURST
+                                          : 1;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Adds the tokens earned since the last refill.
+*/
+/**************************************************************************/
+void ws_mqtt_budget::refill() {
+  unsigned long curTime = millis();
+  // refill at most a minute at a time, keeps this from overflowing
+  if (curTime - _prvRefill > 60000UL)
+    _prvRefill = curTime - 60000UL;
+  uint32_t elapsed = curTime - _prvRefill;
+  // milli-tokens per ms is the refill rate per minute / 60
+  uint32_t earned = elapsed * _refillPerMin / 60;
+  _milliTokens += earned;
+  if (_milliTokens > WS_PUBLISH_BUDGET_BURST * 1000UL)
+    _milliTokens = WS_PUBLISH_BUDGET_BURST * 1000UL;
+  // only advance by the time turned into milli-tokens, the remainder
+  // carries over so frequent refills still add up
+  _prvRefill += earned * 60 / _refillPerMin;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Checks if a publish would be allowed, without spending a
+              token. Used to defer a periodic reading before it is taken.
+    @param    priority
+              Priority of the publish.
+    @returns  True if the publish would be allowed, False otherwise.
+*/
+/**************************************************************************/
+bool ws_mqtt_budget::isAvailable(ws_publish_priority_t priority) {
+  refill();
+  uint32_t required = 1000UL;
+  if (priority == WS_PUBLISH_PRIORITY_LOW)
+    required += WS_PUBLISH_BUDGET_RESERVE * 1000UL;
+  if (_milliTokens >= required)
+    return true;
+
+  if (priority == WS_PUBLISH_PRIORITY_LOW && !_isDeferring) {
+    WS_LOG_WARN(MQTT, "Publish budget low, deferring periodic readings");
+    _isDeferring = true;
+    _deferred++;
+  }
+  return false;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Spends a token on a publish. High-priority publishes are
+              never refused, the broker expects command responses, but
+              still empty the bucket.
+    @param    priority
+              Priority of the publish.
+    @returns  True if the publish is allowed, False otherwise.
+*/
+/**************************************************************************/
+bool ws_mqtt_budget::consume(ws_publish_priority_t priority) {
+  if (priority == WS_PUBLISH_PRIORITY_LOW) {
+    if (!isAvailable(priority)) {
+      _dropped++;
+      return false;
+    }
+    _isDeferring = false;
+  } else {
+    refill();
+  }
+  _milliTokens = _milliTokens >= 1000UL ? _milliTokens - 1000UL : 0;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Empties the bucket, the broker has throttled the device.
+*/
+/**************************************************************************/
+void ws_mqtt_budget::drain() {
+  refill();
+  _milliTokens = 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Returns the number of whole tokens in the bucket.
+    @returns  Tokens available.
+*/
+/**************************************************************************/
+uint16_t ws_mqtt_budget::getTokens() {
+  refill();
+  return _milliTokens / 1000;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Returns how many times low-priority publishes were held back.
+    @returns  Number of deferrals.
+*/
+/**************************************************************************/
+uint32_t ws_mqtt_budget::getDeferred() { return _deferred; }
+
+/**************************************************************************/
+/*!
+    @brief    Returns the number of low-priority publishes refused
+              because the budget ran low.
+    @returns  Number of dropped publishes.
+*/
+/**************************************************************************/
+uint32_t ws_mqtt_budget::getDropped() { return _dropped; }
@@ -0,0 +1,71 @@
+/*!
+ * @file ws_mqtt_budget.h
+ *
+ * Token bucket which holds the device's publishes to the Adafruit IO
+ * account's data rate.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * Copyright (c) Brent Rubell 2023 for Adafruit Industries.
+ *
+ * MIT license, all text here must be included in any redistribution.
+ *
+ */
+#ifndef WS_MQTT_BUDGET_H
+#define WS_MQTT_BUDGET_H
+
+#include "Wippersnapper.h"
+
+#ifndef WS_PUBLISH_BUDGET_PER_MIN
+#define WS_PUBLISH_BUDGET_PER_MIN                                              \
+  30 ///< Default data rate budget, Adafruit IO's free tier, per minute
+#endif
+#define WS_PUBLISH_BUDGET_BURST                                                \
+  5 ///< Publishes which may be sent back-to-back with a full bucket
+#define WS_PUBLISH_BUDGET_RESERVE                                              \
+  2 ///< Tokens held back from low-priority publishes
+
+class Wippersnapper;
+
+/**************************************************************************/
+/*!
+    @brief  Token bucket publish governor.
+
+            The bucket holds WS_PUBLISH_BUDGET_BURST tokens and refills at
+            the budget minus the burst, so a full burst plus a minute of
+            refill never exceeds the budget within a minute. Low-priority
+            publishes are held back while the bucket is down to its last
+            WS_PUBLISH_BUDGET_RESERVE tokens, leaving them to on-change
+            events and command responses, which are never refused.
+*/
+/**************************************************************************/
+class ws_mqtt_budget {
+public:
+  ws_mqtt_budget();
+  ~ws_mqtt_budget();
+
+  void setBudget(uint16_t perMinute);
+  bool isAvailable(ws_publish_priority_t priority);
+  bool consume(ws_publish_priority_t priority);
+  void drain();
+
+  uint16_t getTokens();
+  uint32_t getDeferred();
+  uint32_t getDropped();
+
+private:
+  void refill();
+
+  uint32_t _milliTokens; ///< Tokens in the bucket, in 1/1000ths of a token
+  uint16_t _refillPerMin = WS_PUBLISH_BUDGET_PER_MIN -
+                           WS_PUBLISH_BUDGET_BURST; ///< Refill rate, per min.
+  unsigned long _prvRefill = 0; ///< When the bucket was last refilled, in ms
+  bool _isDeferring = false;    ///< True while low-priority publishes are held
+  uint32_t _deferred = 0;       ///< Times low-priority publishes were held
+  uint32_t _dropped = 0;        ///< Low-priority publishes refused
+};
+extern Wippersnapper WS;
+
+#endif // WS_MQTT_BUDGET_H
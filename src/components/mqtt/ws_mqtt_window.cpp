@@ -0,0 +1,307 @@
+/*!
+ * @file ws_mqtt_window.cpp
+ *
+ * Keeps several QoS 1 MQTT publishes in flight at once.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * Copyright (c) Brent Rubell 2023 for Adafruit Industries.
+ *
+ * MIT license, all text here must be included in any redistribution.
+ *
+ */
+#include "ws_mqtt_window.h"
+
+/**************************************************************************/
+/*!
+    @brief    Creates a new publish window.
+*/
+/**************************************************************************/
+ws_mqtt_window::ws_mqtt_window() {}
+
+/**************************************************************************/
+/*!
+    @brief    Frees the publishes still awaiting a PUBACK or a free slot.
+*/
+/**************************************************************************/
+ws_mqtt_window::~ws_mqtt_window() {
+  for (int i = 0; i < WS_MQTT_MAX_INFLIGHT; i++)
+    free(_inFlight[i].packet);
+  for (int i = 0; i < WS_MQTT_MAX_QUEUED; i++)
+    free(_queue[i].packet);
+}
+
+/**************************************************************************/
+/*!
+    @brief    Encodes and sends a QoS 1 PUBLISH packet without waiting for
+              the broker's PUBACK. If every slot of the window is awaiting
+              a PUBACK, the packet is queued for sendQueued() instead.
+    @param    client
+              The MQTT client's socket.
+    @param    topic
+              The MQTT topic to publish to.
+    @param    payload
+              The payload to publish.
+    @param    len
+              The length of the payload.
+    @returns  True if the packet was sent or queued, False if the queue is
+              full or the packet could not be sent.
+*/
+/**************************************************************************/
+bool ws_mqtt_window::publish(Client *client, const char *topic,
+                             uint8_t *payload, uint16_t len) {
+  if (client == nullptr)
+    return false;
+
+  // queued publishes go out first, keeping messages in order
+  sendQueued(client);
+  ws_mqtt_inflight_t *slot = freeSlot();
+  if (slot == nullptr && _queueCount == WS_MQTT_MAX_QUEUED) {
+    _dropped++;
+    WS_LOG_WARN(MQTT, "Publish queue is full, %u messages dropped!",
+                (unsigned int)_dropped);
+    return false;
+  }
+
+  uint16_t packetLen, packetId;
+  uint8_t *packet = encode(topic, payload, len, &packetLen, &packetId);
+  if (packet == nullptr)
+    return false;
+  if (slot != nullptr)
+    return send(client, slot, packet, packetLen, packetId);
+
+  // every publish is awaiting a PUBACK, wait for a slot
+  ws_mqtt_inflight_t *queued =
+      &_queue[(_queueHead + _queueCount) % WS_MQTT_MAX_QUEUED];
+  queued->packet = packet;
+  queued->packetLen = packetLen;
+  queued->packetId = packetId;
+  _queueCount++;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Sends queued publishes, oldest first, while the window has
+              free slots.
+    @param    client
+              The MQTT client's socket.
+*/
+/**************************************************************************/
+void ws_mqtt_window::sendQueued(Client *client) {
+  if (client == nullptr || !client->connected())
+    return;
+
+  while (_queueCount > 0) {
+    ws_mqtt_inflight_t *slot = freeSlot();
+    if (slot == nullptr)
+      return;
+    ws_mqtt_inflight_t *queued = &_queue[_queueHead];
+    uint8_t *packet = queued->packet;
+    queued->packet = nullptr;
+    _queueHead = (_queueHead + 1) % WS_MQTT_MAX_QUEUED;
+    _queueCount--;
+    if (!send(client, slot, packet, queued->packetLen, queued->packetId))
+      WS_LOG_ERROR(MQTT, "Unable to send queued publish, dropped!");
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief    Encodes a QoS 1 PUBLISH packet with the next packet
+              identifier.
+    @param    topic
+              The MQTT topic to publish to.
+    @param    payload
+              The payload to publish.
+    @param    len
+              The length of the payload.
+    @param    packetLen
+              Set to the length of the encoded packet, in bytes.
+    @param    packetId
+              Set to the packet's identifier.
+    @returns  The encoded packet, to be freed by the caller, or nullptr if
+              it could not be allocated.
+*/
+/**************************************************************************/
+uint8_t *ws_mqtt_window::encode(const char *topic, uint8_t *payload,
+                                uint16_t len, uint16_t *packetLen,
+                                uint16_t *packetId) {
+  // topic length, topic, packet identifier, payload
+  uint16_t topicLen = strlen(topic);
+  uint32_t remainingLen = 2 + topicLen + 2 + len;
+  // fixed header is one byte plus up to three bytes of remaining length
+  uint8_t *packet = (uint8_t *)malloc(4 + remainingLen);
+  if (packet == nullptr)
+    return nullptr;
+
+  uint16_t pos = 0;
+  packet[pos++] = MQTT_CTRL_PUBLISH << 4 | MQTT_QOS_1 << 1;
+  do {
+    uint8_t encodedByte = remainingLen % 128;
+    remainingLen /= 128;
+    if (remainingLen > 0)
+      encodedByte |= 0x80;
+    packet[pos++] = encodedByte;
+  } while (remainingLen > 0);
+  packet[pos++] = topicLen >> 8;
+  packet[pos++] = topicLen & 0xFF;
+  memcpy(packet + pos, topic, topicLen);
+  pos += topicLen;
+
+  *packetId = _nextPacketId++;
+  if (_nextPacketId == 0)
+    _nextPacketId = WS_MQTT_WINDOW_PACKET_ID;
+  packet[pos++] = *packetId >> 8;
+  packet[pos++] = *packetId & 0xFF;
+  memcpy(packet + pos, payload, len);
+  pos += len;
+  *packetLen = pos;
+  return packet;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Finds a slot of the window which is not awaiting a PUBACK.
+    @returns  The free slot, nullptr if the window is full.
+*/
+/**************************************************************************/
+ws_mqtt_inflight_t *ws_mqtt_window::freeSlot() {
+  for (int i = 0; i < WS_MQTT_MAX_INFLIGHT; i++) {
+    if (_inFlight[i].packet == nullptr)
+      return &_inFlight[i];
+  }
+  return nullptr;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Sends an encoded packet and keeps it in a slot of the window
+              until its PUBACK arrives.
+    @param    client
+              The MQTT client's socket.
+    @param    slot
+              A free slot of the window.
+    @param    packet
+              The encoded packet, owned by the window from now on.
+    @param    packetLen
+              Length of the encoded packet, in bytes.
+    @param    packetId
+              The packet's identifier.
+    @returns  True if the packet was sent, False otherwise.
+*/
+/**************************************************************************/
+bool ws_mqtt_window::send(Client *client, ws_mqtt_inflight_t *slot,
+                          uint8_t *packet, uint16_t packetLen,
+                          uint16_t packetId) {
+  if (client->write(packet, packetLen) != packetLen) {
+    free(packet);
+    return false;
+  }
+  slot->packet = packet;
+  slot->packetLen = packetLen;
+  slot->packetId = packetId;
+  slot->sentAt = millis();
+  slot->retries = 0;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Sends a PINGREQ without waiting for the broker's PINGRESP,
+              which handleAck() reads. A ping which is still awaiting its
+              PINGRESP is only resent once WS_MQTT_ACK_TIMEOUT_MS passes.
+    @param    client
+              The MQTT client's socket.
+    @returns  False if the previous ping went unanswered, True otherwise.
+*/
+/**************************************************************************/
+bool ws_mqtt_window::ping(Client *client) {
+  if (client == nullptr)
+    return false;
+  if (_isPingPending && millis() - _pingSentAt < WS_MQTT_ACK_TIMEOUT_MS)
+    return true;
+
+  bool isAnswered = !_isPingPending;
+  uint8_t pingReq[2] = {MQTT_CTRL_PINGREQ << 4, 0};
+  client->write(pingReq, sizeof(pingReq));
+  _isPingPending = true;
+  _pingSentAt = millis();
+  return isAnswered;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Reads the next packet from the MQTT client's socket if it is
+              a PUBACK or a PINGRESP. A PUBACK releases the publish it
+              acknowledges. Must be called before the Adafruit_MQTT
+              library reads the socket, as the library drops PUBACKs it
+              is not waiting for.
+    @param    client
+              The MQTT client's socket.
+    @returns  True if a PUBACK or PINGRESP was read, False otherwise.
+*/
+/**************************************************************************/
+bool ws_mqtt_window::handleAck(Client *client) {
+  if (client == nullptr || client->available() < 2)
+    return false;
+
+  int type = client->peek();
+  if (type == MQTT_CTRL_PINGRESP << 4) {
+    uint8_t pingResp[2];
+    if (client->read(pingResp, sizeof(pingResp)) != sizeof(pingResp))
+      return false;
+    _isPingPending = false;
+    return true;
+  }
+
+  uint8_t ack[4];
+  if (type != MQTT_CTRL_PUBACK << 4 || client->available() < (int)sizeof(ack))
+    return false;
+  if (client->read(ack, sizeof(ack)) != sizeof(ack))
+    return false;
+
+  uint16_t packetId = ack[2] << 8 | ack[3];
+  for (int i = 0; i < WS_MQTT_MAX_INFLIGHT; i++) {
+    if (_inFlight[i].packet != nullptr && _inFlight[i].packetId == packetId) {
+      free(_inFlight[i].packet);
+      _inFlight[i].packet = nullptr;
+      break;
+    }
+  }
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Retransmits publishes whose PUBACK has not arrived in time,
+              and drops those which have run out of retries.
+    @param    client
+              The MQTT client's socket.
+*/
+/**************************************************************************/
+void ws_mqtt_window::retransmit(Client *client) {
+  if (client == nullptr || !client->connected())
+    return;
+
+  for (int i = 0; i < WS_MQTT_MAX_INFLIGHT; i++) {
+    ws_mqtt_inflight_t *slot = &_inFlight[i];
+    if (slot->packet == nullptr ||
+        millis() - slot->sentAt < WS_MQTT_ACK_TIMEOUT_MS)
+      continue;
+
+    if (slot->retries >= WS_MQTT_MAX_RETRIES) {
+      WS_LOG_ERROR(MQTT, "ERROR: Broker did not acknowledge publish, dropped!");
+      free(slot->packet);
+      slot->packet = nullptr;
+      continue;
+    }
+    // set the DUP flag, this is a redelivery
+    slot->packet[0] |= 0x08;
+    client->write(slot->packet, slot->packetLen);
+    slot->sentAt = millis();
+    slot->retries++;
+  }
+}
@@ -0,0 +1,99 @@
+/*!
+ * @file ws_mqtt_window.h
+ *
+ * Keeps several QoS 1 MQTT publishes in flight at once.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * Copyright (c) Brent Rubell 2023 for Adafruit Industries.
+ *
+ * MIT license, all text here must be included in any redistribution.
+ *
+ */
+#ifndef WS_MQTT_WINDOW_H
+#define WS_MQTT_WINDOW_H
+
+#include "Adafruit_MQTT.h"
+#include "Wippersnapper.h"
+
+#ifndef WS_MQTT_MAX_INFLIGHT
+#define WS_MQTT_MAX_INFLIGHT                                                   \
+  4 ///< Maximum number of unacknowledged QoS 1 publishes
+#endif
+#ifndef WS_MQTT_MAX_QUEUED
+#define WS_MQTT_MAX_QUEUED                                                     \
+  4 ///< Maximum number of QoS 1 publishes waiting for a free window slot
+#endif
+#define WS_MQTT_ACK_TIMEOUT_MS                                                 \
+  3000 ///< Time to wait for a PUBACK before retransmitting, in ms
+#define WS_MQTT_MAX_RETRIES                                                    \
+  3 ///< Retransmissions of a publish before it is dropped
+#define WS_MQTT_WINDOW_PACKET_ID                                               \
+  0x8000 ///< First packet identifier used by the window, the
+         ///< Adafruit_MQTT library counts up from 0
+
+/** An unacknowledged QoS 1 publish */
+struct ws_mqtt_inflight_t {
+  uint8_t *packet = nullptr; ///< Encoded PUBLISH packet, nullptr if unused
+  uint16_t packetLen = 0;    ///< Length of the encoded packet, in bytes
+  uint16_t packetId = 0;     ///< The publish's packet identifier
+  unsigned long sentAt = 0;  ///< When the packet was last sent, in ms
+  uint8_t retries = 0;       ///< Number of retransmissions so far
+};
+
+class Wippersnapper;
+
+/**************************************************************************/
+/*!
+    @brief  Publishes QoS 1 messages without waiting for each PUBACK, so a
+            burst of publishes costs one round trip instead of one per
+            message.
+
+            The encoded packets are kept until the broker acknowledges
+            them and are retransmitted, with the DUP flag set, if no
+            PUBACK arrives in time. Publishes made while the window is
+            full wait in a small queue, sent by sendQueued() as slots
+            free up, and are dropped and counted once it is full too.
+
+            The Adafruit_MQTT library drops PUBACKs it is not waiting
+            for, so while publishes are in flight the socket is only read
+            through handleAck() and Wippersnapper::processPackets(). Pings
+            are sent from here too, their PINGRESP is read by handleAck().
+*/
+/**************************************************************************/
+class ws_mqtt_window {
+public:
+  ws_mqtt_window();
+  ~ws_mqtt_window();
+
+  bool publish(Client *client, const char *topic, uint8_t *payload,
+               uint16_t len);
+  void sendQueued(Client *client);
+  bool ping(Client *client);
+  bool handleAck(Client *client);
+  void retransmit(Client *client);
+
+private:
+  uint8_t *encode(const char *topic, uint8_t *payload, uint16_t len,
+                  uint16_t *packetLen, uint16_t *packetId);
+  ws_mqtt_inflight_t *freeSlot();
+  bool send(Client *client, ws_mqtt_inflight_t *slot, uint8_t *packet,
+            uint16_t packetLen, uint16_t packetId);
+
+  ws_mqtt_inflight_t _inFlight[WS_MQTT_MAX_INFLIGHT]; ///< Publishes awaiting
+                                                      ///< a PUBACK
+  uint16_t _nextPacketId = WS_MQTT_WINDOW_PACKET_ID; ///< Next identifier
+  ws_mqtt_inflight_t _queue[WS_MQTT_MAX_QUEUED]; ///< Encoded publishes
+                                                 ///< awaiting a free slot
+  uint8_t _queueHead = 0;  ///< Index of the oldest queued publish
+  uint8_t _queueCount = 0; ///< Number of queued publishes
+  uint32_t _dropped = 0;   ///< Publishes dropped while the queue was full
+
+  bool _isPingPending = false;   ///< True if a PINGREQ awaits its PINGRESP
+  unsigned long _pingSentAt = 0; ///< When the PINGREQ was sent, in ms
+};
+extern Wippersnapper WS;
+
+#endif // WS_MQTT_WINDOW_H
@@ -27,6 +27,11 @@ strand_s strands[MAX_PIXEL_STRANDS]{
     -1,
     -1}; ///< Contains all pixel strands used by WipperSnapper
 
+ws_pool<Adafruit_NeoPixel, MAX_PIXEL_STRANDS>
+    neoPixelPool; ///< Storage for NeoPixel strand objects
+ws_pool<Adafruit_DotStar, MAX_PIXEL_STRANDS>
+    dotStarPool; ///< Storage for DotStar strand objects
+
 /**************************************************************************/
 /*!
     @brief  Destructor
@@ -66,10 +71,8 @@ int16_t ws_pixels::allocateStrand() {
 void ws_pixels::deallocateStrand(int16_t strandIdx) {
 
   // delete the pixel object
-  if (strands[strandIdx].neoPixelPtr != nullptr)
-    delete strands[strandIdx].neoPixelPtr;
-  if ((strands[strandIdx].dotStarPtr != nullptr))
-    delete strands[strandIdx].dotStarPtr;
+  neoPixelPool.destroy(strands[strandIdx].neoPixelPtr);
+  dotStarPool.destroy(strands[strandIdx].dotStarPtr);
 
   // re-initialize status pixel (if pixel was prvsly used)
   if (strands[strandIdx].pinNeoPixel == getStatusNeoPixelPin() ||
@@ -172,8 +175,8 @@ void ws_pixels::publishAddStrandResponse(bool is_success,
       pb_ostream_from_buffer(WS._buffer_outgoing, sizeof(WS._buffer_outgoing));
   if (!pb_encode(&ostream, wippersnapper_signal_v1_PixelsResponse_fields,
                  &msgInitResp)) {
-    WS_DEBUG_PRINTLN("ERROR: Unable to encode "
-                     "wippersnapper_signal_v1_PixelsResponse message!");
+    WS_LOG_ERROR(PIXELS, "ERROR: Unable to encode "
+                         "wippersnapper_signal_v1_PixelsResponse message!");
     return;
   }
 
@@ -181,10 +184,8 @@ void ws_pixels::publishAddStrandResponse(bool is_success,
   size_t msgSz;
   pb_get_encoded_size(&msgSz, wippersnapper_signal_v1_PixelsResponse_fields,
                       &msgInitResp);
-  WS_DEBUG_PRINT("-> wippersnapper_signal_v1_PixelsResponse...");
-  WS._mqtt->publish(WS._topic_signal_pixels_device, WS._buffer_outgoing, msgSz,
-                    1);
-  WS_DEBUG_PRINTLN("Published!");
+  WS.publish(WS._topic_signal_pixels_device, WS._buffer_outgoing, msgSz, 1);
+  WS_LOG_DEBUG(PIXELS, "Published wippersnapper_signal_v1_PixelsResponse");
 }
 
 /**************************************************************************/
@@ -228,7 +229,7 @@ bool ws_pixels::addStrand(
     strands[strandIdx].pinDotStarClock =
         atoi(pixelsCreateReqMsg->pixels_pin_dotstar_clock + 1);
   } else {
-    WS_DEBUG_PRINTLN("ERROR: Invalid strand type provided!");
+    WS_LOG_ERROR(PIXELS, "ERROR: Invalid strand type provided!");
     publishAddStrandResponse(false, pixelsCreateReqMsg->pixels_pin_neopixel);
     return false;
   }
@@ -243,7 +244,7 @@ bool ws_pixels::addStrand(
       releaseStatusLED(); // release it!
 
     // Create a new strand of NeoPixels
-    strands[strandIdx].neoPixelPtr = new Adafruit_NeoPixel(
+    strands[strandIdx].neoPixelPtr = neoPixelPool.create(
         pixelsCreateReqMsg->pixels_num, strands[strandIdx].pinNeoPixel,
         getNeoPixelStrandOrder(pixelsCreateReqMsg->pixels_ordering));
 
@@ -260,10 +261,9 @@ bool ws_pixels::addStrand(
       return false;
     }
 
-    WS_DEBUG_PRINT("Created NeoPixel strand of length ");
-    WS_DEBUG_PRINT(pixelsCreateReqMsg->pixels_num);
-    WS_DEBUG_PRINT(" on GPIO #");
-    WS_DEBUG_PRINTLN(pixelsCreateReqMsg->pixels_pin_neopixel);
+    WS_LOG_INFO(PIXELS, "Created NeoPixel strand of length %u on GPIO #%s",
+                pixelsCreateReqMsg->pixels_num,
+                pixelsCreateReqMsg->pixels_pin_neopixel);
 
 #ifdef USE_DISPLAY
     char buffer[100];
@@ -284,7 +284,7 @@ bool ws_pixels::addStrand(
     }
 
     // Create Dotstar strand
-    strands[strandIdx].dotStarPtr = new Adafruit_DotStar(
+    strands[strandIdx].dotStarPtr = dotStarPool.create(
         strands[strandIdx].numPixels, strands[strandIdx].pinDotStarData,
         strands[strandIdx].pinDotStarClock,
         getDotStarStrandOrder(strands[strandIdx].ordering));
@@ -302,10 +302,9 @@ bool ws_pixels::addStrand(
       return false;
     }
 
-    WS_DEBUG_PRINT("Created DotStar strand of length ");
-    WS_DEBUG_PRINT(strands[strandIdx].numPixels);
-    WS_DEBUG_PRINT(" on Data GPIO #");
-    WS_DEBUG_PRINTLN(strands[strandIdx].pinDotStarData);
+    WS_LOG_INFO(PIXELS, "Created DotStar strand of length %u on Data GPIO #%d",
+                strands[strandIdx].numPixels,
+                strands[strandIdx].pinDotStarData);
 
 #ifdef USE_DISPLAY
     char buffer[100];
@@ -316,7 +315,7 @@ bool ws_pixels::addStrand(
 
     publishAddStrandResponse(true, pixelsCreateReqMsg->pixels_pin_dotstar_data);
   } else {
-    WS_DEBUG_PRINTLN("ERROR: Invalid strand type provided!");
+    WS_LOG_ERROR(PIXELS, "ERROR: Invalid strand type provided!");
     publishAddStrandResponse(false,
                              pixelsCreateReqMsg->pixels_pin_dotstar_data);
     return false;
@@ -364,14 +363,15 @@ void ws_pixels::deleteStrand(
   int strandIdx = getStrandIdx(atoi(pixelsDeleteMsg->pixels_pin_data + 1),
                                pixelsDeleteMsg->pixels_type);
   if (strandIdx == ERR_INVALID_STRAND) {
-    WS_DEBUG_PRINTLN("ERROR: Strand not found, unable to delete strand!");
+    WS_LOG_ERROR(PIXELS, "ERROR: Strand not found, unable to delete strand!");
     return;
   }
   // deallocate and release resources of strand object
   deallocateStrand(strandIdx);
 
-  WS_DEBUG_PRINT("Deleted strand on data pin ");
-  WS_DEBUG_PRINTLN(pixelsDeleteMsg->pixels_pin_data);
+  WS_LOG_INFO(PIXELS, "Deleted strand on data pin %s",
+              pixelsDeleteMsg->pixels_pin_data);
+  WS.printHeapStats();
 
 #ifdef USE_DISPLAY
   char buffer[100];
@@ -398,7 +398,8 @@ uint32_t ws_pixels::getGammaCorrectedColor(uint32_t pixel_color,
   } else if (strand.dotStarPtr != nullptr) {
     return strand.dotStarPtr->gamma32(pixel_color);
   } else {
-    WS_DEBUG_PRINTLN(
+    WS_LOG_ERROR(
+        PIXELS,
         "ERROR: Unable to perform gamma correction, unknown strand type!");
     return 0;
   }
@@ -420,7 +421,8 @@ void ws_pixels::fillStrand(
   int strandIdx = getStrandIdx(atoi(pixelsWriteMsg->pixels_pin_data + 1),
                                pixelsWriteMsg->pixels_type);
   if (strandIdx == ERR_INVALID_STRAND) {
-    WS_DEBUG_PRINTLN(
+    WS_LOG_ERROR(
+        PIXELS,
         "ERROR: Pixel strand not found, can not write a color to the strand!");
     return;
   }
@@ -428,8 +430,7 @@ void ws_pixels::fillStrand(
   uint32_t rgbColorGamma =
       getGammaCorrectedColor(pixelsWriteMsg->pixels_color, strands[strandIdx]);
 
-  WS_DEBUG_PRINT("Filling color: ");
-  WS_DEBUG_PRINTLN(pixelsWriteMsg->pixels_color);
+  WS_LOG_DEBUG(PIXELS, "Filling color: %u", pixelsWriteMsg->pixels_color);
 
 #ifdef USE_DISPLAY
   char buffer[100];
@@ -447,6 +448,6 @@ void ws_pixels::fillStrand(
     strands[strandIdx].dotStarPtr->fill(rgbColorGamma);
     strands[strandIdx].dotStarPtr->show();
   } else {
-    WS_DEBUG_PRINTLN("ERROR: Unable to determine pixel type to write to!");
+    WS_LOG_ERROR(PIXELS, "ERROR: Unable to determine pixel type to write to!");
   }
 }
\ No newline at end of file
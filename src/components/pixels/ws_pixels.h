@@ -19,6 +19,7 @@
 #define WS_PIXELS
 
 #include "Wippersnapper.h"
+#include "components/pool/ws_pool.h"
 
 #define MAX_PIXEL_STRANDS                                                      \
   5 ///< Maximum number of pixel strands connected to a WipperSnapper device
@@ -0,0 +1,166 @@
+/*!
+ * @file ws_pool.h
+ *
+ * Fixed-size memory pools for objects which are created and destroyed
+ * by the broker at runtime (I2C drivers, OneWire buses, pixel strands,
+ * servos). Allocating them from statically reserved slots keeps the
+ * objects themselves off the heap across init/deinit cycles. Library
+ * objects they create in turn, such as an I2C driver's sensor object,
+ * are still allocated from the heap.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * Copyright (c) Brent Rubell 2023 for Adafruit Industries.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+#ifndef WS_POOL_H
+#define WS_POOL_H
+
+#include <Arduino.h>
+#include <new>
+
+/**************************************************************************/
+/*!
+    @brief  Pool of N fixed-size, untyped memory blocks. Requests which
+            don't fit in a block, or arrive while the pool is full, fall
+            back to the heap.
+*/
+/**************************************************************************/
+template <size_t BlockSize, size_t N> class ws_block_pool {
+public:
+  /**************************************************************************/
+  /*!
+      @brief    Allocates memory from the pool.
+      @param    size
+                Number of bytes requested.
+      @returns  Pointer to the allocated memory, nullptr on failure.
+  */
+  /**************************************************************************/
+  void *allocate(size_t size) {
+    if (size <= BlockSize) {
+      for (size_t i = 0; i < N; i++) {
+        if (!_inUse[i]) {
+          _inUse[i] = true;
+          return _blocks[i];
+        }
+      }
+    }
+    _heapAllocations++;
+    return malloc(size);
+  }
+
+  /**************************************************************************/
+  /*!
+      @brief    Returns memory to the pool, or to the heap if it was not
+                allocated from the pool.
+      @param    ptr
+                Pointer returned by allocate().
+  */
+  /**************************************************************************/
+  void release(void *ptr) {
+    if (ptr == nullptr)
+      return;
+    for (size_t i = 0; i < N; i++) {
+      if (ptr == _blocks[i]) {
+        _inUse[i] = false;
+        return;
+      }
+    }
+    free(ptr);
+  }
+
+  /**************************************************************************/
+  /*!
+      @brief    Returns the number of unused blocks.
+      @returns  Number of blocks available.
+  */
+  /**************************************************************************/
+  size_t available() {
+    size_t count = 0;
+    for (size_t i = 0; i < N; i++) {
+      if (!_inUse[i])
+        count++;
+    }
+    return count;
+  }
+
+  /**************************************************************************/
+  /*!
+      @brief    Returns the number of allocations which fell back to the
+                heap.
+      @returns  Number of heap allocations.
+  */
+  /**************************************************************************/
+  uint32_t getHeapAllocations() { return _heapAllocations; }
+
+private:
+  alignas(8) uint8_t _blocks[N][BlockSize]; ///< Pool storage
+  bool _inUse[N] = {false};                 ///< True if a block is allocated
+  uint32_t _heapAllocations = 0; ///< Allocations which fell back to the heap
+};
+
+/**************************************************************************/
+/*!
+    @brief  Pool of up to N objects of type T. Objects are constructed
+            in place within the pool, falling back to the heap if the
+            pool is full.
+*/
+/**************************************************************************/
+template <typename T, size_t N> class ws_pool {
+public:
+  /**************************************************************************/
+  /*!
+      @brief    Constructs a new object within the pool.
+      @param    args
+                Arguments forwarded to T's constructor.
+      @returns  Pointer to the new object.
+  */
+  /**************************************************************************/
+  template <typename... Args> T *create(Args... args) {
+    void *ptr = _blocks.allocate(sizeof(T));
+    if (ptr == nullptr)
+      return nullptr;
+    return new (ptr) T(args...);
+  }
+
+  /**************************************************************************/
+  /*!
+      @brief    Destroys an object created by create() and releases
+                its memory.
+      @param    obj
+                Pointer to the object.
+  */
+  /**************************************************************************/
+  void destroy(T *obj) {
+    if (obj == nullptr)
+      return;
+    obj->~T();
+    _blocks.release(obj);
+  }
+
+  /**************************************************************************/
+  /*!
+      @brief    Returns the number of unused slots.
+      @returns  Number of slots available.
+  */
+  /**************************************************************************/
+  size_t available() { return _blocks.available(); }
+
+  /**************************************************************************/
+  /*!
+      @brief    Returns the number of objects which were created on the
+                heap because the pool was full.
+      @returns  Number of heap allocations.
+  */
+  /**************************************************************************/
+  uint32_t getHeapAllocations() { return _blocks.getHeapAllocations(); }
+
+private:
+  ws_block_pool<sizeof(T), N> _blocks; ///< Storage for the pool's objects
+};
+
+#endif // WS_POOL_H
@@ -78,10 +78,14 @@ bool Wippersnapper::encodePubRegistrationReq() {
 void Wippersnapper::pollRegistrationResp() {
   // Blocking loop, WDT reset upon failure.
   while (WS._boardStatus != WS_BOARD_DEF_OK) {
-    WS_DEBUG_PRINT("Polling for registration message response...");
-    WS_DEBUG_PRINTLN(WS._boardStatus);
-    statusLEDBlink(WS_LED_STATUS_WAITING_FOR_REG_MSG);
-    WS._mqtt->processPackets(20); // long-poll
+    // print and blink once per blink animation
+    if (!statusLEDIsBusy()) {
+      WS_DEBUG_PRINT("Polling for registration message response...");
+      WS_DEBUG_PRINTLN(WS._boardStatus);
+      statusLEDBlink(WS_LED_STATUS_WAITING_FOR_REG_MSG);
+    }
+    statusLEDTick();
+    WS.pollPackets(20); // long-poll
   }
 }
 
@@ -22,9 +22,12 @@
 /**************************************************************************/
 ws_servo::~ws_servo() {
   for (int i = 0; i < MAX_SERVO_NUM; i++) {
+    if (_servos[i].servoObj == nullptr)
+      continue;
     // de-allocate servo pins, if attached
     if (_servos[i].servoObj->attached())
       _servos[i].servoObj->detach();
+    _servoPool.destroy(_servos[i].servoObj);
   }
 }
 
@@ -37,12 +40,10 @@ ws_servo::~ws_servo() {
 /**************************************************************************/
 servoComponent *ws_servo::getServoComponent(uint8_t pin) {
   for (int i = 0; i < sizeof(_servos) / sizeof(_servos[0]); i++) {
-    WS_DEBUG_PRINTLN(_servos[i].pin);
-    if (_servos[i].pin == pin)
+    if (_servos[i].servoObj != nullptr && _servos[i].pin == pin)
       return &_servos[i];
   }
-  WS_DEBUG_PRINT("ERROR: Can not find servo on pin #");
-  WS_DEBUG_PRINTLN(pin);
+  WS_LOG_ERROR(SERVO, "ERROR: Can not find servo on pin #%u", pin);
   return nullptr;
 }
 
@@ -59,13 +60,23 @@ servoComponent *ws_servo::getServoComponent(uint8_t pin) {
 /**************************************************************************/
 bool ws_servo::servo_attach(int pin, int minPulseWidth, int maxPulseWidth,
                             int freq) {
+  // Attempt to allocate an unused servo
+  int servoIdx = -1;
+  for (int i = 0; i < MAX_SERVO_NUM; i++) {
+    if (_servos[i].servoObj == nullptr) {
+      servoIdx = i;
+      break;
+    }
+  }
+  if (servoIdx == -1) {
+    WS_LOG_ERROR(SERVO, "ERROR: Maximum number of servos attached!");
+    return false;
+  }
+
+  ws_servo_t *servo = _servoPool.create();
 #ifdef ARDUINO_ARCH_ESP32
   // ESP32/x specific implementation
-  ws_ledc_servo *servo = new ws_ledc_servo();
   servo->setLEDCDriver(WS._ledc);
-#else
-  // generic Servo.h
-  Servo *servo = new Servo();
 #endif
 
   uint16_t rc = ERR_SERVO_ATTACH;
@@ -74,16 +85,9 @@ bool ws_servo::servo_attach(int pin, int minPulseWidth, int maxPulseWidth,
 #else
   rc = servo->attach(pin, minPulseWidth, maxPulseWidth);
 #endif
-  if (rc == ERR_SERVO_ATTACH)
+  if (rc == ERR_SERVO_ATTACH) {
+    _servoPool.destroy(servo);
     return false; // allocation or pin error
-
-  // Attempt to allocate an unused servo
-  int servoIdx = -1;
-  for (int i = 0; i < MAX_SERVO_NUM; i++) {
-    if (_servos[i].pin == 0) {
-      servoIdx = i;
-      break;
-    }
   }
 
   // create a new servo component storage struct
@@ -112,7 +116,9 @@ void ws_servo::servo_detach(int pin) {
   // release pin from use by servo object
   servoComponentPtr->servoObj->detach();
   // de-init servo object
-  delete servoComponentPtr->servoObj;
+  _servoPool.destroy(servoComponentPtr->servoObj);
+  servoComponentPtr->servoObj = nullptr;
+  WS.printHeapStats();
 }
 
 /**************************************************************************/
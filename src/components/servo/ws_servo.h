@@ -18,6 +18,7 @@
 #define WS_SERVO
 
 #include "Wippersnapper.h"
+#include "components/pool/ws_pool.h"
 
 #if defined(ARDUINO_ARCH_ESP32)
 #include "components/ledc/drivers/servo/ws_ledc_servo.h"
@@ -38,18 +39,16 @@
 
 #if defined(ARDUINO_ARCH_ESP32)
 class ws_ledc_servo;
-/** Servo object for ESP32-servo implementation */
-struct servoComponent {
-  ws_ledc_servo *servoObj = nullptr; ///< Servo object
-  uint8_t pin = 0;                   ///< Servo's pin number
-};
+typedef ws_ledc_servo ws_servo_t; ///< Servo driver for ESP32
 #else
-/** Servo object for Generic servo implementation */
+typedef Servo ws_servo_t; ///< Generic Servo.h driver
+#endif
+
+/** Servo object and its pin */
 struct servoComponent {
-  Servo *servoObj = nullptr; ///< Servo object
-  uint8_t pin = 0;           ///< Servo's pin number
+  ws_servo_t *servoObj = nullptr; ///< Servo object
+  uint8_t pin = 0;                ///< Servo's pin number
 };
-#endif
 
 class Wippersnapper;
 
@@ -70,6 +69,8 @@ public:
 private:
   servoComponent _servos[MAX_SERVO_NUM]; ///< Container of servo objects and
                                          ///< their associated pin #s
+  ws_pool<ws_servo_t, MAX_SERVO_NUM>
+      _servoPool; ///< Storage for the servo objects
 };
 extern Wippersnapper WS;
 
@@ -28,6 +28,16 @@ Adafruit_DotStar *statusPixelDotStar =
                          STATUS_DOTSTAR_PIN_CLK, DOTSTAR_BRG);
 #endif
 
+static ws_led_animation_t
+    statusLEDQueue[STATUS_LED_QUEUE_SIZE]; ///< Queued status LED animations
+static uint8_t statusLEDQueueHead = 0;     ///< Index of the next animation
+static uint8_t statusLEDQueueCount = 0;    ///< Number of queued animations
+static ws_led_animation_t statusLEDCurrent; ///< Animation being played
+static bool statusLEDPlaying = false; ///< True if an animation is playing
+static uint16_t statusLEDStep = 0;    ///< Next step of the current animation
+static unsigned long statusLEDStepTime =
+    0; ///< Time the last animation step was drawn, in millis
+
 /****************************************************************************/
 /*!
     @brief    Initializes board-specific status LED pixel
@@ -278,7 +288,129 @@ int16_t getStatusDotStarDataPin() {
 
 /****************************************************************************/
 /*!
-    @brief    Fades the status LED.
+    @brief    Turns the status LED off.
+*/
+/****************************************************************************/
+static void statusLEDOff() {
+#if not defined(ARDUINO_ESP8266_ADAFRUIT_HUZZAH)
+  setStatusLEDColor(BLACK);
+#else
+  // The Adafruit Feather ESP8266's built-in LED is reverse wired
+  setStatusLEDColor(BLACK ^ 1);
+#endif
+}
+
+/****************************************************************************/
+/*!
+    @brief    Adds an animation to the status LED queue. Requests
+              matching the last queued (or playing) animation are
+              coalesced, and requests are dropped while the queue is full.
+    @param    pattern
+              Animation pattern.
+    @param    color
+              Animation color.
+    @param    numSteps
+              Total number of steps in the animation.
+*/
+/****************************************************************************/
+static void statusLEDEnqueue(ws_led_pattern_t pattern, uint32_t color,
+                             uint16_t numSteps) {
+  ws_led_animation_t *last = nullptr;
+  if (statusLEDQueueCount > 0)
+    last = &statusLEDQueue[(statusLEDQueueHead + statusLEDQueueCount - 1) %
+                           STATUS_LED_QUEUE_SIZE];
+  else if (statusLEDPlaying)
+    last = &statusLEDCurrent;
+  if (last != nullptr && last->pattern == pattern && last->color == color)
+    return;
+
+  if (statusLEDQueueCount == STATUS_LED_QUEUE_SIZE)
+    return;
+  statusLEDQueue[(statusLEDQueueHead + statusLEDQueueCount) %
+                 STATUS_LED_QUEUE_SIZE] = {pattern, color, numSteps};
+  statusLEDQueueCount++;
+
+  // start playing right away, if idle
+  statusLEDTick();
+}
+
+/****************************************************************************/
+/*!
+    @brief    Advances the status LED animation queue. Must be called
+              frequently (from run() or any loop which waits) and never
+              blocks.
+*/
+/****************************************************************************/
+void statusLEDTick() {
+  if (!statusLEDPlaying) {
+    if (statusLEDQueueCount == 0)
+      return;
+    // pop the next animation off the queue
+    statusLEDCurrent = statusLEDQueue[statusLEDQueueHead];
+    statusLEDQueueHead = (statusLEDQueueHead + 1) % STATUS_LED_QUEUE_SIZE;
+    statusLEDQueueCount--;
+    statusLEDPlaying = true;
+    statusLEDStep = 0;
+  } else {
+    unsigned long stepTime = STATUS_LED_FADE_STEP_TIME;
+    if (statusLEDCurrent.pattern == WS_LED_PATTERN_BLINK)
+      stepTime = STATUS_LED_BLINK_TIME;
+    if (millis() - statusLEDStepTime < stepTime)
+      return;
+  }
+  statusLEDStepTime = millis();
+
+  // animation complete
+  if (statusLEDStep >= statusLEDCurrent.numSteps) {
+    statusLEDOff();
+    statusLEDPlaying = false;
+    return;
+  }
+
+  if (statusLEDCurrent.pattern == WS_LED_PATTERN_BLINK) {
+    // even steps are on, odd steps are off
+    if (statusLEDStep % 2 == 0)
+      setStatusLEDColor(statusLEDCurrent.color);
+    else
+      statusLEDOff();
+  } else {
+    // fade up, then back down
+    uint16_t halfSteps = 255 / STATUS_LED_FADE_STEP + 1;
+    uint16_t pos = statusLEDStep % (2 * halfSteps);
+    if (pos >= halfSteps)
+      pos = 2 * halfSteps - 1 - pos;
+    setStatusLEDColor(statusLEDCurrent.color, pos * STATUS_LED_FADE_STEP);
+  }
+  statusLEDStep++;
+}
+
+/****************************************************************************/
+/*!
+    @brief    Checks if the status LED is playing or has queued animations.
+    @returns  True if an animation is pending, False otherwise.
+*/
+/****************************************************************************/
+bool statusLEDIsBusy() { return statusLEDPlaying || statusLEDQueueCount > 0; }
+
+/****************************************************************************/
+/*!
+    @brief    Waits for a period of time while continuing to animate the
+              status LED.
+    @param    ms
+              Time to wait, in milliseconds.
+*/
+/****************************************************************************/
+void statusLEDWait(uint32_t ms) {
+  unsigned long startTime = millis();
+  while (millis() - startTime < ms) {
+    statusLEDTick();
+    yield();
+  }
+}
+
+/****************************************************************************/
+/*!
+    @brief    Queues a fade of the status LED.
     @param    color
               The specific color to fade the status LED.
     @param    numFades
@@ -290,27 +422,9 @@ void statusLEDFade(uint32_t color, int numFades = 3) {
   if (WS.status_pixel_brightness == 0.0)
     return;
 
-  // pulse `numFades` times
-  for (int i = 0; i < numFades; i++) {
-    // fade up
-    for (int i = 0; i <= 255; i += 5) {
-      setStatusLEDColor(color, i);
-      delay(10);
-    }
-    // fade down
-    for (int i = 0; i >= 255; i -= 5) {
-      setStatusLEDColor(color, i);
-      delay(10);
-    }
-  }
-
-// Turn status LED off
-#if not defined(ARDUINO_ESP8266_ADAFRUIT_HUZZAH)
-  setStatusLEDColor(BLACK);
-#else
-  // The Adafruit Feather ESP8266's built-in LED is reverse wired
-  setStatusLEDColor(BLACK ^ 1);
-#endif
+  // each fade steps up to full brightness and back down
+  uint16_t fadeSteps = 2 * (255 / STATUS_LED_FADE_STEP + 1);
+  statusLEDEnqueue(WS_LED_PATTERN_FADE, color, numFades * fadeSteps);
 }
 
 /****************************************************************************/
@@ -368,14 +482,18 @@ void statusLEDSolid(ws_led_status_t statusState = WS_LED_STATUS_ERROR_RUNTIME) {
     return; // status pixel is in-use elsewhere
 #endif
 
+  // a solid color replaces any queued animations
+  statusLEDQueueCount = 0;
+  statusLEDPlaying = false;
+
   uint32_t ledColor = ledStatusStateToColor(statusState);
   setStatusLEDColor(ledColor);
 }
 
 /****************************************************************************/
 /*!
-    @brief    Blinks a status LED a specific color depending on
-              the hardware's state.
+    @brief    Queues a blink of the status LED, in a specific color
+              depending on the hardware's state.
     @param    statusState
               Hardware's status state.
 */
@@ -391,21 +509,6 @@ void statusLEDBlink(ws_led_status_t statusState) {
     return; // status pixel is in-use elsewhere
 #endif
 
-  // set number of times to blink
-  int blinkNum = 3;
-  // set blink color
-  uint32_t ledColor = ledStatusStateToColor(statusState);
-
-  while (blinkNum > 0) {
-    setStatusLEDColor(ledColor);
-    delay(100);
-#if defined(ARDUINO_ESP8266_ADAFRUIT_HUZZAH)
-    // The Adafruit Feather ESP8266's built-in LED is reverse wired
-    setStatusLEDColor(BLACK ^ 1);
-#else
-    setStatusLEDColor(BLACK);
-#endif
-    delay(100);
-    blinkNum--;
-  }
-}
\ No newline at end of file
+  statusLEDEnqueue(WS_LED_PATTERN_BLINK, ledStatusStateToColor(statusState),
+                   2 * STATUS_LED_BLINK_NUM);
+}
@@ -29,6 +29,13 @@
 #define STATUS_LED_KAT_BLINK_TIME                                              \
   120000 ///< How often to blink the status LED while run() executes, if not
          ///< in-use
+#define STATUS_LED_BLINK_NUM 3 ///< Number of blinks per statusLEDBlink() call
+#define STATUS_LED_BLINK_TIME                                                  \
+  100 ///< Time the status LED is on (and off) for each blink, in ms
+#define STATUS_LED_FADE_STEP 5 ///< Brightness increment of each fade step
+#define STATUS_LED_FADE_STEP_TIME 10 ///< Time between fade steps, in ms
+#define STATUS_LED_QUEUE_SIZE                                                  \
+  4 ///< Maximum number of queued status LED animations
 
 /** Defines the Wippersnapper status LED states */
 typedef enum ws_led_status_t {
@@ -40,6 +47,19 @@ typedef enum ws_led_status_t {
   WS_LED_STATUS_KAT,
 } ws_led_status_t;
 
+/** Status LED animation patterns */
+typedef enum ws_led_pattern_t {
+  WS_LED_PATTERN_BLINK, ///< Blink on and off
+  WS_LED_PATTERN_FADE,  ///< Pulse brightness up and down
+} ws_led_pattern_t;
+
+/** A queued status LED animation */
+typedef struct ws_led_animation_t {
+  ws_led_pattern_t pattern; ///< Animation pattern
+  uint32_t color;           ///< Animation color
+  uint16_t numSteps;        ///< Total number of steps in the animation
+} ws_led_animation_t;
+
 #define RED 0xFF0000    ///< Red (as a uint32)
 #define CYAN 0x00FFFF   ///< Cyan (as a uint32)
 #define YELLOW 0xFFFF00 ///< Yellow (as a uint32)
@@ -70,5 +90,8 @@ void setStatusLEDColor(uint32_t color, int brightness);
 void statusLEDBlink(ws_led_status_t statusState = WS_LED_STATUS_ERROR_RUNTIME);
 void statusLEDFade(uint32_t color, int numFades);
 void statusLEDSolid(ws_led_status_t statusState);
+void statusLEDTick();
+bool statusLEDIsBusy();
+void statusLEDWait(uint32_t ms);
 
 #endif // WIPPERSNAPPER_STATUSLED_H
\ No newline at end of file
@@ -0,0 +1,561 @@
+/*!
+ * @file ws_warmstart.cpp
+ *
+ * Persists the hardware configuration sent by the broker so it can be
+ * restored as soon as the device boots, before it has connected to
+ * Adafruit IO.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * Copyright (c) Brent Rubell 2023 for Adafruit Industries.
+ *
+ * MIT license, all text here must be included in any redistribution.
+ *
+ */
+#include "ws_warmstart.h"
+
+#define WS_WARMSTART_HEADER_SIZE 3 ///< Record header: topic, 16-bit length
+
+#if defined(USE_TINYUSB)
+extern FatVolume wipperFatFs;       ///< File system object from Adafruit SDFat
+typedef File32 ws_warmstart_file_t; ///< Snapshot file
+#elif defined(USE_LITTLEFS)
+typedef File ws_warmstart_file_t; ///< Snapshot file
+#endif
+
+#if defined(USE_TINYUSB) || defined(USE_LITTLEFS)
+/**************************************************************************/
+/*!
+    @brief    Opens a snapshot file.
+    @param    path
+              The file's path.
+    @param    isWrite
+              True to open the file for appending, False for reading.
+    @returns  The snapshot file.
+*/
+/**************************************************************************/
+static ws_warmstart_file_t openFile(const char *path, bool isWrite) {
+#if defined(USE_TINYUSB)
+  return wipperFatFs.open(path, isWrite ? FILE_WRITE : FILE_READ);
+#else
+  return LittleFS.open(path, isWrite ? "a" : "r");
+#endif
+}
+
+/**************************************************************************/
+/*!
+    @brief    Deletes a snapshot file.
+    @param    path
+              The file's path.
+    @returns  True if the file was deleted, False otherwise.
+*/
+/**************************************************************************/
+static bool removeFile(const char *path) {
+#if defined(USE_TINYUSB)
+  return wipperFatFs.remove(path);
+#else
+  return LittleFS.remove(path);
+#endif
+}
+
+/**************************************************************************/
+/*!
+    @brief    Renames a snapshot file.
+    @param    from
+              The file's current path.
+    @param    to
+              The file's new path.
+    @returns  True if the file was renamed, False otherwise.
+*/
+/**************************************************************************/
+static bool renameFile(const char *from, const char *to) {
+#if defined(USE_TINYUSB)
+  return wipperFatFs.rename(from, to);
+#else
+  return LittleFS.rename(from, to);
+#endif
+}
+
+/**************************************************************************/
+/*!
+    @brief    Reads the header of a record within the snapshot.
+    @param    file
+              The snapshot file, open for reading.
+    @param    offset
+              Offset of the record within the snapshot.
+    @param    topic
+              Set to the record's topic.
+    @param    len
+              Set to the length of the record's message.
+    @returns  True if the header was read, False otherwise.
+*/
+/**************************************************************************/
+static bool readHeader(ws_warmstart_file_t &file, size_t offset,
+                       uint8_t *topic, uint16_t *len) {
+  uint8_t header[WS_WARMSTART_HEADER_SIZE];
+  if (!file.seek(offset) ||
+      file.read(header, sizeof(header)) != sizeof(header))
+    return false;
+  *topic = header[0];
+  *len = header[1] | (header[2] << 8);
+  return true;
+}
+#endif
+
+/**************************************************************************/
+/*!
+    @brief    Checks if a message configures hardware, rather than
+              commanding it, from the tag of its payload.
+    @param    topic
+              Topic the message was received on.
+    @param    data
+              The message's payload.
+    @param    len
+              Length of the message's payload.
+    @returns  True if the message is configuration, False otherwise.
+*/
+/**************************************************************************/
+static bool isConfiguration(ws_warmstart_topic_t topic, char *data,
+                            uint16_t len) {
+  // every request holds a single oneof, its tag comes first
+  pb_istream_t stream = pb_istream_from_buffer((pb_byte_t *)data, len);
+  pb_wire_type_t wireType;
+  uint32_t tag;
+  bool isEof;
+  if (!pb_decode_tag(&stream, &wireType, &tag, &isEof))
+    return false;
+
+  switch (topic) {
+  case WS_WARMSTART_TOPIC_SIGNAL:
+    return tag == wippersnapper_signal_v1_CreateSignalRequest_pin_configs_tag;
+  case WS_WARMSTART_TOPIC_I2C:
+    return tag != wippersnapper_signal_v1_I2CRequest_req_i2c_scan_tag;
+  case WS_WARMSTART_TOPIC_DS18X20:
+    return true; // init and deinit only
+  case WS_WARMSTART_TOPIC_SERVO:
+    return tag != wippersnapper_signal_v1_ServoRequest_servo_write_tag;
+  case WS_WARMSTART_TOPIC_PWM:
+    return tag == wippersnapper_signal_v1_PWMRequest_attach_request_tag ||
+           tag == wippersnapper_signal_v1_PWMRequest_detach_request_tag;
+  case WS_WARMSTART_TOPIC_PIXELS:
+    return tag != wippersnapper_signal_v1_PixelsRequest_req_pixels_write_tag;
+  default:
+    return false;
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief    Creates a new warm-start component.
+*/
+/**************************************************************************/
+ws_warmstart::ws_warmstart() {}
+
+/**************************************************************************/
+/*!
+    @brief    Destructor for the warm-start component.
+*/
+/**************************************************************************/
+ws_warmstart::~ws_warmstart() { freeReplies(); }
+
+/**************************************************************************/
+/*!
+    @brief    Mounts the filesystem holding the snapshot.
+    @returns  True if the filesystem is available, False otherwise.
+*/
+/**************************************************************************/
+bool ws_warmstart::begin() {
+#if defined(USE_TINYUSB)
+  // mounted by Wippersnapper_FS
+  return true;
+#elif defined(USE_LITTLEFS)
+  // WipperSnapper_LittleFS unmounts LittleFS after parsing secrets
+  return LittleFS.begin();
+#else
+  return false;
+#endif
+}
+
+/**************************************************************************/
+/*!
+    @brief    Replays the snapshot from the previous boot.
+    @param    cb
+              Called to apply each message within the snapshot.
+    @param    undoCb
+              Called to tear down the components created by a message
+              within the snapshot, if the broker does not re-send it.
+    @returns  True if a snapshot was restored, False otherwise.
+*/
+/**************************************************************************/
+bool ws_warmstart::restore(ws_warmstart_cb_t cb, ws_warmstart_cb_t undoCb) {
+#if defined(USE_TINYUSB) || defined(USE_LITTLEFS)
+  _undoCb = undoCb;
+  if (!begin())
+    return false;
+  ws_warmstart_file_t file = openFile(WS_WARMSTART_FILE, false);
+  if (!file)
+    return false;
+  _size = file.size();
+  if (_size == 0) {
+    file.close();
+    return false;
+  }
+
+  WS_DEBUG_PRINTLN("Restoring hardware configuration from last boot...");
+  _isReplaying = true;
+  size_t offset = 0;
+  uint8_t topic;
+  uint16_t len;
+  while (offset < _size && readHeader(file, offset, &topic, &len)) {
+    char *data = (char *)malloc(len);
+    if (data == NULL || file.read((uint8_t *)data, len) != len) {
+      free(data);
+      break;
+    }
+    _replayOffset = offset;
+    cb((ws_warmstart_topic_t)topic, data, len);
+    free(data);
+    offset += WS_WARMSTART_HEADER_SIZE + len;
+    WS.feedWDT();
+  }
+  _isReplaying = false;
+  file.close();
+
+  // a truncated snapshot can't be reconciled with the broker, record its
+  // configuration afresh
+  if (offset != _size) {
+    WS_DEBUG_PRINTLN("ERROR: Hardware configuration snapshot is corrupt!");
+    discard();
+    return true;
+  }
+  _isReconciling = true;
+  return true;
+#else
+  (void)cb;
+  (void)undoCb;
+  return false;
+#endif
+}
+
+/**************************************************************************/
+/*!
+    @brief    Ends reconciliation, once the broker has sent the device's
+              configuration. Records the broker did not re-send are torn
+              down and dropped, their replies are never published.
+*/
+/**************************************************************************/
+void ws_warmstart::finish() {
+  if (_isReconciling)
+    rerecord();
+}
+
+/**************************************************************************/
+/*!
+    @brief    Records or reconciles a message received from the broker.
+              Must be called before the message is applied.
+    @param    topic
+              Topic the message was received on.
+    @param    data
+              The message's payload.
+    @param    len
+              Length of the message's payload.
+    @returns  True if the message was already applied from the snapshot
+              and should be skipped, False if it should be applied.
+*/
+/**************************************************************************/
+bool ws_warmstart::sync(ws_warmstart_topic_t topic, char *data,
+                        uint16_t len) {
+  if (_isReplaying || !_isRecording || !isConfiguration(topic, data, len))
+    return false;
+
+  if (_isReconciling) {
+    if (_syncOffset < _size &&
+        compareRecord(_syncOffset, topic, data, len)) {
+      publishReplies(_syncOffset);
+      _syncOffset += WS_WARMSTART_HEADER_SIZE + len;
+      return true;
+    }
+    // the broker's configuration differs, or goes beyond the snapshot
+    rerecord();
+  }
+  appendRecord(topic, data, len);
+  return false;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Stops reconciling the broker's messages with the snapshot.
+              The records the broker re-sent are kept. The rest are torn
+              down and dropped, so the broker's messages can be applied
+              and recorded after them.
+*/
+/**************************************************************************/
+void ws_warmstart::rerecord() {
+  _isReconciling = false;
+  freeReplies();
+  if (_syncOffset == _size)
+    return; // every record was re-sent, carry on appending
+  WS_DEBUG_PRINTLN("Hardware configuration has changed since last boot, "
+                   "re-recording it...");
+  undoRecords(_syncOffset);
+  truncate(_syncOffset);
+}
+
+/**************************************************************************/
+/*!
+    @brief    Tears down the components created by the records at the end
+              of the snapshot, newest first. Records which removed a
+              component are not undone.
+    @param    offset
+              Offset of the first record to tear down.
+*/
+/**************************************************************************/
+void ws_warmstart::undoRecords(size_t offset) {
+#if defined(USE_TINYUSB) || defined(USE_LITTLEFS)
+  if (_undoCb == nullptr)
+    return;
+  ws_warmstart_file_t file = openFile(WS_WARMSTART_FILE, false);
+  if (!file)
+    return;
+
+  // records only link forwards, find where each one starts
+  std::vector<size_t> offsets;
+  uint8_t topic;
+  uint16_t len;
+  while (offset < _size && readHeader(file, offset, &topic, &len)) {
+    offsets.push_back(offset);
+    offset += WS_WARMSTART_HEADER_SIZE + len;
+  }
+
+  for (size_t i = offsets.size(); i > 0; i--) {
+    if (!readHeader(file, offsets[i - 1], &topic, &len))
+      continue;
+    char *data = (char *)malloc(len);
+    if (data == NULL || file.read((uint8_t *)data, len) != len) {
+      free(data);
+      continue;
+    }
+    _undoCb((ws_warmstart_topic_t)topic, data, len);
+    free(data);
+    WS.feedWDT();
+  }
+  file.close();
+#else
+  (void)offset;
+#endif
+}
+
+/**************************************************************************/
+/*!
+    @brief    Holds back a reply published while the snapshot is replayed,
+              the broker is not connected yet. The reply is published once
+              the broker re-sends the message which produced it.
+    @param    topic
+              Topic the reply is published to.
+    @param    payload
+              The reply's payload.
+    @param    len
+              Length of the reply's payload.
+    @param    qos
+              The reply's QoS level.
+    @returns  True if the reply was captured, False if it should be
+              published now.
+*/
+/**************************************************************************/
+bool ws_warmstart::capture(const char *topic, uint8_t *payload, uint16_t len,
+                           uint8_t qos) {
+  if (!_isReplaying)
+    return false;
+  ws_warmstart_reply_t reply = {_replayOffset, topic, (uint8_t *)malloc(len),
+                                len, qos};
+  // drop the reply, the broker can not be told about it anyways
+  if (reply.payload == NULL)
+    return true;
+  memcpy(reply.payload, payload, len);
+  _replies.push_back(reply);
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Publishes the replies captured while replaying a record.
+    @param    offset
+              Offset of the record within the snapshot.
+*/
+/**************************************************************************/
+void ws_warmstart::publishReplies(size_t offset) {
+  for (size_t i = 0; i < _replies.size(); i++) {
+    if (_replies[i].offset != offset)
+      continue;
+    WS.publish(_replies[i].topic, _replies[i].payload, _replies[i].len,
+               _replies[i].qos);
+    free(_replies[i].payload);
+    _replies[i].payload = NULL;
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief    Frees the replies captured while replaying the snapshot.
+*/
+/**************************************************************************/
+void ws_warmstart::freeReplies() {
+  for (size_t i = 0; i < _replies.size(); i++)
+    free(_replies[i].payload);
+  _replies.clear();
+}
+
+/**************************************************************************/
+/*!
+    @brief    Checks if a message matches a record within the snapshot.
+    @param    offset
+              Offset of the record within the snapshot.
+    @param    topic
+              Topic the message was received on.
+    @param    data
+              The message's payload.
+    @param    len
+              Length of the message's payload.
+    @returns  True if the message matches the record, False otherwise.
+*/
+/**************************************************************************/
+bool ws_warmstart::compareRecord(size_t offset, ws_warmstart_topic_t topic,
+                                 char *data, uint16_t len) {
+#if defined(USE_TINYUSB) || defined(USE_LITTLEFS)
+  ws_warmstart_file_t file = openFile(WS_WARMSTART_FILE, false);
+  if (!file)
+    return false;
+
+  uint8_t recordTopic;
+  uint16_t recordLen;
+  bool isMatch = readHeader(file, offset, &recordTopic, &recordLen) &&
+                 recordTopic == topic && recordLen == len;
+  // compare the payload in chunks
+  uint8_t chunk[32];
+  for (uint16_t i = 0; isMatch && i < len; i += sizeof(chunk)) {
+    uint16_t chunkLen = min((uint16_t)sizeof(chunk), (uint16_t)(len - i));
+    isMatch = file.read(chunk, chunkLen) == chunkLen &&
+              memcmp(chunk, data + i, chunkLen) == 0;
+  }
+  file.close();
+  return isMatch;
+#else
+  return false;
+#endif
+}
+
+/**************************************************************************/
+/*!
+    @brief    Appends a message to the snapshot.
+    @param    topic
+              Topic the message was received on.
+    @param    data
+              The message's payload.
+    @param    len
+              Length of the message's payload.
+    @returns  True if the message was recorded, False otherwise.
+*/
+/**************************************************************************/
+bool ws_warmstart::appendRecord(ws_warmstart_topic_t topic, char *data,
+                                uint16_t len) {
+#if defined(USE_TINYUSB) || defined(USE_LITTLEFS)
+  if (!begin())
+    return false;
+
+  // an incomplete snapshot is useless, stop recording
+  if (_size + WS_WARMSTART_HEADER_SIZE + len > WS_WARMSTART_MAX_SIZE) {
+    WS_DEBUG_PRINTLN("ERROR: Hardware configuration too large to snapshot!");
+    discard();
+    _isRecording = false;
+    return false;
+  }
+
+  // start a new snapshot
+  if (_size == 0)
+    discard();
+
+  ws_warmstart_file_t file = openFile(WS_WARMSTART_FILE, true);
+  if (!file)
+    return false;
+  uint8_t header[WS_WARMSTART_HEADER_SIZE] = {(uint8_t)topic,
+                                              (uint8_t)(len & 0xFF),
+                                              (uint8_t)(len >> 8)};
+  bool is_success = file.write(header, sizeof(header)) == sizeof(header) &&
+                    file.write((uint8_t *)data, len) == len;
+  file.flush();
+  file.close();
+  if (!is_success) {
+    discard();
+    _isRecording = false;
+    return false;
+  }
+  _size += WS_WARMSTART_HEADER_SIZE + len;
+  return true;
+#else
+  return false;
+#endif
+}
+
+/**************************************************************************/
+/*!
+    @brief    Drops the end of the snapshot, by copying its start to a new
+              file which replaces it.
+    @param    size
+              Number of bytes of the snapshot to keep.
+    @returns  True if the snapshot was truncated, False if it had to be
+              discarded instead.
+*/
+/**************************************************************************/
+bool ws_warmstart::truncate(size_t size) {
+#if defined(USE_TINYUSB) || defined(USE_LITTLEFS)
+  if (size == 0 || !begin()) {
+    discard();
+    return size == 0;
+  }
+
+  removeFile(WS_WARMSTART_TEMP_FILE);
+  ws_warmstart_file_t file = openFile(WS_WARMSTART_FILE, false);
+  ws_warmstart_file_t temp = openFile(WS_WARMSTART_TEMP_FILE, true);
+  bool is_success = file && temp;
+  // copy in chunks
+  uint8_t chunk[32];
+  for (size_t i = 0; is_success && i < size; i += sizeof(chunk)) {
+    size_t chunkLen = min(sizeof(chunk), size - i);
+    is_success = file.read(chunk, chunkLen) == (int)chunkLen &&
+                 temp.write(chunk, chunkLen) == chunkLen;
+  }
+  if (file)
+    file.close();
+  if (temp) {
+    temp.flush();
+    temp.close();
+  }
+  is_success = is_success && removeFile(WS_WARMSTART_FILE) &&
+               renameFile(WS_WARMSTART_TEMP_FILE, WS_WARMSTART_FILE);
+  if (!is_success) {
+    removeFile(WS_WARMSTART_TEMP_FILE);
+    discard();
+    return false;
+  }
+  _size = size;
+  return true;
+#else
+  (void)size;
+  return false;
+#endif
+}
+
+/**************************************************************************/
+/*!
+    @brief    Deletes the snapshot.
+*/
+/**************************************************************************/
+void ws_warmstart::discard() {
+#if defined(USE_TINYUSB) || defined(USE_LITTLEFS)
+  removeFile(WS_WARMSTART_FILE);
+#endif
+  _size = 0;
+  freeReplies();
+}
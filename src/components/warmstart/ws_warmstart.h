@@ -0,0 +1,107 @@
+/*!
+ * @file ws_warmstart.h
+ *
+ * Persists the hardware configuration sent by the broker so it can be
+ * restored as soon as the device boots, before it has connected to
+ * Adafruit IO.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * Copyright (c) Brent Rubell 2023 for Adafruit Industries.
+ *
+ * MIT license, all text here must be included in any redistribution.
+ *
+ */
+#ifndef WS_WARMSTART_H
+#define WS_WARMSTART_H
+
+#include "Wippersnapper.h"
+
+#define WS_WARMSTART_FILE                                                      \
+  "/wipper_config.bin" ///< Configuration snapshot, on the filesystem
+#define WS_WARMSTART_TEMP_FILE                                                 \
+  "/wipper_config.tmp" ///< Snapshot being rewritten, on the filesystem
+#define WS_WARMSTART_MAX_SIZE                                                  \
+  4096 ///< Maximum size of the configuration snapshot, in bytes
+
+/** Topics whose messages are stored in the configuration snapshot */
+typedef enum ws_warmstart_topic_t {
+  WS_WARMSTART_TOPIC_SIGNAL,  ///< Signal topic (pin configuration)
+  WS_WARMSTART_TOPIC_I2C,     ///< I2C topic
+  WS_WARMSTART_TOPIC_DS18X20, ///< DS18x20 topic
+  WS_WARMSTART_TOPIC_SERVO,   ///< Servo topic
+  WS_WARMSTART_TOPIC_PWM,     ///< PWM topic
+  WS_WARMSTART_TOPIC_PIXELS,  ///< Pixels topic
+} ws_warmstart_topic_t;
+
+/** Applies, or undoes, a message from the snapshot on its component */
+typedef void (*ws_warmstart_cb_t)(ws_warmstart_topic_t topic, char *data,
+                                  uint16_t len);
+
+/** Reply published while a record from the snapshot was replayed */
+struct ws_warmstart_reply_t {
+  size_t offset;     ///< Offset of the record which produced the reply
+  const char *topic; ///< Topic the reply is published to
+  uint8_t *payload;  ///< The reply's payload
+  uint16_t len;      ///< Length of the reply's payload
+  uint8_t qos;       ///< The reply's QoS level
+};
+
+class Wippersnapper;
+
+/**************************************************************************/
+/*!
+    @brief  Records the configuration messages the broker sends, as raw
+            protobuf, and replays them on the next boot. Commands such as
+            pin writes are not configuration and are never recorded.
+
+            After a boot, each configuration message the broker sends is
+            checked against the next record of the snapshot. Messages
+            which were already applied from the snapshot are skipped and
+            the replies they produced during the replay are published
+            instead. From the first message which differs, or once the
+            broker has sent the device's configuration, the components
+            created by records which were not re-sent are torn down and
+            those records are dropped. The broker's messages are then
+            applied and recorded in their place.
+*/
+/**************************************************************************/
+class ws_warmstart {
+public:
+  ws_warmstart();
+  ~ws_warmstart();
+
+  bool restore(ws_warmstart_cb_t cb, ws_warmstart_cb_t undoCb);
+  void finish();
+  bool sync(ws_warmstart_topic_t topic, char *data, uint16_t len);
+  bool capture(const char *topic, uint8_t *payload, uint16_t len,
+               uint8_t qos);
+
+private:
+  bool begin();
+  bool compareRecord(size_t offset, ws_warmstart_topic_t topic, char *data,
+                     uint16_t len);
+  bool appendRecord(ws_warmstart_topic_t topic, char *data, uint16_t len);
+  bool truncate(size_t size);
+  void rerecord();
+  void undoRecords(size_t offset);
+  void publishReplies(size_t offset);
+  void freeReplies();
+  void discard();
+
+  bool _isRecording = true;    ///< False if the snapshot could not be written
+  bool _isReconciling = false; ///< True while matching the broker's messages
+                               ///< against the snapshot replayed on boot
+  bool _isReplaying = false;   ///< True while replaying the snapshot
+  size_t _syncOffset = 0;      ///< Offset of the next record to compare to
+  size_t _size = 0;            ///< Size of the snapshot, in bytes
+  size_t _replayOffset = 0;    ///< Offset of the record being replayed
+  std::vector<ws_warmstart_reply_t>
+      _replies; ///< Replies captured while replaying the snapshot
+  ws_warmstart_cb_t _undoCb = nullptr; ///< Tears down a replayed record
+};
+extern Wippersnapper WS;
+
+#endif // WS_WARMSTART_H
@@ -91,7 +91,7 @@ void ws_display_driver::setResolution(uint16_t displayWidth,
 bool ws_display_driver::begin() {
   // initialize display driver
   if (_tft_st7789 != nullptr) {
-    WS_DEBUG_PRINTLN("Initialize ST7789 driver");
+    WS_LOG_INFO(DISPLAY, "Initialize ST7789 driver");
     _tft_st7789->init(_displayWidth, _displayHeight);
   } else {
     Serial.println("ERROR: Unable to initialize the display driver!");
@@ -105,11 +105,10 @@ bool ws_display_driver::begin() {
 #endif // ARDUINO_FUNHOUSE_ESP32S2
 
   // initialize lvgl_glue
-  WS_DEBUG_PRINTLN("Initialize LVGL");
+  WS_LOG_INFO(DISPLAY, "Initialize LVGL");
   _glue = new Adafruit_LvGL_Glue();
   LvGLStatus status = _glue->begin(_tft_st7789);
-  WS_DEBUG_PRINT("LVGL RC: ");
-  WS_DEBUG_PRINTLN((int)status);
+  WS_LOG_INFO(DISPLAY, "LVGL RC: %d", (int)status);
 
   // check if lvgl initialized correctly
   if (status != LVGL_OK) {
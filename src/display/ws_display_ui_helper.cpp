@@ -400,6 +400,7 @@ void ws_display_ui_helper::build_scr_monitor() {
 */
 /**************************************************************************/
 void ws_display_ui_helper::add_text_to_terminal(const char *text) {
+  WS_TRACE_SCOPE(WS_TRACE_EVENT_DISPLAY);
   Serial.println("add_text_to_terminal");
   char txtBuffer[256]; // temporary text buffer for snprintf
   snprintf(txtBuffer, 256, text);
@@ -226,6 +226,23 @@ public:
     }
   }
 
+  /*******************************************************************/
+  /*!
+  @brief  Returns the number of bytes waiting to be read from the MQTT
+          client's socket, without blocking.
+  @return Number of bytes available.
+  */
+  /*******************************************************************/
+  int mqttAvailable() { return _mqtt_client->available(); }
+
+  /*******************************************************************/
+  /*!
+  @brief  Returns the MQTT client's socket.
+  @return The socket.
+  */
+  /*******************************************************************/
+  Client *mqttClient() { return _mqtt_client; }
+
   /*******************************************************************/
   /*!
   @brief  Returns the type of network connection used by Wippersnapper
@@ -24,8 +24,12 @@
 #include "Adafruit_MQTT_Client.h"
 #include "Arduino.h"
 #include <WiFiClientSecure.h>
+#include <esp_attr.h>
 extern Wippersnapper WS;
 
+RTC_NOINIT_ATTR static ws_net_cache_t
+    _rtcNetCache; ///< Last access point, kept across soft resets
+
 /****************************************************************************/
 /*!
     @brief  Class for using the ESP32 network interface.
@@ -125,6 +129,48 @@ public:
     return false;
   }
 
+  /***********************************************************/
+  /*!
+  @brief   Rejoins the access point of the last successful
+           connection, without scanning for WiFi networks.
+  @returns True if connected, False otherwise.
+  */
+  /***********************************************************/
+  bool fastConnect() {
+    if (_rtcNetCache.magic != WS_NET_CACHE_MAGIC || strlen(_ssid) == 0 ||
+        strncmp(_rtcNetCache.ssid, _ssid, sizeof(_rtcNetCache.ssid)) != 0)
+      return false;
+
+    WS_DEBUG_PRINTLN("Rejoining last WiFi access point...");
+    WiFi.mode(WIFI_STA);
+    WiFi.begin(_ssid, _pass, _rtcNetCache.channel, _rtcNetCache.bssid);
+    unsigned long connectStart = millis();
+    while (WiFi.status() != WL_CONNECTED &&
+           millis() - connectStart < WS_NET_FAST_CONNECT_TIMEOUT_MS)
+      delay(10);
+    if (WiFi.status() == WL_CONNECTED)
+      return true;
+
+    // access point is gone or has moved, fall back to a full scan
+    _rtcNetCache.magic = 0;
+    _disconnect();
+    return false;
+  }
+
+  /***********************************************************/
+  /*!
+  @brief   Stores the access point the ESP32 is connected to
+           in RTC memory, so fastConnect() can rejoin it.
+  */
+  /***********************************************************/
+  void cacheNetwork() {
+    _rtcNetCache.channel = WiFi.channel();
+    memcpy(_rtcNetCache.bssid, WiFi.BSSID(), sizeof(_rtcNetCache.bssid));
+    strncpy(_rtcNetCache.ssid, _ssid, sizeof(_rtcNetCache.ssid) - 1);
+    _rtcNetCache.ssid[sizeof(_rtcNetCache.ssid) - 1] = '\0';
+    _rtcNetCache.magic = WS_NET_CACHE_MAGIC;
+  }
+
   /********************************************************/
   /*!
   @brief  Sets the ESP32's unique client identifier
@@ -171,6 +217,23 @@ public:
     }
   }
 
+  /*******************************************************************/
+  /*!
+  @brief  Returns the number of bytes waiting to be read from the MQTT
+          client's socket, without blocking.
+  @return Number of bytes available.
+  */
+  /*******************************************************************/
+  int mqttAvailable() { return _mqtt_client->available(); }
+
+  /*******************************************************************/
+  /*!
+  @brief  Returns the MQTT client's socket.
+  @return The socket.
+  */
+  /*******************************************************************/
+  Client *mqttClient() { return _mqtt_client; }
+
   /*******************************************************************/
   /*!
   @brief  Returns the type of network connection used by Wippersnapper
@@ -36,6 +36,10 @@
 // static const char *fingerprint PROGMEM =  "4E C1 52 73 24 A8 36 D6 7A 4C 67
 // C7 91 0C 0A 22 B9 2D 5B CA";
 
+#define WS_NET_CACHE_RTC_OFFSET                                                \
+  32 ///< RTC user memory block holding the ws_net_cache_t, the first 128
+     ///< bytes are reserved for OTA updates
+
 extern Wippersnapper WS;
 
 /******************************************************************************/
@@ -149,6 +153,58 @@ public:
     return false;
   }
 
+  /***********************************************************/
+  /*!
+  @brief   Rejoins the access point of the last successful
+           connection, without scanning for WiFi networks.
+  @returns True if connected, False otherwise.
+  */
+  /***********************************************************/
+  bool fastConnect() {
+    ws_net_cache_t cache;
+    if (!ESP.rtcUserMemoryRead(WS_NET_CACHE_RTC_OFFSET, (uint32_t *)&cache,
+                               sizeof(cache)) ||
+        cache.magic != WS_NET_CACHE_MAGIC || strlen(_ssid) == 0 ||
+        strncmp(cache.ssid, _ssid, sizeof(cache.ssid)) != 0)
+      return false;
+
+    WS_DEBUG_PRINTLN("Rejoining last WiFi access point...");
+    WiFi.mode(WIFI_STA);
+    WiFi.begin(_ssid, _pass, cache.channel, cache.bssid);
+    unsigned long connectStart = millis();
+    while (WiFi.status() != WL_CONNECTED &&
+           millis() - connectStart < WS_NET_FAST_CONNECT_TIMEOUT_MS) {
+      // ESP8266 WDT requires yield() during a busy-loop so it doesn't bite
+      yield();
+    }
+    if (WiFi.status() == WL_CONNECTED)
+      return true;
+
+    // access point is gone or has moved, fall back to a full scan
+    cache.magic = 0;
+    ESP.rtcUserMemoryWrite(WS_NET_CACHE_RTC_OFFSET, (uint32_t *)&cache,
+                           sizeof(cache));
+    _disconnect();
+    return false;
+  }
+
+  /***********************************************************/
+  /*!
+  @brief   Stores the access point the ESP8266 is connected to
+           in RTC user memory, so fastConnect() can rejoin it.
+  */
+  /***********************************************************/
+  void cacheNetwork() {
+    ws_net_cache_t cache;
+    cache.magic = WS_NET_CACHE_MAGIC;
+    cache.channel = WiFi.channel();
+    memcpy(cache.bssid, WiFi.BSSID(), sizeof(cache.bssid));
+    strncpy(cache.ssid, _ssid, sizeof(cache.ssid) - 1);
+    cache.ssid[sizeof(cache.ssid) - 1] = '\0';
+    ESP.rtcUserMemoryWrite(WS_NET_CACHE_RTC_OFFSET, (uint32_t *)&cache,
+                           sizeof(cache));
+  }
+
   /********************************************************/
   /*!
   @brief  Gets the ESP8266's unique client identifier.
@@ -203,6 +259,23 @@ public:
     }
   }
 
+  /*******************************************************************/
+  /*!
+  @brief  Returns the number of bytes waiting to be read from the MQTT
+          client's socket, without blocking.
+  @return Number of bytes available.
+  */
+  /*******************************************************************/
+  int mqttAvailable() { return _wifi_client->available(); }
+
+  /*******************************************************************/
+  /*!
+  @brief  Returns the MQTT client's socket.
+  @return The socket.
+  */
+  /*******************************************************************/
+  Client *mqttClient() { return _wifi_client; }
+
   /*******************************************************************/
   /*!
   @brief  Returns the type of network connection used by Wippersnapper
@@ -24,6 +24,13 @@
 #include "Adafruit_MQTT_Client.h"
 #include "Arduino.h"
 #include <WiFiClientSecure.h>
+
+#define WS_TLS_DEFAULT_RX_BUFFER_SIZE                                          \
+  16384 ///< BearSSL's default TLS receive buffer, in bytes
+#define WS_TLS_TX_BUFFER_SIZE 512 ///< TLS transmit buffer, in bytes
+#define WS_PICO_WIFI_TIMEOUT_MS                                                \
+  10000 ///< arduino-pico's default WiFi.begin() timeout, in ms
+
 extern Wippersnapper WS;
 
 /****************************************************************************/
@@ -125,6 +132,49 @@ public:
     return false;
   }
 
+  /***********************************************************/
+  /*!
+  @brief   Rejoins the access point of the last successful
+           connection, without scanning for WiFi networks.
+  @returns True if connected, False otherwise.
+  */
+  /***********************************************************/
+  bool fastConnect() {
+    if (_netCache.magic != WS_NET_CACHE_MAGIC || strlen(_ssid) == 0 ||
+        strncmp(_netCache.ssid, _ssid, sizeof(_netCache.ssid)) != 0)
+      return false;
+
+    WS_DEBUG_PRINTLN("Rejoining last WiFi access point...");
+    WiFi.mode(WIFI_STA);
+    // WiFi has no getter for its timeout, so the core's default is
+    // restored afterwards for the full connection's WiFi.begin()
+    WiFi.setTimeout(WS_NET_FAST_CONNECT_TIMEOUT_MS);
+    bool isConnected =
+        WiFi.beginBSSID(_ssid, _pass, _netCache.bssid) == WL_CONNECTED;
+    WiFi.setTimeout(WS_PICO_WIFI_TIMEOUT_MS);
+    if (isConnected)
+      return true;
+
+    // access point is gone or has moved, fall back to a full scan
+    _netCache.magic = 0;
+    _disconnect();
+    return false;
+  }
+
+  /***********************************************************/
+  /*!
+  @brief   Stores the access point the RPi Pico is connected
+           to, so fastConnect() can rejoin it.
+  */
+  /***********************************************************/
+  void cacheNetwork() {
+    _netCache.channel = WiFi.channel();
+    WiFi.BSSID(_netCache.bssid);
+    strncpy(_netCache.ssid, _ssid, sizeof(_netCache.ssid) - 1);
+    _netCache.ssid[sizeof(_netCache.ssid) - 1] = '\0';
+    _netCache.magic = WS_NET_CACHE_MAGIC;
+  }
+
   /********************************************************/
   /*!
   @brief  Sets the RPi Pico's unique client identifier
@@ -151,12 +201,47 @@ public:
     } else {
       _mqtt_client->setCACert(_aio_root_ca_staging);
     }
+    // resume the TLS session on reconnect instead of a full handshake
+    _mqtt_client->setSession(&_tlsSession);
 
     WS._mqtt =
         new Adafruit_MQTT_Client(_mqtt_client, WS._mqttBrokerURL, WS._mqtt_port,
                                  clientID, WS._username, WS._key);
   }
 
+  /***********************************************************/
+  /*!
+  @brief   Negotiates a smaller TLS record size with the MQTT
+           broker, shrinking BearSSL's 16kB receive buffer.
+           Falls back to the default buffers if the broker
+           refuses every size.
+  */
+  /***********************************************************/
+  void setupTLSBuffers() {
+    if (_isTLSBufferSet)
+      return;
+    _isTLSBufferSet = true;
+
+    // MQTT payloads never exceed WS_MQTT_MAX_PAYLOAD_SIZE, larger packets
+    // are split across several records
+    static const uint16_t fragmentLens[] = {512, 1024};
+    for (size_t i = 0; i < sizeof(fragmentLens) / sizeof(fragmentLens[0]);
+         i++) {
+      if (!_mqtt_client->probeMaxFragmentLength(
+              WS._mqttBrokerURL, WS._mqtt_port, fragmentLens[i]))
+        continue;
+      _mqtt_client->setBufferSizes(fragmentLens[i], WS_TLS_TX_BUFFER_SIZE);
+      WS_DEBUG_PRINT("TLS max. fragment length: ");
+      WS_DEBUG_PRINT(fragmentLens[i]);
+      WS_DEBUG_PRINT(" bytes, heap saved: ");
+      WS_DEBUG_PRINT(WS_TLS_DEFAULT_RX_BUFFER_SIZE - fragmentLens[i]);
+      WS_DEBUG_PRINTLN(" bytes");
+      return;
+    }
+    WS_DEBUG_PRINTLN("Broker refused TLS max. fragment length negotiation, "
+                     "using default TLS buffers");
+  }
+
   /********************************************************/
   /*!
   @brief  Returns the network status of an RPi Pico.
@@ -176,6 +261,23 @@ public:
     }
   }
 
+  /*******************************************************************/
+  /*!
+  @brief  Returns the number of bytes waiting to be read from the MQTT
+          client's socket, without blocking.
+  @return Number of bytes available.
+  */
+  /*******************************************************************/
+  int mqttAvailable() { return _mqtt_client->available(); }
+
+  /*******************************************************************/
+  /*!
+  @brief  Returns the MQTT client's socket.
+  @return The socket.
+  */
+  /*******************************************************************/
+  Client *mqttClient() { return _mqtt_client; }
+
   /*******************************************************************/
   /*!
   @brief  Returns the type of network connection used by Wippersnapper
@@ -189,6 +291,10 @@ protected:
   const char *_pass;              ///< WiFi password
   const char *_mqttBrokerURL;     ///< MQTT broker URL
   WiFiClientSecure *_mqtt_client; ///< Pointer to a secure MQTT client object
+  BearSSL::Session _tlsSession;   ///< TLS session kept across reconnects
+  bool _isTLSBufferSet = false;   ///< True once the TLS buffers are sized
+  ws_net_cache_t _netCache = {0}; ///< Last access point, RAM only as the
+                                  ///< RP2040 has no retained memory
 
   const char *_aio_root_ca_staging =
       "-----BEGIN CERTIFICATE-----\n"
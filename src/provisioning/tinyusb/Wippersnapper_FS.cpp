@@ -453,7 +453,7 @@ void Wippersnapper_FS::writeToBootOut(PGM_P str) {
     bootFile.flush();
     bootFile.close();
   } else {
-    WS_DEBUG_PRINTLN("ERROR: Unable to open wipper_boot_out.txt for logging!");
+    WS_LOG_ERROR(FS, "ERROR: Unable to open wipper_boot_out.txt for logging!");
   }
 }
 
@@ -502,7 +502,7 @@ void Wippersnapper_FS::parseDisplayConfig(displayConfig &displayFile) {
   DeserializationError error;
 
   if (!wipperFatFs.exists("/display_config.json")) {
-    WS_DEBUG_PRINTLN("Could not find display_config.json, generating...");
+    WS_LOG_INFO(FS, "Could not find display_config.json, generating...");
 #ifdef ARDUINO_FUNHOUSE_ESP32S2
     createDisplayConfig();
 #endif
@@ -534,11 +534,11 @@ void Wippersnapper_FS::parseDisplayConfig(displayConfig &displayFile) {
     displayFile.pinSCK = doc["spi"]["pinSck"];
     displayFile.pinRST = doc["spi"]["pinRst"];
   } else if (doc["i2c"] != nullptr) {
-    WS_DEBUG_PRINTLN("I2C display drivers are not implemented yet!");
+    WS_LOG_WARN(FS, "I2C display drivers are not implemented yet!");
     // TODO: Halt?
   } else {
-    WS_DEBUG_PRINTLN(
-        "ERROR: Display device lacks a hardware interface, failing out...");
+    WS_LOG_ERROR(
+        FS, "ERROR: Display device lacks a hardware interface, failing out...");
     // TODO: Halt?
   }
 }
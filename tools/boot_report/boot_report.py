@@ -0,0 +1,89 @@
+#!/usr/bin/env python3
+"""Compares WipperSnapper boot reports, to catch boot time regressions.
+
+A device prints its boot report to the serial console once connected,
+and publishes the same JSON object to its diagnostics topic:
+
+  Boot report: {"boot":8412,"stages":{"core":312,"led":4,...}}
+
+Each input is a serial log, or a file holding boot report JSON objects,
+one per line. Several boots in one input are averaged per stage.
+
+Usage:
+  python3 boot_report.py baseline.log
+  python3 boot_report.py baseline.log candidate.log --threshold 10
+"""
+
+import argparse
+import json
+import sys
+
+PREFIX = "Boot report: "
+
+
+def load(path):
+    """Returns the boot reports found in a serial log or JSON file."""
+    reports = []
+    with open(path, errors="replace") as f:
+        for line in f:
+            line = line.strip()
+            if PREFIX in line:
+                line = line.split(PREFIX, 1)[1]
+            if not line.startswith("{"):
+                continue
+            try:
+                report = json.loads(line)
+            except ValueError:
+                continue
+            if "stages" in report:
+                reports.append(report)
+    if not reports:
+        sys.exit("%s: no boot reports found" % path)
+    return reports
+
+
+def average(reports):
+    """Averages the total and per-stage boot times, in ms."""
+    stages = {}
+    for report in reports:
+        for name, ms in report["stages"].items():
+            stages.setdefault(name, []).append(ms)
+    total = sum(r["boot"] for r in reports) / len(reports)
+    return total, {name: sum(v) / len(v) for name, v in stages.items()}
+
+
+def main():
+    p = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    p.add_argument("baseline")
+    p.add_argument("candidate", nargs="?")
+    p.add_argument("--threshold", type=float, default=10,
+                   help="regression threshold, in percent")
+    p.add_argument("--min-ms", type=float, default=50,
+                   help="ignore regressions smaller than this, in ms")
+    args = p.parse_args()
+
+    base_total, base = average(load(args.baseline))
+    if not args.candidate:
+        for name, ms in base.items():
+            print("%-10s %8.0f ms %5.1f%%" % (name, ms, 100 * ms / base_total))
+        print("%-10s %8.0f ms" % ("total", base_total))
+        return 0
+
+    cand_total, cand = average(load(args.candidate))
+    regressed = []
+    print("%-10s %10s %10s %10s" % ("stage", "baseline", "candidate", "delta"))
+    for name in list(base) + [n for n in cand if n not in base]:
+        b, c = base.get(name, 0), cand.get(name, 0)
+        delta = c - b
+        flag = ""
+        if delta >= args.min_ms and (b == 0 or 100 * delta / b >= args.threshold):
+            flag = "  REGRESSED"
+            regressed.append(name)
+        print("%-10s %8.0f ms %8.0f ms %+8.0f ms%s" % (name, b, c, delta, flag))
+    print("%-10s %8.0f ms %8.0f ms %+8.0f ms" % (
+        "total", base_total, cand_total, cand_total - base_total))
+    return 1 if regressed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
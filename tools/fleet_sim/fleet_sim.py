@@ -0,0 +1,243 @@
+#!/usr/bin/env python3
+"""Virtual-time fleet simulator for WipperSnapper's publish scheduling.
+
+Models a fleet of devices sharing one MQTT broker and reports the load
+the broker sees. The firmware itself can not be built for the host, so
+each device is a model of the policies in src/:
+
+  * Reconnects follow runNetFSM(): up to 5 MQTT connect attempts,
+    3 s apart, after the broker goes away.
+  * Periodic inputs are configured once the device reconnects. With
+    --phase, the first reading is delayed by the device's phase within
+    the period, using the same FNV-1a hash of the device UID as
+    Wippersnapper::getPublishPhase().
+  * With --budget, publishes spend tokens from the same bucket as
+    ws_mqtt_budget, periodic readings are deferred while it runs low.
+  * The broker serves a fixed number of messages and connects per
+    second, extra work queues up and is reported as latency.
+
+Usage:
+  python3 fleet_sim.py --devices 1000 --period 30 --restart-at 120
+  python3 fleet_sim.py --devices 1000 --period 30 --restart-at 120 --phase
+"""
+
+import argparse
+import heapq
+import random
+import statistics
+from collections import Counter
+
+MQTT_CONNECT_ATTEMPTS = 5  # runNetFSM(), FSM_NET_ESTABLISH_MQTT
+MQTT_CONNECT_RETRY_S = 3.0
+BUDGET_BURST = 5  # WS_PUBLISH_BUDGET_BURST
+BUDGET_RESERVE = 2  # WS_PUBLISH_BUDGET_RESERVE
+
+
+def publish_phase(device_uid):
+    """Mirrors Wippersnapper::getPublishPhase(), in 1/65536ths."""
+    h = 2166136261
+    for c in device_uid.encode():
+        h ^= c
+        h = (h * 16777619) & 0xFFFFFFFF
+    return (h ^ (h >> 16)) & 0xFFFF
+
+
+class Bucket:
+    """Mirrors ws_mqtt_budget's token bucket, in the firmware's integer
+    milli-tokens and milliseconds."""
+
+    def __init__(self, per_min):
+        self.rate = max(per_min - BUDGET_BURST, 1)  # tokens per minute
+        self.milli_tokens = BUDGET_BURST * 1000
+        self.prv = 0  # ms
+
+    def refill(self, now):
+        cur = int(now * 1000)
+        self.prv = max(self.prv, cur - 60000)
+        earned = (cur - self.prv) * self.rate // 60
+        self.milli_tokens = min(self.milli_tokens + earned,
+                                BUDGET_BURST * 1000)
+        self.prv += earned * 60 // self.rate
+
+    def available(self, now, reserve):
+        self.refill(now)
+        return self.milli_tokens >= (1 + reserve) * 1000
+
+    def consume(self, now):
+        self.refill(now)
+        self.milli_tokens = max(self.milli_tokens - 1000, 0)
+
+
+class Broker:
+    """Serves messages and connects first-come first-served."""
+
+    def __init__(self, msg_rate, connect_rate):
+        self.msg_rate = msg_rate
+        self.connect_rate = connect_rate
+        self.msg_free_at = 0.0
+        self.connect_free_at = 0.0
+        self.down_until = 0.0
+
+    def serve(self, now, rate, free_at):
+        start = max(now, free_at)
+        return start + 1.0 / rate
+
+    def publish(self, now):
+        self.msg_free_at = self.serve(now, self.msg_rate, self.msg_free_at)
+        return self.msg_free_at
+
+    def connect(self, now, timeout):
+        if now < self.down_until:
+            return None
+        done = self.serve(now, self.connect_rate, self.connect_free_at)
+        if done - now > timeout:
+            return None  # CONNACK did not arrive in time
+        self.connect_free_at = done
+        return done
+
+
+def percentile(values, pct):
+    if not values:
+        return 0
+    values = sorted(values)
+    return values[min(len(values) - 1, int(len(values) * pct / 100))]
+
+
+def simulate(args):
+    rng = random.Random(args.seed)
+    broker = Broker(args.broker_msg_rate, args.broker_connect_rate)
+    events = []  # (time, seq, kind, device)
+    seq = 0
+
+    def push(t, kind, dev):
+        nonlocal seq
+        heapq.heappush(events, (t, seq, kind, dev))
+        seq += 1
+
+    devices = []
+    for i in range(args.devices):
+        mac = "%d%d%d" % (rng.randrange(256), rng.randrange(256), rng.randrange(256))
+        uid = "io-wipper-" + args.board + mac
+        dev = {
+            "uid": uid,
+            "phase": publish_phase(uid),
+            "bucket": Bucket(args.budget) if args.budget else None,
+            "attempts": 0,
+            "epoch": 0,  # invalidates readings scheduled before a disconnect
+        }
+        devices.append(dev)
+        # devices power up over the first few seconds
+        push(rng.uniform(0, args.boot_spread), "connect", i)
+
+    if args.restart_at:
+        push(args.restart_at, "restart", None)
+
+    msgs_per_s = Counter()
+    connects_per_s = Counter()
+    latencies = []
+    deferred = 0
+    failed = 0
+
+    while events:
+        now, _, kind, i = heapq.heappop(events)
+        if now > args.duration:
+            break
+        if kind == "restart":
+            broker.down_until = now + args.restart_downtime
+            for d_i, dev in enumerate(devices):
+                dev["epoch"] += 1
+                dev["attempts"] = 0
+                # each device notices at its next keepalive ping
+                push(now + rng.uniform(0, args.keepalive), "connect", d_i)
+            continue
+
+        dev = devices[i]
+        if kind == "connect":
+            connects_per_s[int(now)] += 1
+            connack = broker.connect(now, MQTT_CONNECT_RETRY_S)
+            if connack is None:
+                dev["attempts"] += 1
+                if dev["attempts"] >= MQTT_CONNECT_ATTEMPTS:
+                    # haltError() lets the WDT reset the device
+                    dev["attempts"] = 0
+                    failed += 1
+                    push(now + args.reboot_s, "connect", i)
+                else:
+                    push(now + MQTT_CONNECT_RETRY_S, "connect", i)
+                continue
+            dev["attempts"] = 0
+            configured = connack + args.config_s
+            period = args.period
+            first = configured
+            if args.phase:
+                first += period * dev["phase"] / 65536.0
+            for _ in range(args.inputs):
+                push(first, ("read", dev["epoch"]), i)
+            continue
+
+        _, epoch = kind
+        if epoch != dev["epoch"]:
+            continue  # scheduled before the device lost its connection
+        bucket = dev["bucket"]
+        if bucket and not bucket.available(now, BUDGET_RESERVE):
+            deferred += 1
+            push(now + 1.0, kind, i)  # retried on a later loop
+            continue
+        if bucket:
+            bucket.consume(now)
+        done = broker.publish(now)
+        msgs_per_s[int(done)] += 1
+        latencies.append(done - now)
+        push(now + args.period, kind, i)
+
+    # ignore the boot storm, the interesting part is steady state and restarts
+    seconds = range(int(args.boot_spread) + args.period, int(args.duration))
+    rates = [msgs_per_s.get(s, 0) for s in seconds]
+    return {
+        "rates": rates,
+        "connect_peak": max(connects_per_s.values() or [0]),
+        "connect_storm_s": sum(1 for c in connects_per_s.values() if c > args.broker_connect_rate),
+        "latencies": latencies,
+        "deferred": deferred,
+        "failed": failed,
+    }
+
+
+def main():
+    p = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    p.add_argument("--devices", type=int, default=500)
+    p.add_argument("--inputs", type=int, default=2, help="periodic inputs per device")
+    p.add_argument("--period", type=int, default=30, help="sampling period, in s")
+    p.add_argument("--duration", type=float, default=600, help="simulated time, in s")
+    p.add_argument("--phase", action="store_true", help="stagger readings by UID phase")
+    p.add_argument("--budget", type=int, default=0, help="publishes per minute, 0 disables")
+    p.add_argument("--restart-at", type=float, default=0, help="broker restart time, in s")
+    p.add_argument("--restart-downtime", type=float, default=10)
+    p.add_argument("--keepalive", type=float, default=5, help="WS_KEEPALIVE_INTERVAL_MS, in s")
+    p.add_argument("--broker-msg-rate", type=float, default=2000, help="messages/s")
+    p.add_argument("--broker-connect-rate", type=float, default=100, help="connects/s")
+    p.add_argument("--boot-spread", type=float, default=5)
+    p.add_argument("--config-s", type=float, default=1, help="registration and configuration time")
+    p.add_argument("--reboot-s", type=float, default=15, help="time to reboot after haltError()")
+    p.add_argument("--board", default="feather-esp32s3")
+    p.add_argument("--seed", type=int, default=1)
+    args = p.parse_args()
+
+    r = simulate(args)
+    rates = r["rates"]
+    lat_ms = [l * 1000 for l in r["latencies"]]
+    print("broker messages/s   p50 %d  p95 %d  p99 %d  max %d  mean %.1f" % (
+        percentile(rates, 50), percentile(rates, 95), percentile(rates, 99),
+        max(rates or [0]), statistics.mean(rates) if rates else 0))
+    print("connects/s          peak %d, %d s over broker capacity" % (
+        r["connect_peak"], r["connect_storm_s"]))
+    print("devices rebooted    %d" % r["failed"])
+    print("publish latency ms  p50 %.1f  p95 %.1f  p99 %.1f  max %.1f" % (
+        percentile(lat_ms, 50), percentile(lat_ms, 95), percentile(lat_ms, 99),
+        max(lat_ms or [0])))
+    if args.budget:
+        print("deferred readings   %d" % r["deferred"])
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,187 @@
+#!/usr/bin/env python3
+"""Decodes WipperSnapper's tokenized debug log back into text.
+
+Firmware built with WS_DEBUG_TOKENIZED writes WS_LOG() messages, and the
+per-module WS_LOG_ERROR()/WARN()/INFO()/DEBUG() messages, as binary
+records, interleaved with the plain text of WS_DEBUG_PRINT(). This tool
+passes the text through and replaces each record with its message. The
+token dictionary is built by scanning the firmware's source for
+WS_LOG() format strings, so it must match the firmware's version.
+
+Usage:
+  python3 ws_log_decode.py --port /dev/ttyACM0       (needs pyserial)
+  python3 ws_log_decode.py capture.bin
+  cat /dev/ttyACM0 | python3 ws_log_decode.py -
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+SYNC = 0x1E  # WS_LOG_SYNC
+HEADER = struct.Struct("<BIIB")  # sync, millis(), token, args length
+LITERAL = r'"(?:\\.|[^"\\])*"'
+# WS_LOG(fmt, ...), WS_LOG_<LEVEL>(module, fmt, ...) or ws_log_token(fmt)
+CALL = re.compile(
+    r"(?:WS_LOG(?:_(?:ERROR|WARN|INFO|DEBUG))?|ws_log_token)\("
+    r"\s*(?:\w+\s*,\s*)?((?:%s\s*)+)" % LITERAL)
+SPEC = re.compile(r"%([-+ #0]*\d*(?:\.\d+)?)(?:hh|h|ll|l)?([diuxXcfs%])")
+ESCAPES = {"n": "\n", "t": "\t", "r": "\r", '"': '"', "\\": "\\", "'": "'"}
+
+
+def unescape(literal):
+    """Returns the value of a C string literal, without its quotes."""
+    out, i = "", 1
+    while i < len(literal) - 1:
+        c = literal[i]
+        if c == "\\":
+            nxt = literal[i + 1]
+            if nxt == "x":
+                m = re.match(r"[0-9a-fA-F]+", literal[i + 2:])
+                out += chr(int(m.group(0), 16))
+                i += 2 + len(m.group(0))
+                continue
+            out += ESCAPES.get(nxt, nxt)
+            i += 2
+            continue
+        out += c
+        i += 1
+    return out
+
+
+def token(fmt):
+    """Mirrors ws_log_token(), FNV-1a over the format string's bytes."""
+    h = 2166136261
+    for b in fmt.encode("utf-8"):
+        h = ((h ^ b) * 16777619) & 0xFFFFFFFF
+    return h
+
+
+def load_dictionary(src):
+    """Maps each token to its format string, from the firmware's source."""
+    formats = {}
+    for root, _, files in os.walk(src):
+        for name in files:
+            if not name.endswith((".cpp", ".h", ".ino")):
+                continue
+            with open(os.path.join(root, name), encoding="utf-8",
+                      errors="replace") as f:
+                text = f.read()
+            for m in CALL.finditer(text):
+                literals = re.findall(LITERAL, m.group(1))
+                fmt = "".join(unescape(lit) for lit in literals)
+                formats[token(fmt)] = fmt
+    return formats
+
+
+def unpack_args(data):
+    """Returns the arguments of a record, from their type tags."""
+    args, i = [], 0
+    while i < len(data):
+        tag = chr(data[i])
+        if tag == "s":
+            n = data[i + 1]
+            args.append(data[i + 2:i + 2 + n].decode("utf-8", "replace"))
+            i += 2 + n
+        elif tag in "iuf":
+            fmt = {"i": "<i", "u": "<I", "f": "<f"}[tag]
+            args.append(struct.unpack_from(fmt, data, i + 1)[0])
+            i += 5
+        else:
+            break  # corrupt record
+    return args
+
+
+def format_message(fmt, args):
+    """Formats a message, as ws_log::print() would have printed it."""
+    args = list(args)
+
+    def convert(m):
+        flags, conv = m.group(1), m.group(2)
+        if conv == "%":
+            return "%"
+        if not args:
+            return "?"
+        arg = args.pop(0)
+        if conv == "s" or isinstance(arg, str):
+            return str(arg)
+        if conv in "xX":
+            return ("%" + flags + conv) % (int(arg) & 0xFFFFFFFF)
+        if conv == "f" or isinstance(arg, float):
+            # Print prints two decimals unless told otherwise
+            if "." not in flags:
+                flags += ".2"
+            return ("%" + flags + "f") % arg
+        if conv == "c":
+            return chr(int(arg))
+        return ("%" + flags + "d") % int(arg)
+
+    return SPEC.sub(convert, fmt)
+
+
+def decode(stream, formats, out, follow=False):
+    """Decodes a byte stream, writing text to out."""
+    read = getattr(stream, "read1", stream.read)
+    buf = b""
+    while True:
+        chunk = read(256)
+        if not chunk:
+            if follow:
+                continue  # serial read timed out
+            break
+        buf += chunk
+        while buf:
+            sync = buf.find(bytes([SYNC]))
+            if sync < 0:
+                out.write(buf.decode("utf-8", "replace"))
+                buf = b""
+                break
+            if sync > 0:
+                out.write(buf[:sync].decode("utf-8", "replace"))
+                buf = buf[sync:]
+            if len(buf) < HEADER.size:
+                break
+            _, ms, tok, n = HEADER.unpack_from(buf)
+            if len(buf) < HEADER.size + n:
+                break
+            args = unpack_args(buf[HEADER.size:HEADER.size + n])
+            buf = buf[HEADER.size + n:]
+            fmt = formats.get(tok)
+            if fmt is None:
+                msg = "<unknown token 0x%08x> %r" % (tok, args)
+            else:
+                msg = format_message(fmt, args)
+            out.write("[%10.3f] %s\n" % (ms / 1000.0, msg))
+        out.flush()
+
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    p = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    p.add_argument("input", nargs="?", default="-",
+                   help="capture file, or - for stdin")
+    p.add_argument("--port", help="serial port to read from")
+    p.add_argument("--baud", type=int, default=115200)
+    p.add_argument("--src", default=os.path.join(here, "..", "..", "src"),
+                   help="firmware source, for the token dictionary")
+    args = p.parse_args()
+
+    formats = load_dictionary(args.src)
+    if args.port:
+        import serial  # pyserial
+
+        stream = serial.Serial(args.port, args.baud, timeout=0.1)
+    elif args.input == "-":
+        stream = sys.stdin.buffer
+    else:
+        stream = open(args.input, "rb")
+    try:
+        decode(stream, formats, sys.stdout, follow=bool(args.port))
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
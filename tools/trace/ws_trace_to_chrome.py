@@ -0,0 +1,146 @@
+#!/usr/bin/env python3
+"""Converts WipperSnapper's execution trace into a Chrome trace.
+
+Firmware built with WS_TRACE writes a binary record for each timed span,
+interleaved with the rest of its serial output. This tool picks the
+records out of the stream and writes them as Chrome trace event JSON,
+which Perfetto (https://ui.perfetto.dev) and chrome://tracing open
+directly. Event names are read from the firmware's ws_loop_stages.h and
+ws_trace.h, so they must match the firmware's version.
+
+Usage:
+  python3 ws_trace_to_chrome.py --port /dev/ttyACM0 -o trace.json
+  python3 ws_trace_to_chrome.py capture.bin -o trace.json
+  cat capture.bin | python3 ws_trace_to_chrome.py - > trace.json
+
+When reading a serial port, stop the capture with Ctrl-C.
+"""
+
+import argparse
+import json
+import os
+import re
+import struct
+import sys
+
+SYNC = 0x1F  # WS_TRACE_SYNC
+DROPPED = 0xFF  # WS_TRACE_DROPPED
+RECORD = struct.Struct("<BBII")  # sync, event, start micros(), duration
+LOG_SYNC = 0x1E  # WS_LOG_SYNC, tokenized debug log records are skipped
+LOG_HEADER = struct.Struct("<BIIB")  # sync, millis(), token, args length
+
+def load_enum(src, header, prefix):
+    """Returns the names of an enum's values, in order."""
+    path = os.path.join(src, "components", "diagnostics", header)
+    enum = re.compile(r"^\s*%s(\w+)(?:\s*=[^,]*)?," % prefix, re.M)
+    with open(path, encoding="utf-8") as f:
+        names = enum.findall(f.read())
+    return [n.lower() for n in names if n != "COUNT"]
+
+
+def load_events(src):
+    """Returns the event names, the run() loop's ws_loop_stage_t stages
+    followed by the ws_trace_event_t events."""
+    return (load_enum(src, "ws_loop_stages.h", "WS_LOOP_STAGE_") +
+            load_enum(src, "ws_trace.h", "WS_TRACE_EVENT_"))
+
+
+def read_records(stream, count, follow=False):
+    """Yields (event, start, duration) for each record in a byte stream,
+    where count is the number of events the firmware traces."""
+    read = getattr(stream, "read1", stream.read)
+    buf = b""
+    while True:
+        try:
+            chunk = read(256)
+        except KeyboardInterrupt:
+            return
+        if not chunk:
+            if follow:
+                continue  # serial read timed out
+            return
+        buf += chunk
+        while buf:
+            # skip text, and debug log records which may hold a sync byte
+            i = 0
+            while i < len(buf) and buf[i] not in (SYNC, LOG_SYNC):
+                i += 1
+            buf = buf[i:]
+            if not buf:
+                break
+            if buf[0] == LOG_SYNC:
+                if len(buf) < LOG_HEADER.size:
+                    break
+                n = LOG_HEADER.unpack_from(buf)[3]
+                if len(buf) < LOG_HEADER.size + n:
+                    break
+                buf = buf[LOG_HEADER.size + n:]
+                continue
+            if len(buf) < RECORD.size:
+                break
+            _, event, start, duration = RECORD.unpack_from(buf)
+            if event >= count and event != DROPPED:
+                buf = buf[1:]  # a stray sync byte within text, resync
+                continue
+            buf = buf[RECORD.size:]
+            yield event, start, duration
+
+
+def to_chrome(records, events):
+    """Returns the Chrome trace events for the records, in microseconds."""
+    out = [{"ph": "M", "pid": 1, "tid": 1, "name": "thread_name",
+            "args": {"name": "run()"}}]
+    wraps, prv_end = 0, 0
+    for event, start, duration in records:
+        # micros() wraps every ~71 minutes, records arrive as spans end
+        end = (start + duration) & 0xFFFFFFFF
+        if end < prv_end and prv_end - end > 0x80000000:
+            wraps += 1
+        prv_end = end
+        ts = start + (wraps << 32)
+        if start > end:
+            ts -= 1 << 32  # the span began before the wrap
+        if event == DROPPED:
+            out.append({"ph": "i", "pid": 1, "tid": 1, "s": "t", "ts": ts,
+                        "name": "dropped", "args": {"records": duration}})
+        else:
+            out.append({"ph": "X", "pid": 1, "tid": 1, "ts": ts,
+                        "dur": duration, "name": events[event]})
+    return out
+
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    p = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    p.add_argument("input", nargs="?", default="-",
+                   help="capture file, or - for stdin")
+    p.add_argument("--port", help="serial port to read from")
+    p.add_argument("--baud", type=int, default=115200)
+    p.add_argument("-o", "--output", help="trace file, default stdout")
+    p.add_argument("--src", default=os.path.join(here, "..", "..", "src"),
+                   help="firmware source, for the event names")
+    args = p.parse_args()
+
+    events = load_events(args.src)
+    if args.port:
+        import serial  # pyserial
+
+        stream = serial.Serial(args.port, args.baud, timeout=0.1)
+    elif args.input == "-":
+        stream = sys.stdin.buffer
+    else:
+        stream = open(args.input, "rb")
+    records = read_records(stream, len(events), follow=bool(args.port))
+    trace = to_chrome(records, events)
+
+    out = open(args.output, "w") if args.output else sys.stdout
+    json.dump({"traceEvents": trace, "displayTimeUnit": "ms"}, out)
+    out.write("\n")
+    if args.output:
+        out.close()
+        sys.stderr.write("wrote %d events to %s\n" % (len(trace) - 1,
+                                                       args.output))
+
+
+if __name__ == "__main__":
+    main()